@@ -43,6 +43,17 @@ enum class XCWeightAlg {
   LKO    ///< The Lauqua-Kuessman-Ochsenfeld weighting scheme
 };
 
+/**
+ *  @brief Specification of the scheme used to accumulate task contributions
+ *  to VXC in the host integrators
+ */
+enum class VXCAccumulation {
+  Auto,          ///< ThreadPrivate if within the memory cap, TileLocked otherwise
+  Critical,      ///< Serialize every task increment in a critical section
+  ThreadPrivate, ///< Per-thread copies of VXC with a parallel reduction at the end
+  TileLocked     ///< Shared VXC with one lock per column tile
+};
+
 /**
  *  @brief Specification of the execution space for various operations
  */
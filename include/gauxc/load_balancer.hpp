@@ -15,6 +15,7 @@
 #include <gauxc/xc_task.hpp>
 #include <gauxc/util/timer.hpp>
 #include <gauxc/runtime_environment.hpp>
+#include <gauxc/enums.hpp>
 
 namespace GauXC {
 
@@ -27,6 +28,30 @@ namespace detail {
 struct LoadBalancerState {
   bool modified_weights_are_stored = false; 
     ///< Whether the load balancer currently sotred partitioned weights
+  Molecule weights_geometry;
+    ///< Geometry at which the stored partition weights were last updated
+    ///< (only tracked for incremental weight updates)
+  size_t task_generation = 0;
+    ///< Incremented whenever the local tasks are created or modified
+    ///< (rebalance, compaction, geometry updates)
+  XCWeightAlg weight_alg = XCWeightAlg::SSF;
+    ///< Partitioning scheme of the stored modified weights
+};
+
+/// Settings for LoadBalancer instances
+struct LoadBalancerSettings {
+  bool fuse_partition_weights = false;
+    ///< Apply partition weights while generating the local tasks (Host).
+    ///< Replicated: every rank generates every batch, but only evaluates
+    ///< the weights of the batches assigned to it. Tasks with negligible
+    ///< weights are then dropped after the assignment (the rank workloads
+    ///< still account for them)
+  XCWeightAlg weight_alg = XCWeightAlg::SSF;
+    ///< Weight partitioning scheme (fused weights only)
+  double weight_screen_tol = 0.;
+    ///< Drop tasks with all |w| <= weight_screen_tol (fused weights only)
+  std::string weights_kernel_name = "Default";
+    ///< LocalWorkDriver kernel used to evaluate the fused weights
 };
 
 
@@ -73,6 +98,33 @@ public:
 
   /// Rebalance quadrature batches according to exx cost 
   void rebalance_exx();
+
+  /**
+   *  @brief Move the local quadrature tasks to a displaced geometry
+   *
+   *  Quadrature points (and basis shells) are translated along with the
+   *  atom they are centered on, and the basis function screening of the
+   *  local tasks is regenerated. Stored partition weights are left as-is
+   *  and must be updated through MolecularWeights::update_weights, which
+   *  requires the tasks to keep their unpartitioned weights.
+   *
+   *  @param[in] mol Displaced molecule (same atoms, same ordering)
+   */
+  void update_geometry( const Molecule& mol );
+
+  /**
+   *  @brief Remove quadrature points with negligible weights from the local tasks
+   *
+   *  Requires the partition weights to have been applied (throws
+   *  otherwise). Remaining points keep their ordering, tasks are re-padded to pad_value()
+   *  and tasks without remaining points are removed. Removed points are
+   *  dropped from the unpartitioned weights as well, i.e. they are not
+   *  recovered by incremental weight updates.
+   *
+   *  @param[in] weight_tol Points with |w| <= weight_tol are removed
+   *  @returns The number of local quadrature points which have been removed
+   */
+  size_t compact_tasks( double weight_tol = 1e-15 );
   
   /// Return internal timing tracker
   const util::Timer& get_timings() const;
@@ -147,8 +199,11 @@ public:
    *    Currently accepted values for Device execution space:
    *      - "DEFAULT": Read as "REPLICATED"
    *      - "REPLICATAED": Same as Host::REPLICATED-PETITE
+   *
+   * @param[in] s Settings for the generated LoadBalancer instances
    */
-  LoadBalancerFactory( ExecutionSpace ex, std::string kernel_name );
+  LoadBalancerFactory( ExecutionSpace ex, std::string kernel_name,
+    LoadBalancerSettings s = LoadBalancerSettings() );
 
   /** 
    *  @brief Generate a LoadBalancer instance per kernel and execution space
@@ -190,6 +245,7 @@ private:
 
   ExecutionSpace ex_; ///< Execution space for the generated LoadBalancer instances
   std::string    kernel_name_; ///< Kernel name of the generated Load Balancer instances 
+  LoadBalancerSettings settings_; ///< Settings of the generated LoadBalancer instances
 
 }; // LoadBalancerFactory
 
@@ -20,6 +20,8 @@ namespace detail {
 struct MolecularWeightsSettings { 
     XCWeightAlg weight_alg = XCWeightAlg::SSF; ///< Weight partitioning scheme
     bool becke_size_adjustment = false; ///< Whether to use Becke size adjustments
+    bool incremental = false; ///< Keep unpartitioned weights to enable update_weights
+    double displacement_tol = 1e-8; ///< Atoms displaced by less are treated as fixed (bohr)
 };
 
 
@@ -58,6 +60,17 @@ public:
   /// Apply weight partitioning scheme to pre-generated local quadrature tasks
   void modify_weights(load_balancer_reference lb) const;
 
+  /**
+   *  @brief Update the partition weights after LoadBalancer::update_geometry
+   *
+   *  Requires MolecularWeightsSettings::incremental. Only tasks for which an
+   *  atom displaced beyond MolecularWeightsSettings::displacement_tol may
+   *  contribute to the partition function (SSF) are recomputed from their
+   *  unpartitioned weights. Falls back to modify_weights if no partitioned
+   *  weights are stored.
+   */
+  void update_weights(load_balancer_reference lb) const;
+
   /// Return local timing tracker
   const util::Timer& get_timings() const;
 
@@ -19,10 +19,9 @@ namespace GauXC {
 namespace detail {
 template <typename InputIt, typename OutputIt, typename T>
 OutputIt exclusive_scan(InputIt begin, InputIt end, OutputIt d_first, T init) {
-  *(d_first++) = init;
   T sum = init;
   for(auto it = begin; it != end; ++it) {
-    *(d_first++) = *it + sum;
+    *(d_first++) = sum;
     sum += *it;
   }
   return d_first;
@@ -126,6 +125,7 @@ public:
 
   auto* buffer() { return buffer_.data(); }
   size_t size()  { return buffer_.size(); }
+  int position() const { return internal_position_; }
 
   template <typename T>
   void pack( const T* ptr, size_t n ) {
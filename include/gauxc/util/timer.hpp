@@ -41,6 +41,7 @@ class Timer {
   using duration = std::chrono::duration<Rep,Period>;
 
   std::map< std::string, duration<double, std::milli>> timings_;
+  std::map< std::string, double >                      counters_;
 
 public:
 
@@ -159,6 +160,24 @@ public:
 
   inline const auto& all_timings() const { return timings_; }
 
+
+
+  // Non-timing instrumentation (e.g. screened point counts)
+
+  inline void add_counter( std::string name, double val ) {
+    counters_.insert_or_assign( name, val );
+  }
+
+  inline void add_or_accumulate_counter( std::string name, double val ) {
+    counters_[name] += val;
+  }
+
+  inline double get_counter( std::string name ) const {
+    return counters_.at(name);
+  }
+
+  inline const auto& all_counters() const { return counters_; }
+
 };
 
 
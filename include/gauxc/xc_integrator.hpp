@@ -32,6 +32,10 @@ public:
   using basisset_type = BasisSet< value_type >;
 
   using exc_vxc_type  = std::tuple< value_type, matrix_type >;
+  using exc_vxc_type_uks = std::tuple< value_type, matrix_type, matrix_type >;
+  using exc_vxc_batch_type = std::vector< exc_vxc_type >;
+  using den_batch_type     = std::vector< value_type >;
+  using fxc_contraction_type = std::vector< matrix_type >;
   using exc_grad_type = std::vector< value_type >;
   using exx_type      = matrix_type;
 
@@ -52,8 +56,19 @@ public:
   XCIntegrator( XCIntegrator&& ) noexcept;
 
   value_type    integrate_den( const MatrixType& );
-  exc_vxc_type  eval_exc_vxc ( const MatrixType& );
-  exc_grad_type eval_exc_grad( const MatrixType& );
+  exc_vxc_type  eval_exc_vxc ( const MatrixType&,
+                               const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+  exc_vxc_type_uks eval_exc_vxc ( const MatrixType&, const MatrixType&,
+                                  const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+  exc_grad_type eval_exc_grad( const MatrixType&,
+                               const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+
+  den_batch_type     integrate_den_batched( const std::vector<MatrixType>& );
+  exc_vxc_batch_type eval_exc_vxc_batched ( const std::vector<MatrixType>&,
+                                            const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+  fxc_contraction_type eval_fxc_contraction( const MatrixType&, 
+                                             const std::vector<MatrixType>&,
+                                             const IntegratorSettingsXC& = IntegratorSettingsXC{} );
   exx_type      eval_exx     ( const MatrixType&, 
                                const IntegratorSettingsEXX& = IntegratorSettingsEXX{} );
 
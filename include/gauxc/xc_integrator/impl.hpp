@@ -33,16 +33,51 @@ typename XCIntegrator<MatrixType>::value_type
 
 template <typename MatrixType>
 typename XCIntegrator<MatrixType>::exc_vxc_type
-  XCIntegrator<MatrixType>::eval_exc_vxc( const MatrixType& P ) {
+  XCIntegrator<MatrixType>::eval_exc_vxc( const MatrixType& P,
+                                          const IntegratorSettingsXC& settings ) {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
-  return pimpl_->eval_exc_vxc(P);
+  return pimpl_->eval_exc_vxc(P,settings);
+};
+
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::exc_vxc_type_uks
+  XCIntegrator<MatrixType>::eval_exc_vxc( const MatrixType& Pa, 
+                                          const MatrixType& Pb,
+                                          const IntegratorSettingsXC& settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_exc_vxc(Pa,Pb,settings);
 };
 
 template <typename MatrixType>
 typename XCIntegrator<MatrixType>::exc_grad_type
-  XCIntegrator<MatrixType>::eval_exc_grad( const MatrixType& P ) {
+  XCIntegrator<MatrixType>::eval_exc_grad( const MatrixType& P, 
+    const IntegratorSettingsXC& settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_exc_grad(P, settings);
+};
+
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::den_batch_type
+  XCIntegrator<MatrixType>::integrate_den_batched( const std::vector<MatrixType>& P ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->integrate_den_batched(P);
+};
+
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::exc_vxc_batch_type
+  XCIntegrator<MatrixType>::eval_exc_vxc_batched( const std::vector<MatrixType>& P,
+                                                  const IntegratorSettingsXC& settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_exc_vxc_batched(P,settings);
+};
+
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::fxc_contraction_type
+  XCIntegrator<MatrixType>::eval_fxc_contraction( const MatrixType& P0,
+                                                  const std::vector<MatrixType>& dP,
+                                                  const IntegratorSettingsXC& settings ) {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
-  return pimpl_->eval_exc_grad(P);
+  return pimpl_->eval_fxc_contraction(P0,dP,settings);
 };
 
 template <typename MatrixType>
@@ -17,8 +17,16 @@ struct LocalWorkDriver {
   virtual ~LocalWorkDriver() noexcept = default; 
 };
 
-/// Base type for all types that specify LWD settings (trivial)
-struct LocalWorkSettings { virtual ~LocalWorkSettings() noexcept = default; };
+/// Base type for all types that specify LWD settings
+struct LocalWorkSettings { 
+  virtual ~LocalWorkSettings() noexcept = default; 
+
+  /// Host only: run the X / Z GEMMs of EXC / VXC evaluations on single
+  /// precision copies of the collocation, densities and functional stay in
+  /// double precision. Gradients, FXC and density integration always run
+  /// in double precision
+  bool mixed_precision = false;
+};
 
 
 
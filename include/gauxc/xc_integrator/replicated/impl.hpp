@@ -63,33 +63,137 @@ typename ReplicatedXCIntegrator<MatrixType>::value_type
 
 template <typename MatrixType>
 typename ReplicatedXCIntegrator<MatrixType>::exc_vxc_type 
-  ReplicatedXCIntegrator<MatrixType>::eval_exc_vxc_( const MatrixType& P ) {
+  ReplicatedXCIntegrator<MatrixType>::eval_exc_vxc_( const MatrixType& P, const IntegratorSettingsXC& settings ) {
 
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
   matrix_type VXC( P.rows(), P.cols() );
   value_type  EXC;
 
   pimpl_->eval_exc_vxc( P.rows(), P.cols(), P.data(), P.rows(),
-                        VXC.data(), VXC.rows(), &EXC );
+                        VXC.data(), VXC.rows(), &EXC, settings );
 
   return std::make_tuple( EXC, VXC );
 
 }
 
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::exc_vxc_type_uks 
+  ReplicatedXCIntegrator<MatrixType>::eval_exc_vxc_( const MatrixType& Pa, 
+    const MatrixType& Pb, const IntegratorSettingsXC& settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  matrix_type VXCa( Pa.rows(), Pa.cols() );
+  matrix_type VXCb( Pb.rows(), Pb.cols() );
+  value_type  EXC;
+
+  pimpl_->eval_exc_vxc( Pa.rows(), Pa.cols(), Pa.data(), Pa.rows(),
+                        Pb.data(), Pb.rows(), VXCa.data(), VXCa.rows(),
+                        VXCb.data(), VXCb.rows(), &EXC, settings );
+
+  return std::make_tuple( EXC, VXCa, VXCb );
+
+}
+
 template <typename MatrixType>
 typename ReplicatedXCIntegrator<MatrixType>::exc_grad_type 
-  ReplicatedXCIntegrator<MatrixType>::eval_exc_grad_( const MatrixType& P ) {
+  ReplicatedXCIntegrator<MatrixType>::eval_exc_grad_( const MatrixType& P, 
+    const IntegratorSettingsXC& settings ) {
 
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
 
   std::vector<value_type> EXC_GRAD( 3*pimpl_->load_balancer().molecule().natoms() );
   pimpl_->eval_exc_grad( P.rows(), P.cols(), P.data(), P.rows(),
-                         EXC_GRAD.data() );
+                         EXC_GRAD.data(), settings );
 
   return EXC_GRAD;
 
 }
 
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::den_batch_type 
+  ReplicatedXCIntegrator<MatrixType>::integrate_den_batched_( 
+    const std::vector<MatrixType>& P ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const int64_t ndm = P.size();
+  den_batch_type N_EL( ndm );
+  if( not ndm ) return N_EL;
+
+  std::vector<const value_type*> P_ptr( ndm );
+  for( int64_t k = 0; k < ndm; ++k ) {
+    if( P[k].rows() != P[0].rows() or P[k].cols() != P[0].cols() )
+      GAUXC_GENERIC_EXCEPTION("Batched Densities Must Have the Same Dimensions");
+    P_ptr[k] = P[k].data();
+  }
+
+  pimpl_->integrate_den_batched( ndm, P[0].rows(), P[0].cols(), P_ptr.data(),
+                                 P[0].rows(), N_EL.data() );
+
+  return N_EL;
+}
+
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::exc_vxc_batch_type 
+  ReplicatedXCIntegrator<MatrixType>::eval_exc_vxc_batched_( 
+    const std::vector<MatrixType>& P, const IntegratorSettingsXC& settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const int64_t ndm = P.size();
+  if( not ndm ) return exc_vxc_batch_type{};
+
+  std::vector<matrix_type> VXC( ndm );
+  std::vector<value_type>  EXC( ndm );
+  std::vector<const value_type*> P_ptr( ndm );
+  std::vector<value_type*>       VXC_ptr( ndm );
+  for( int64_t k = 0; k < ndm; ++k ) {
+    if( P[k].rows() != P[0].rows() or P[k].cols() != P[0].cols() )
+      GAUXC_GENERIC_EXCEPTION("Batched Densities Must Have the Same Dimensions");
+    VXC[k]     = matrix_type( P[k].rows(), P[k].cols() );
+    P_ptr[k]   = P[k].data();
+    VXC_ptr[k] = VXC[k].data();
+  }
+
+  pimpl_->eval_exc_vxc_batched( ndm, P[0].rows(), P[0].cols(), P_ptr.data(),
+                                P[0].rows(), VXC_ptr.data(), P[0].rows(), 
+                                EXC.data(), settings );
+
+  exc_vxc_batch_type EXC_VXC;
+  EXC_VXC.reserve( ndm );
+  for( int64_t k = 0; k < ndm; ++k )
+    EXC_VXC.emplace_back( EXC[k], std::move(VXC[k]) );
+
+  return EXC_VXC;
+
+}
+
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::fxc_contraction_type 
+  ReplicatedXCIntegrator<MatrixType>::eval_fxc_contraction_( const MatrixType& P0,
+    const std::vector<MatrixType>& dP, const IntegratorSettingsXC& settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const int64_t ndm = dP.size();
+  if( not ndm ) return fxc_contraction_type{};
+
+  fxc_contraction_type FXC( ndm );
+  std::vector<const value_type*> dP_ptr( ndm );
+  std::vector<value_type*>       FXC_ptr( ndm );
+  for( int64_t k = 0; k < ndm; ++k ) {
+    if( dP[k].rows() != P0.rows() or dP[k].cols() != P0.cols() )
+      GAUXC_GENERIC_EXCEPTION("Trial Densities Must Have the Same Dimensions as P0");
+    FXC[k]     = matrix_type( P0.rows(), P0.cols() );
+    dP_ptr[k]  = dP[k].data();
+    FXC_ptr[k] = FXC[k].data();
+  }
+
+  pimpl_->eval_fxc_contraction( ndm, P0.rows(), P0.cols(), P0.data(), P0.rows(),
+                                dP_ptr.data(), P0.rows(), FXC_ptr.data(), 
+                                P0.rows(), settings );
+
+  return FXC;
+
+}
+
 template <typename MatrixType>
 typename ReplicatedXCIntegrator<MatrixType>::exx_type 
   ReplicatedXCIntegrator<MatrixType>::eval_exx_( const MatrixType& P, const IntegratorSettingsEXX& settings ) {
@@ -40,9 +40,32 @@ protected:
                                int64_t ldp, value_type* N_EL ) = 0;
   virtual void eval_exc_vxc_( int64_t m, int64_t n, const value_type* P,
                               int64_t ldp, value_type* VXC, int64_t ldvxc,
-                              value_type* EXC ) = 0;
+                              value_type* EXC, const IntegratorSettingsXC& settings ) = 0;
+  virtual void eval_exc_vxc_( int64_t m, int64_t n, const value_type* Pa,
+                              int64_t ldpa, const value_type* Pb, int64_t ldpb,
+                              value_type* VXCa, int64_t ldvxca, value_type* VXCb,
+                              int64_t ldvxcb, value_type* EXC, 
+                              const IntegratorSettingsXC& settings ) = 0;
   virtual void eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
-                               int64_t ldp, value_type* EXC_GRAD ) = 0;
+                               int64_t ldp, value_type* EXC_GRAD, 
+                               const IntegratorSettingsXC& settings ) = 0;
+
+  // Batched densities, defaults to a sequence of unbatched calls
+  virtual void integrate_den_batched_( int64_t ndm, int64_t m, int64_t n, 
+                                       const value_type* const* P, int64_t ldp, 
+                                       value_type* N_EL );
+  virtual void eval_exc_vxc_batched_( int64_t ndm, int64_t m, int64_t n, 
+                                      const value_type* const* P, int64_t ldp, 
+                                      value_type* const* VXC, int64_t ldvxc,
+                                      value_type* EXC, 
+                                      const IntegratorSettingsXC& settings );
+
+  // XC kernel contraction, defaults to NYI
+  virtual void eval_fxc_contraction_( int64_t ndm, int64_t m, int64_t n, 
+                                      const value_type* P0, int64_t ldp0,
+                                      const value_type* const* dP, int64_t lddp,
+                                      value_type* const* FXC, int64_t ldfxc,
+                                      const IntegratorSettingsXC& settings );
   virtual void eval_exx_( int64_t m, int64_t n, const value_type* P,
                           int64_t ldp, value_type* K, int64_t ldk,
                           const IntegratorSettingsEXX& settings ) = 0;
@@ -62,15 +85,37 @@ public:
 
   void eval_exc_vxc( int64_t m, int64_t n, const value_type* P,
                      int64_t ldp, value_type* VXC, int64_t ldvxc,
-                     value_type* EXC ); 
+                     value_type* EXC, const IntegratorSettingsXC& settings );
+
+  void eval_exc_vxc( int64_t m, int64_t n, const value_type* Pa,
+                     int64_t ldpa, const value_type* Pb, int64_t ldpb,
+                     value_type* VXCa, int64_t ldvxca, value_type* VXCb,
+                     int64_t ldvxcb, value_type* EXC, 
+                     const IntegratorSettingsXC& settings );
 
   void eval_exc_grad( int64_t m, int64_t n, const value_type* P,
-                      int64_t ldp, value_type* EXC_GRAD );
+                      int64_t ldp, value_type* EXC_GRAD, 
+                      const IntegratorSettingsXC& settings );
 
   void eval_exx( int64_t m, int64_t n, const value_type* P,
                  int64_t ldp, value_type* K, int64_t ldk,
                  const IntegratorSettingsEXX& settings );
 
+  void integrate_den_batched( int64_t ndm, int64_t m, int64_t n, 
+                              const value_type* const* P, int64_t ldp, 
+                              value_type* N_EL );
+
+  void eval_exc_vxc_batched( int64_t ndm, int64_t m, int64_t n, 
+                             const value_type* const* P, int64_t ldp, 
+                             value_type* const* VXC, int64_t ldvxc,
+                             value_type* EXC, const IntegratorSettingsXC& settings );
+
+  void eval_fxc_contraction( int64_t ndm, int64_t m, int64_t n, 
+                             const value_type* P0, int64_t ldp0,
+                             const value_type* const* dP, int64_t lddp,
+                             value_type* const* FXC, int64_t ldfxc,
+                             const IntegratorSettingsXC& settings );
+
   inline const util::Timer& get_timings() const { return timer_; }
 
   inline std::unique_ptr< LocalWorkDriver > release_local_work_driver() {
@@ -29,6 +29,10 @@ public:
   using matrix_type    = typename XCIntegratorImpl<MatrixType>::matrix_type;
   using value_type     = typename XCIntegratorImpl<MatrixType>::value_type;
   using exc_vxc_type   = typename XCIntegratorImpl<MatrixType>::exc_vxc_type;
+  using exc_vxc_type_uks = typename XCIntegratorImpl<MatrixType>::exc_vxc_type_uks;
+  using exc_vxc_batch_type = typename XCIntegratorImpl<MatrixType>::exc_vxc_batch_type;
+  using den_batch_type     = typename XCIntegratorImpl<MatrixType>::den_batch_type;
+  using fxc_contraction_type = typename XCIntegratorImpl<MatrixType>::fxc_contraction_type;
   using exc_grad_type  = typename XCIntegratorImpl<MatrixType>::exc_grad_type;
   using exx_type       = typename XCIntegratorImpl<MatrixType>::exx_type;
 
@@ -38,8 +42,16 @@ private:
   std::unique_ptr< pimpl_type > pimpl_;
 
   value_type    integrate_den_( const MatrixType& ) override;
-  exc_vxc_type  eval_exc_vxc_ ( const MatrixType& ) override;
-  exc_grad_type eval_exc_grad_( const MatrixType& ) override;
+  exc_vxc_type  eval_exc_vxc_ ( const MatrixType&, const IntegratorSettingsXC& ) override;
+  exc_vxc_type_uks eval_exc_vxc_ ( const MatrixType&, const MatrixType&, 
+                                   const IntegratorSettingsXC& ) override;
+  exc_grad_type eval_exc_grad_( const MatrixType&, const IntegratorSettingsXC& ) override;
+  den_batch_type     integrate_den_batched_( const std::vector<MatrixType>& ) override;
+  exc_vxc_batch_type eval_exc_vxc_batched_ ( const std::vector<MatrixType>&, 
+                                             const IntegratorSettingsXC& ) override;
+  fxc_contraction_type eval_fxc_contraction_( const MatrixType&, 
+                                              const std::vector<MatrixType>&,
+                                              const IntegratorSettingsXC& ) override;
   exx_type      eval_exx_     ( const MatrixType&, const IntegratorSettingsEXX& ) override;
   const util::Timer& get_timings_() const override;
   const LoadBalancer& get_load_balancer_() const override;
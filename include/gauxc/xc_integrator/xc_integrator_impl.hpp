@@ -21,14 +21,29 @@ public:
   using matrix_type    = MatrixType;
   using value_type     = typename matrix_type::value_type;
   using exc_vxc_type   = typename XCIntegrator<MatrixType>::exc_vxc_type;
+  using exc_vxc_type_uks = typename XCIntegrator<MatrixType>::exc_vxc_type_uks;
+  using exc_vxc_batch_type = typename XCIntegrator<MatrixType>::exc_vxc_batch_type;
+  using den_batch_type     = typename XCIntegrator<MatrixType>::den_batch_type;
+  using fxc_contraction_type = typename XCIntegrator<MatrixType>::fxc_contraction_type;
   using exc_grad_type  = typename XCIntegrator<MatrixType>::exc_grad_type;
   using exx_type       = typename XCIntegrator<MatrixType>::exx_type;
 
 protected:
 
   virtual value_type    integrate_den_( const MatrixType& P ) = 0;
-  virtual exc_vxc_type  eval_exc_vxc_ ( const MatrixType& P ) = 0;
-  virtual exc_grad_type eval_exc_grad_( const MatrixType& P ) = 0;
+  virtual exc_vxc_type  eval_exc_vxc_ ( const MatrixType& P,
+                                        const IntegratorSettingsXC& settings ) = 0;
+  virtual exc_vxc_type_uks eval_exc_vxc_( const MatrixType& Pa, 
+                                          const MatrixType& Pb,
+                                          const IntegratorSettingsXC& settings ) = 0;
+  virtual exc_grad_type eval_exc_grad_( const MatrixType& P,
+                                        const IntegratorSettingsXC& settings ) = 0;
+  virtual den_batch_type     integrate_den_batched_( const std::vector<MatrixType>& P ) = 0;
+  virtual exc_vxc_batch_type eval_exc_vxc_batched_ ( const std::vector<MatrixType>& P,
+                                                     const IntegratorSettingsXC& settings ) = 0;
+  virtual fxc_contraction_type eval_fxc_contraction_( const MatrixType& P0,
+                                                      const std::vector<MatrixType>& dP,
+                                                      const IntegratorSettingsXC& settings ) = 0;
   virtual exx_type      eval_exx_     ( const MatrixType&     P, 
                                         const IntegratorSettingsEXX& settings ) = 0;
   virtual const util::Timer& get_timings_() const = 0;
@@ -55,24 +70,77 @@ public:
 
   /** Integrate EXC / VXC (Mean field terms) for RKS
    * 
-   *   TODO: add API for UKS/GKS
+   *   TODO: add API for GKS
    *
-   *  @param[in] P The alpha density matrix
+   *  @param[in] P        The alpha density matrix
+   *  @param[in] settings Integration settings (e.g. VXC accumulation scheme)
    *  @returns EXC / VXC in a combined structure
    */
-  exc_vxc_type eval_exc_vxc( const MatrixType& P ) {
-    return eval_exc_vxc_(P);
+  exc_vxc_type eval_exc_vxc( const MatrixType& P, const IntegratorSettingsXC& settings ) {
+    return eval_exc_vxc_(P,settings);
+  }
+
+  /** Integrate EXC / VXC (Mean field terms) for UKS
+   *
+   *  @param[in] Pa       The alpha density matrix
+   *  @param[in] Pb       The beta density matrix
+   *  @param[in] settings Integration settings (e.g. VXC accumulation scheme)
+   *  @returns EXC / VXCa / VXCb in a combined structure
+   */
+  exc_vxc_type_uks eval_exc_vxc( const MatrixType& Pa, const MatrixType& Pb,
+                                 const IntegratorSettingsXC& settings ) {
+    return eval_exc_vxc_(Pa,Pb,settings);
   }
 
   /** Integrate EXC gradient for RKS
    * 
    *   TODO: add API for UKS/GKS
    *
-   *  @param[in] P The alpha density matrix
+   *  @param[in] P        The alpha density matrix
+   *  @param[in] settings Integration settings, partition weight derivatives
+   *                      are included via IntegratorSettingsEXCGrad
    *  @returns EXC gradient
    */
-  exc_grad_type eval_exc_grad( const MatrixType& P ) {
-    return eval_exc_grad_(P);
+  exc_grad_type eval_exc_grad( const MatrixType& P, 
+                               const IntegratorSettingsXC& settings ) {
+    return eval_exc_grad_(P, settings);
+  }
+
+  /** Integrate Density (approx N_EL) for a batch of densities
+   *
+   *  @param[in] P The density matrices
+   *  @returns Approx Tr[P*S] for each density
+   */
+  den_batch_type integrate_den_batched( const std::vector<MatrixType>& P ) {
+    return integrate_den_batched_(P);
+  }
+
+  /** Integrate EXC / VXC (Mean field terms) for RKS for a batch of densities
+   *  on the same grid and basis
+   *
+   *  @param[in] P        The alpha density matrices
+   *  @param[in] settings Integration settings (e.g. VXC accumulation scheme)
+   *  @returns EXC / VXC for each density
+   */
+  exc_vxc_batch_type eval_exc_vxc_batched( const std::vector<MatrixType>& P, 
+                                           const IntegratorSettingsXC& settings ) {
+    return eval_exc_vxc_batched_(P,settings);
+  }
+
+  /** Contract the XC kernel (fxc) with a set of trial densities for RKS
+   *
+   *  FXC_k = \int d^2 Exc / d P d P [P0] * dP_k, i.e. the XC contribution
+   *  to the linear response of the KS matrix
+   *
+   *  @param[in] P0       The ground state alpha density matrix
+   *  @param[in] dP       The (symmetric) alpha trial density matrices
+   *  @param[in] settings Integration settings (e.g. VXC accumulation scheme)
+   *  @returns FXC contraction for each trial density
+   */
+  fxc_contraction_type eval_fxc_contraction( const MatrixType& P0,
+                                             const std::vector<MatrixType>& dP,
+                                             const IntegratorSettingsXC& settings ) {
+    return eval_fxc_contraction_(P0,dP,settings);
   }
 
   /** Integrate Exact Exchange for RHF
@@ -6,9 +6,32 @@
  * See LICENSE.txt for details
  */
 #pragma once
+#include <cstddef>
+#include <cstdint>
 
 namespace GauXC {
 
+struct IntegratorSettingsXC { virtual ~IntegratorSettingsXC() noexcept = default; };
+struct IntegratorSettingsKS : public IntegratorSettingsXC {
+  VXCAccumulation vxc_accumulation      = VXCAccumulation::Auto;
+  size_t          vxc_private_max_bytes = 1ul << 30; ///< Cap on the total size of thread-private VXC copies
+  int32_t         vxc_lock_tile_size    = 128;       ///< Column tile width for TileLocked accumulation
+
+  bool   screen_points        = false; ///< Drop negligible points before functional evaluation (host RKS/UKS eval_exc_vxc only, rejected by the batched and fxc paths)
+  double den_screening_tol    = 1e-14; ///< Points with rho <= den_screening_tol are dropped
+  double weight_screening_tol = 1e-15; ///< Points with |w| <= weight_screening_tol are dropped
+
+  size_t collocation_cache_bytes            = 0;     ///< Budget of the persistent collocation cache (0 disables)
+  bool   collocation_cache_single_precision = false; ///< Store cached collocation in single precision
+
+  bool    disable_mixed_precision       = false; ///< Run EXC/VXC in double precision even if the LWD enables mixed precision (e.g. near SCF convergence)
+  int32_t mixed_precision_sample_stride = 0;     ///< Every n-th task is re-evaluated in mixed and double precision to estimate the EXC/N_EL deviation, adding ~2/n of the EXC/VXC cost to every call (0 disables)
+};
+
+struct IntegratorSettingsEXCGrad : public IntegratorSettingsXC {
+  bool weight_derivatives = false; ///< Include partition weight derivatives (grid points move with their parent atom), differentiates the partitioning scheme recorded in LoadBalancerState
+};
+
 struct IntegratorSettingsEXX { virtual ~IntegratorSettingsEXX() noexcept = default; };
 struct IntegratorSettingsSNLinK : public IntegratorSettingsEXX {
   bool screen_ek = true;
@@ -21,13 +21,23 @@ namespace GauXC {
 struct XCTask {
 
   int32_t                              iParent = -1;
+  int64_t                              task_id = -1; ///< Index in the local tasks of the owning LoadBalancer as of the last task modification (not serialized)
   std::vector< std::array<double,3> >  points;
   std::vector< double  >               weights;
+  std::vector< double  >               unpartitioned_weights; ///< Raw quadrature weights (incremental weight updates)
   int32_t                              npts = 0;
 
   double                               dist_nearest;
   double                               max_weight = std::numeric_limits<double>::infinity();
 
+  /// Measured wall time (s) of the last evaluation of the task per kernel,
+  /// 0 if not measured
+  struct cost_data {
+    double exc_vxc = 0.;
+    double exx     = 0.;
+  };
+  cost_data                            measured_cost;
+
   struct screening_data {
     using pair_t = std::pair<int32_t,int32_t>;
     std::vector<int32_t>               shell_list;
@@ -62,6 +72,10 @@ struct XCTask {
       GAUXC_GENERIC_EXCEPTION("Cannot Perform Requested Merge: Incompatible Tasks");
     points.insert( points.end(), other.points.begin(), other.points.end() );
     weights.insert( weights.end(), other.weights.begin(), other.weights.end() );
+    unpartitioned_weights.insert( unpartitioned_weights.end(),
+      other.unpartitioned_weights.begin(), other.unpartitioned_weights.end() );
+    measured_cost.exc_vxc += other.measured_cost.exc_vxc;
+    measured_cost.exx     += other.measured_cost.exx;
     npts = points.size();
   }
 
@@ -85,6 +99,10 @@ struct XCTask {
         GAUXC_GENERIC_EXCEPTION("Cannot Perform Requested Task Merge");
       points_it  = std::copy( it->points.begin(), it->points.end(), points_it );
       weights_it = std::copy( it->weights.begin(), it->weights.end(), weights_it );
+      unpartitioned_weights.insert( unpartitioned_weights.end(),
+        it->unpartitioned_weights.begin(), it->unpartitioned_weights.end() );
+      measured_cost.exc_vxc += it->measured_cost.exc_vxc;
+      measured_cost.exx     += it->measured_cost.exx;
     }
 
     npts = points.size();
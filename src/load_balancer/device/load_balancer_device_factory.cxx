@@ -21,7 +21,7 @@ namespace GauXC {
 std::shared_ptr<LoadBalancer> LoadBalancerDeviceFactory::get_shared_instance(
   std::string kernel_name, const RuntimeEnvironment& rt,
   const Molecule& mol, const MolGrid& mg, const BasisSet<double>& basis,
-  size_t pv
+  size_t pv, const LoadBalancerSettings& settings
 ) {
 
   std::transform(kernel_name.begin(), kernel_name.end(), 
@@ -30,11 +30,14 @@ std::shared_ptr<LoadBalancer> LoadBalancerDeviceFactory::get_shared_instance(
 
   if( kernel_name == "DEFAULT" ) kernel_name = "REPLICATED";
 
+  if( settings.fuse_partition_weights )
+    GAUXC_GENERIC_EXCEPTION("Fused Partition Weights NYI for Device LoadBalancer");
+
   std::unique_ptr<detail::LoadBalancerImpl> ptr = nullptr;
   #ifdef GAUXC_ENABLE_DEVICE
   if( kernel_name == "REPLICATED" ) {
     ptr = std::make_unique<detail::DeviceReplicatedLoadBalancer>(
-      rt, mol, mg, basis, pv
+      rt, mol, mg, basis, pv, settings
     );
   }
   #endif
@@ -14,7 +14,7 @@ struct LoadBalancerDeviceFactory {
   static std::shared_ptr<LoadBalancer> get_shared_instance(
     std::string kernel_name, const RuntimeEnvironment& rt, 
     const Molecule& mol, const MolGrid& mg, const BasisSet<double>& basis,
-    size_t pv
+    size_t pv, const LoadBalancerSettings& settings
   );
 
 };
@@ -25,27 +25,19 @@ std::unique_ptr<LoadBalancerImpl> FillInHostReplicatedLoadBalancer::clone() cons
 
 
 std::pair<std::vector<int32_t>,size_t> FillInHostReplicatedLoadBalancer::micro_batch_screen(
-  const BasisSet<double>&      bs,
   const std::array<double,3>&  box_lo,
   const std::array<double,3>&  box_up
 ) const {
 
+  const auto& bs = *this->basis_;
+
 
   int32_t first_shell = -1;
   int32_t last_shell  = -1;
-  for(auto iSh = 0ul; iSh < bs.size(); ++iSh) {
-
-    const auto& center = bs[iSh].O();
-    const auto  crad   = bs[iSh].cutoff_radius();
-    const bool intersect = 
-      geometry::cube_sphere_intersect( box_lo, box_up, center, crad );
-    
-    if( intersect ) {
-      if( first_shell < 0 ) first_shell = iSh;
-      last_shell = iSh;
-    }
-
-  }
+  shell_index_->for_each_intersecting( box_lo, box_up, [&]( int32_t iSh ) {
+    first_shell = first_shell < 0 ? iSh : std::min( first_shell, iSh );
+    last_shell  = std::max( last_shell, iSh );
+  });
 
   if( first_shell < 0 ) {
     return std::pair( std::vector<int32_t>{}, 0ul );
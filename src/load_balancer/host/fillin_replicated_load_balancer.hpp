@@ -25,8 +25,8 @@ struct FillInHostReplicatedLoadBalancer : public HostReplicatedLoadBalancer {
   std::unique_ptr<LoadBalancerImpl> clone() const override final;
 
   std::pair< std::vector<int32_t>, size_t > micro_batch_screen(
-    const BasisSet<double>&, const std::array<double,3>&,
-    const std::array<double,3>& ) const override final;
+    const std::array<double,3>&, const std::array<double,3>& ) const 
+    override final;
 
 };
 
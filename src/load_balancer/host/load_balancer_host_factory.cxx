@@ -15,7 +15,7 @@ namespace GauXC {
 std::shared_ptr<LoadBalancer> LoadBalancerHostFactory::get_shared_instance(
   std::string kernel_name, const RuntimeEnvironment& rt,
   const Molecule& mol, const MolGrid& mg, const BasisSet<double>& basis,
-  size_t pv
+  size_t pv, const LoadBalancerSettings& settings
 ) {
 
   std::transform(kernel_name.begin(), kernel_name.end(), 
@@ -28,12 +28,12 @@ std::shared_ptr<LoadBalancer> LoadBalancerHostFactory::get_shared_instance(
   std::unique_ptr<detail::LoadBalancerImpl> ptr = nullptr;
   if( kernel_name == "REPLICATED-PETITE" )
     ptr = std::make_unique<detail::PetiteHostReplicatedLoadBalancer>(
-      rt, mol, mg, basis, pv
+      rt, mol, mg, basis, pv, settings
     );
 
   if( kernel_name == "REPLICATED-FILLIN" )
     ptr = std::make_unique<detail::FillInHostReplicatedLoadBalancer>(
-      rt, mol, mg, basis, pv
+      rt, mol, mg, basis, pv, settings
     );
 
   if( ! ptr ) GAUXC_GENERIC_EXCEPTION("Load Balancer Kernel Not Recognized: " + kernel_name);
@@ -6,6 +6,9 @@
  * See LICENSE.txt for details
  */
 #include "replicated_host_load_balancer.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "integrator_util/task_merge.hpp"
+#include <set>
 
 namespace GauXC {
 namespace detail {
@@ -25,123 +28,190 @@ std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
   std::vector< XCTask > local_work;
   std::vector<size_t> global_workload( world_size, 0 );   
 
-  const auto natoms = this->mol_->natoms();
-  int32_t iCurrent  = 0;
-  int32_t atBatchSz = 1;
+  const auto& mol   = *this->mol_;
+  const auto natoms = mol.natoms();
+
+  // Batchers are evaluated at the origin and their batches translated to
+  // the atomic centers, such that they are not modified while generating
+  // tasks. Recentering happens once per distinct atomic number
+  std::set<int64_t> unique_Z;
+  for( const auto& atom : mol )
+  if( unique_Z.insert( atom.Z.get() ).second )
+    mg_->get_grid(atom.Z).batcher().quadrature().recenter( {0., 0., 0.} );
+
+  // Flat (atom, batch) iteration space, atom_batch_st[iA] is the global
+  // index of the first batch of atom iA
+  std::vector<size_t> atom_batch_st( natoms + 1, 0 );
+  for( size_t iA = 0; iA < natoms; ++iA )
+    atom_batch_st[iA+1] = atom_batch_st[iA] + 
+      mg_->get_grid(mol[iA].Z).batcher().nbatches();
+
+  // Partition weights are (optionally) applied by each thread to the tasks
+  // it has just generated, while they are still resident in cache. Every
+  // rank generates every batch, so with several ranks the weights are only
+  // applied to the tasks assigned to this rank, once per atom block
+  const bool fuse_weights = settings_.fuse_partition_weights;
+  const bool fuse_weights_in_threads = fuse_weights and world_size == 1;
+  auto negligible_weights = [&]( const XCTask& task ) {
+    return std::all_of( task.weights.begin(), task.weights.end(), 
+      [&]( double w ){ return std::abs(w) <= settings_.weight_screen_tol; } );
+  };
+  std::unique_ptr<LocalWorkDriver> weights_lwd;
+  LocalHostWorkDriver* lwd = nullptr;
+  if( fuse_weights ) {
+    weights_lwd = LocalWorkDriverFactory::make_local_work_driver( 
+      ExecutionSpace::Host, settings_.weights_kernel_name );
+    lwd = dynamic_cast<LocalHostWorkDriver*>(weights_lwd.get());
+  }
 
-  const size_t max_nbatches = mg_->max_nbatches();
+  // Atoms are processed in blocks spanning at least min_block_nbatches
+  // batches, which bounds the number of (non-local) tasks held at once
+  constexpr size_t min_block_nbatches = 4096;
   std::vector< std::pair<size_t, XCTask> > temp_tasks;
-  temp_tasks.reserve( max_nbatches );
 
-  // For batching of multiple atom screening
-  size_t batch_idx_offset = 0;
+  for( size_t iA_st = 0; iA_st < natoms; ) {
+
+    size_t iA_en = iA_st + 1;
+    while( iA_en < natoms and 
+      atom_batch_st[iA_en] - atom_batch_st[iA_st] < min_block_nbatches ) iA_en++;
+
+    const size_t ibatch_st = atom_batch_st[iA_st];
+    const size_t ibatch_en = atom_batch_st[iA_en];
 
-  // Loop over Atoms
-  for( const auto& atom : *this->mol_ ) {
+    #pragma omp parallel
+    {
 
-    const std::array<double,3> center = { atom.x, atom.y, atom.z };
+    // Per-thread output buffers
+    std::vector<XCTask> thread_tasks;
+    std::vector<size_t> thread_batch_idx;
 
-    auto& batcher = mg_->get_grid(atom.Z).batcher();
-    batcher.quadrature().recenter( center );
-    const size_t nbatches = batcher.nbatches();
+    #pragma omp for schedule(dynamic) nowait
+    for( size_t batch_idx = ibatch_st; batch_idx < ibatch_en; ++batch_idx ) {
 
-    #pragma omp parallel for
-    for( size_t ibatch = 0; ibatch < nbatches; ++ibatch ) {
-    
-      size_t batch_idx = ibatch + batch_idx_offset;
+      const int32_t iAtom = std::distance( atom_batch_st.begin(),
+        std::upper_bound( atom_batch_st.begin(), atom_batch_st.end(), 
+          batch_idx ) ) - 1;
+      const auto& atom    = mol[iAtom];
+      const auto& batcher = mg_->get_grid(atom.Z).batcher();
+      const std::array<double,3> center = { atom.x, atom.y, atom.z };
 
       // Generate the batch (non-negligible cost)
-      auto [lo, up, points, weights] = batcher.at(ibatch);
+      auto [lo, up, points, weights] = 
+        batcher.at( batch_idx - atom_batch_st[iAtom] );
 
       if( points.size() == 0 ) continue;
 
+      // Translate to the atomic center
+      for( int d = 0; d < 3; ++d ) { lo[d] += center[d]; up[d] += center[d]; }
+      for( auto& point : points )
+      for( int d = 0; d < 3; ++d ) point[d] += center[d];
+
       // Microbatch Screening
-      auto [shell_list, nbe] = micro_batch_screen( (*this->basis_), lo, up );
+      auto [shell_list, nbe] = micro_batch_screen( lo, up );
 
       // Course grain screening
       if( not shell_list.size() ) continue; 
 
       // Copy task data
       XCTask task;
-      task.iParent    = iCurrent;
+      task.iParent    = iAtom;
       // This enables lazy assignment of points vector (see CUDA impl)
       task.npts       = points.size(); 
       task.points     = std::move( points );
       task.weights    = std::move( weights );
       task.bfn_screening.shell_list = std::move(shell_list);
       task.bfn_screening.nbe        = nbe;
-      task.dist_nearest = molmeta_->dist_nearest()[iCurrent];
-
-      #pragma omp critical
-      temp_tasks.push_back( 
-        std::pair(batch_idx,std::move( task )) 
-      );
-
-    } // omp parallel for over batches
+      task.dist_nearest = molmeta_->dist_nearest()[iAtom];
 
+      thread_tasks.emplace_back( std::move(task) );
+      thread_batch_idx.emplace_back( batch_idx );
 
+    } // omp for over (atom, batch) pairs
 
+    if( fuse_weights_in_threads and thread_tasks.size() ) {
 
+      lwd->partition_weights( settings_.weight_alg, mol, *this->molmeta_,
+        thread_tasks.begin(), thread_tasks.end() );
 
-    // Assign Tasks to MPI ranks
-    if( (iCurrent+1) % atBatchSz == 0 or iCurrent == ((int32_t)natoms-1) ) {
+    }
 
-      // Sort based on task index for deterministic assignment
-      std::sort( temp_tasks.begin(), temp_tasks.end(), 
-        []( const auto& a, const auto& b ) {
-          return a.first < b.first;
-        } );
+    #pragma omp critical
+    {
+    for( size_t i = 0; i < thread_tasks.size(); ++i ) {
+      // Drop tasks with negligible weights before they are assigned
+      if( fuse_weights_in_threads and negligible_weights(thread_tasks[i]) ) 
+        continue;
+      temp_tasks.emplace_back( thread_batch_idx[i], std::move(thread_tasks[i]) );
+    }
+    }
 
-      // Assign batches to MPI ranks
-      for( size_t ibatch = 0; ibatch < temp_tasks.size(); ++ibatch ) {
+    } // OMP context
 
-        XCTask task = std::move(temp_tasks.at(ibatch).second);
-        //auto& points = task.points;
-        //auto  nbe    = task.nbe;
+    // Sort based on task index for deterministic assignment
+    std::sort( temp_tasks.begin(), temp_tasks.end(), 
+      []( const auto& a, const auto& b ) {
+        return a.first < b.first;
+      } );
 
-        if( task.points.size() % pad_value_ ) {
-          // Pad the points with zero-weights
-          size_t npts = task.points.size();
-          size_t npts_add = pad_value_ - (npts % pad_value_);
+    // Assign batches to MPI ranks
+    const size_t local_block_st = local_work.size();
+    for( auto& temp_task : temp_tasks ) {
 
-          // Copy first point to the remainder to ensure same spatially locality
-          const auto pt_to_add = task.points.front();
-          task.points.insert( task.points.end(), npts_add, pt_to_add );
+      XCTask task = std::move(temp_task.second);
 
-          // Fill weights remainder with zeros
-          task.weights.insert( task.weights.end(), npts_add, 0.0 );
+      if( task.points.size() % pad_value_ ) {
+        // Pad the points with zero-weights
+        size_t npts = task.points.size();
+        size_t npts_add = pad_value_ - (npts % pad_value_);
 
-          // Update NPTS
-          task.npts = task.points.size();
-        }
+        // Copy first point to the remainder to ensure same spatially locality
+        const auto pt_to_add = task.points.front();
+        task.points.insert( task.points.end(), npts_add, pt_to_add );
 
-        // Get rank with minimum work
-        auto min_rank_it = 
-          std::min_element( global_workload.begin(), global_workload.end() );
-        int64_t min_rank = std::distance( global_workload.begin(), min_rank_it );
+        // Fill weights remainder with zeros
+        task.weights.insert( task.weights.end(), npts_add, 0.0 );
 
-        // Compute cost heuristic and increment total work
-        global_workload[ min_rank ] += task.cost( n_deriv, natoms );
+        // Update NPTS
+        task.npts = task.points.size();
+      }
 
-        if( world_rank == min_rank ) 
-          local_work.push_back( std::move(task) );
+      // Get rank with minimum work
+      auto min_rank_it = 
+        std::min_element( global_workload.begin(), global_workload.end() );
+      int64_t min_rank = std::distance( global_workload.begin(), min_rank_it );
 
-      }
+      // Compute cost heuristic and increment total work
+      global_workload[ min_rank ] += task.cost( n_deriv, natoms );
 
-      temp_tasks.clear();
+      if( world_rank == min_rank ) 
+        local_work.push_back( std::move(task) );
 
     }
 
+    // Partition the weights of the tasks of this block assigned to this
+    // rank. Negligible tasks are dropped after the assignment, which has
+    // to agree between ranks
+    if( fuse_weights and not fuse_weights_in_threads ) {
+      auto block_begin = local_work.begin() + local_block_st;
+      lwd->partition_weights( settings_.weight_alg, mol, *this->molmeta_,
+        block_begin, local_work.end() );
+      local_work.erase( std::remove_if( block_begin, local_work.end(),
+        negligible_weights ), local_work.end() );
+    }
 
-    // Update counters and offsets
-    iCurrent++;
-    batch_idx_offset += nbatches;
+    temp_tasks.clear();
+    iA_st = iA_en;
 
-  } // Loop over Atoms
+  } // Loop over atom blocks
 
 //return local_work;
 
-  // Lexicographic ordering of tasks
+  // Merge equivalent tasks (grouped by fingerprint, no ordering required).
+  // The points of each merged task retain the batch order
+  local_work = merge_equivalent_tasks( std::move(local_work) );
+
+  // Lexicographic ordering of the (far fewer) merged tasks, each of which
+  // has a distinct (iParent, shell list) key
   auto task_order = []( const auto& a, const auto& b ) {
 
     // Sort by iParent first
@@ -156,52 +226,48 @@ std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
   std::sort( local_work.begin(), local_work.end(),
     task_order ); 
 
+  return local_work;
+}
+
 
-  // Get unique tasks
-  auto task_equiv = []( const auto& a, const auto& b ) {
-    return a.equiv_with(b);
-  };
+void HostReplicatedLoadBalancer::basis_modified_() {
 
-  auto local_work_unique = local_work;
-  auto last_unique = 
-    std::unique( local_work_unique.begin(),
-                 local_work_unique.end(),
-                 task_equiv );
-  local_work_unique.erase( last_unique, local_work_unique.end() );
-  
-
-  // Merge tasks
-  for( auto&& t : local_work_unique ) {
-    t.points.clear();
-    t.weights.clear();
-    t.npts = 0;
-  }
+  // Shells have moved along with basis_ (a new instance, the index may be
+  // shared with copies of this LoadBalancer)
+  shell_index_ = std::make_shared<ShellSpatialIndex>( *this->basis_ );
 
-  auto cur_lw_begin = local_work.begin();
-  auto cur_uniq_it  = local_work_unique.begin();
+}
 
-  for( auto lw_it = local_work.begin(); lw_it != local_work.end(); ++lw_it ) 
-  if( not task_equiv( *lw_it, *cur_uniq_it ) ) {
+void HostReplicatedLoadBalancer::rescreen_local_tasks_() {
 
-    if( cur_uniq_it == local_work_unique.end() )
-      GAUXC_GENERIC_EXCEPTION("Messed up in unique");
+  const size_t ntasks = local_tasks_.size();
 
-    cur_uniq_it->merge_with( cur_lw_begin, lw_it );
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
 
-    cur_lw_begin = lw_it;
-    cur_uniq_it++;
+    auto& task = local_tasks_[iT];
 
-  }
+    // Bounding box of the (translated) task points
+    std::array<double,3> lo = task.points.front(), up = lo;
+    for( const auto& point : task.points )
+    for( int d = 0; d < 3; ++d ) {
+      lo[d] = std::min( lo[d], point[d] );
+      up[d] = std::max( up[d], point[d] );
+    }
 
-  // Merge the last set of batches
-  for( ; cur_lw_begin != local_work.end(); ++cur_lw_begin )
-    cur_uniq_it->merge_with( *cur_lw_begin );
-  cur_uniq_it++;
-  
+    auto [shell_list, nbe] = micro_batch_screen( lo, up );
+    task.bfn_screening = XCTask::screening_data();
+    task.cou_screening = XCTask::screening_data();
+    task.bfn_screening.shell_list = std::move(shell_list);
+    task.bfn_screening.nbe        = nbe;
 
-  local_work = std::move(local_work_unique);
+  }
+
+  // Course grain screening
+  local_tasks_.erase( std::remove_if( local_tasks_.begin(), local_tasks_.end(),
+    []( const auto& task ){ return task.bfn_screening.shell_list.empty(); } ),
+    local_tasks_.end() );
 
-  return local_work;
 }
 
 
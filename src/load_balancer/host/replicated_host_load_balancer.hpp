@@ -8,6 +8,7 @@
 #pragma once
 
 #include "load_balancer_impl.hpp"
+#include "shell_spatial_index.hpp"
 
 namespace GauXC  {
 namespace detail {
@@ -18,22 +19,29 @@ protected:
 
   using basis_type = BasisSet<double>;
   std::vector< XCTask > create_local_tasks_() const override;
+  void basis_modified_() override;
+  void rescreen_local_tasks_() override;
+
+  /// Spatial index over the shells of basis_ (used in micro_batch_screen)
+  std::shared_ptr<ShellSpatialIndex> shell_index_;
 
 public:
 
   HostReplicatedLoadBalancer() = delete;
   template <typename... Args>
   HostReplicatedLoadBalancer( Args&&... args ):
-    LoadBalancerImpl( std::forward<Args>(args)... ) { }
+    LoadBalancerImpl( std::forward<Args>(args)... ),
+    shell_index_( std::make_shared<ShellSpatialIndex>(*this->basis_) ) { }
 
   HostReplicatedLoadBalancer( const HostReplicatedLoadBalancer& );
   HostReplicatedLoadBalancer( HostReplicatedLoadBalancer&& ) noexcept;
 
   virtual ~HostReplicatedLoadBalancer() noexcept;
 
+  /// Screen the shells of basis_ against a bounding box (through 
+  /// shell_index_). Shell lists are returned in increasing order
   virtual std::pair< std::vector<int32_t>, size_t > micro_batch_screen(
-    const BasisSet<double>&, const std::array<double,3>&,
-    const std::array<double,3>& ) const = 0;
+    const std::array<double,3>&, const std::array<double,3>& ) const = 0;
 
 };
 
@@ -0,0 +1,183 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/basisset.hpp>
+#include <gauxc/util/geometry.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace GauXC::detail {
+
+/** Spatial index over the (center, cutoff radius) spheres of a BasisSet
+ *
+ *  Shells are binned into classes of cutoff radii within a factor of two
+ *  of each other. Each class stores its shell centers in a uniform grid
+ *  (CSR) with a cell edge on the order of the largest radius of the class,
+ *  such that a box query only visits the cells within that radius of the
+ *  box. Candidates are subjected to the same cube-sphere test as the
+ *  brute force screening, hence the result is identical.
+ */
+class ShellSpatialIndex {
+
+  using point_t = std::array<double,3>;
+
+  /// Uniform grid over the shells of a radius class
+  struct ShellGrid {
+    double                r_max;   ///< Largest cutoff radius of the class
+    point_t               lo;      ///< Lower corner of the grid
+    double                h;       ///< Cell edge
+    std::array<int64_t,3> ncell;   ///< Number of cells per dimension
+    std::vector<int32_t>  cell_st; ///< Cell offsets into shells (ncells+1)
+    std::vector<int32_t>  shells;  ///< Shell indices, sorted by cell
+
+    inline int64_t cell_coord( double x, int d ) const {
+      const double i = std::floor( (x - lo[d]) / h );
+      return std::clamp( i, 0., double(ncell[d] - 1) );
+    }
+
+    inline int64_t cell_index( int64_t i, int64_t j, int64_t k ) const {
+      return i + ncell[0] * (j + ncell[1] * k);
+    }
+  };
+
+  std::vector<point_t>   centers_; ///< Shell centers
+  std::vector<double>    radii_;   ///< Shell cutoff radii
+  std::vector<ShellGrid> grids_;   ///< One grid per radius class
+
+  /// Relative slack of the candidate search w.r.t. roundoff
+  static constexpr double slack = 1e-10;
+
+public:
+
+  /// Minimum cell edge (bohr)
+  static constexpr double min_cell_edge = 1.;
+
+  template <typename F>
+  ShellSpatialIndex( const BasisSet<F>& basis ) {
+
+    const size_t nshells = basis.nshells();
+    centers_.reserve( nshells );
+    radii_.reserve( nshells );
+    for( const auto& sh : basis ) {
+      centers_.push_back({ sh.O()[0], sh.O()[1], sh.O()[2] });
+      radii_.push_back( sh.cutoff_radius() );
+    }
+    if( not nshells ) return;
+
+    // Radius classes: r in (r_min 2^(k-1), r_min 2^k]
+    const double r_min = std::max( min_cell_edge,
+      *std::min_element( radii_.begin(), radii_.end() ) );
+    std::vector<int32_t> shell_class( nshells );
+    for( size_t i = 0; i < nshells; ++i )
+      shell_class[i] = std::max( 0., std::ceil( std::log2(radii_[i] / r_min) ) );
+    const int32_t nclass =
+      *std::max_element( shell_class.begin(), shell_class.end() ) + 1;
+
+    for( int32_t c = 0; c < nclass; ++c ) {
+
+      std::vector<int32_t> class_shells;
+      for( size_t i = 0; i < nshells; ++i )
+        if( shell_class[i] == c ) class_shells.push_back( i );
+      if( class_shells.empty() ) continue;
+
+      ShellGrid grid;
+      grid.r_max = 0.;
+      point_t hi;
+      grid.lo.fill(  std::numeric_limits<double>::infinity() );
+      hi.fill( -std::numeric_limits<double>::infinity() );
+      for( auto i : class_shells ) {
+        grid.r_max = std::max( grid.r_max, radii_[i] );
+        for( int d = 0; d < 3; ++d ) {
+          grid.lo[d] = std::min( grid.lo[d], centers_[i][d] );
+          hi[d]      = std::max( hi[d],      centers_[i][d] );
+        }
+      }
+
+      grid.h = std::max( grid.r_max, min_cell_edge );
+      for( int d = 0; d < 3; ++d )
+        grid.ncell[d] = std::max<int64_t>( 1,
+          std::ceil( (hi[d] - grid.lo[d]) / grid.h ) );
+
+      // Counting sort of the shells into their cells
+      const size_t ncells = grid.ncell[0] * grid.ncell[1] * grid.ncell[2];
+      std::vector<int64_t> sh_cell( class_shells.size() );
+      grid.cell_st.assign( ncells + 1, 0 );
+      for( size_t i = 0; i < class_shells.size(); ++i ) {
+        const auto& O = centers_[class_shells[i]];
+        sh_cell[i] = grid.cell_index( grid.cell_coord(O[0],0),
+          grid.cell_coord(O[1],1), grid.cell_coord(O[2],2) );
+        grid.cell_st[ sh_cell[i] + 1 ]++;
+      }
+      for( size_t i = 0; i < ncells; ++i ) grid.cell_st[i+1] += grid.cell_st[i];
+
+      grid.shells.resize( class_shells.size() );
+      std::vector<int32_t> fill( grid.cell_st.begin(), grid.cell_st.end() - 1 );
+      for( size_t i = 0; i < class_shells.size(); ++i )
+        grid.shells[ fill[sh_cell[i]]++ ] = class_shells[i];
+
+      grids_.emplace_back( std::move(grid) );
+
+    }
+
+  }
+
+  /// Number of shells in the index
+  inline size_t nshells() const { return centers_.size(); }
+
+  /** Visit every shell whose cutoff sphere intersects a box (unordered)
+   *
+   *  @param[in] box_lo Lower corner of the box
+   *  @param[in] box_up Upper corner of the box
+   *  @param[in] func   Callable as func( shell index )
+   */
+  template <typename Func>
+  void for_each_intersecting( const point_t& box_lo, const point_t& box_up,
+    Func&& func ) const {
+
+    for( const auto& grid : grids_ ) {
+
+      const double r = grid.r_max * (1. + slack);
+      std::array<int64_t,3> st, en;
+      for( int d = 0; d < 3; ++d ) {
+        st[d] = grid.cell_coord( box_lo[d] - r, d );
+        en[d] = grid.cell_coord( box_up[d] + r, d );
+      }
+
+      for( int64_t k = st[2]; k <= en[2]; ++k )
+      for( int64_t j = st[1]; j <= en[1]; ++j )
+      for( int64_t i = st[0]; i <= en[0]; ++i ) {
+        const auto ic = grid.cell_index(i,j,k);
+        for( auto is = grid.cell_st[ic]; is < grid.cell_st[ic+1]; ++is ) {
+          const auto iSh = grid.shells[is];
+          if( geometry::cube_sphere_intersect( box_lo, box_up, centers_[iSh],
+            radii_[iSh] ) ) func( iSh );
+        }
+      }
+
+    }
+
+  }
+
+  /// Sorted list of shells whose cutoff sphere intersects a box
+  std::vector<int32_t> intersecting_shells( const point_t& box_lo,
+    const point_t& box_up ) const {
+    std::vector<int32_t> shell_list;
+    for_each_intersecting( box_lo, box_up,
+      [&]( int32_t iSh ){ shell_list.push_back( iSh ); } );
+    std::sort( shell_list.begin(), shell_list.end() );
+    return shell_list;
+  }
+
+};
+
+}
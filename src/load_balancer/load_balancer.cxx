@@ -46,6 +46,16 @@ void LoadBalancer::rebalance_exx() {
   pimpl_->rebalance_exx();
 }
 
+void LoadBalancer::update_geometry( const Molecule& mol ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  pimpl_->update_geometry( mol );
+}
+
+size_t LoadBalancer::compact_tasks( double weight_tol ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->compact_tasks( weight_tol );
+}
+
 const util::Timer& LoadBalancer::get_timings() const {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
   return pimpl_->get_timings();
@@ -14,8 +14,9 @@
 
 namespace GauXC {
 
-LoadBalancerFactory::LoadBalancerFactory( ExecutionSpace ex, std::string kernel_name ) :
-  ex_(ex), kernel_name_(kernel_name) { }
+LoadBalancerFactory::LoadBalancerFactory( ExecutionSpace ex, std::string kernel_name,
+  LoadBalancerSettings settings ) :
+  ex_(ex), kernel_name_(kernel_name), settings_(settings) { }
 
 std::shared_ptr<LoadBalancer> LoadBalancerFactory::get_shared_instance(
   const RuntimeEnvironment& rt,
@@ -27,12 +28,12 @@ std::shared_ptr<LoadBalancer> LoadBalancerFactory::get_shared_instance(
     case ExecutionSpace::Host:
       using host_factory = LoadBalancerHostFactory;
       return host_factory::get_shared_instance(kernel_name_,
-        rt, mol, mg, basis, pad_value );
+        rt, mol, mg, basis, pad_value, settings_ );
     #ifdef GAUXC_ENABLE_DEVICE
     case ExecutionSpace::Device:
       using device_factory = LoadBalancerDeviceFactory;
       return device_factory::get_shared_instance(kernel_name_,
-        rt, mol, mg, basis, pad_value );
+        rt, mol, mg, basis, pad_value, settings_ );
     #endif
     default:
       GAUXC_GENERIC_EXCEPTION("Unrecognized Execution Space");
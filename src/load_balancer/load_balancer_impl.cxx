@@ -6,17 +6,20 @@
  * See LICENSE.txt for details
  */
 #include "load_balancer_impl.hpp"
+#include "integrator_util/integrator_common.hpp"
 
 namespace GauXC::detail {
 
 LoadBalancerImpl::LoadBalancerImpl( const RuntimeEnvironment& rt, const Molecule& mol, 
-  const MolGrid& mg, const basis_type& basis, std::shared_ptr<MolMeta> molmeta, size_t pv ) :
+  const MolGrid& mg, const basis_type& basis, std::shared_ptr<MolMeta> molmeta, size_t pv,
+  const LoadBalancerSettings& settings ) :
   runtime_(rt), 
   mol_( std::make_shared<Molecule>(mol) ),
   mg_( std::make_shared<MolGrid>(mg)  ),
   basis_( std::make_shared<basis_type>(basis) ),
   molmeta_( molmeta ),
-  pad_value_(pv) { 
+  pad_value_(pv),
+  settings_(settings) { 
 
   shell_pairs_ = std::make_shared<shell_pair_type>(*basis_);
   basis_map_   = std::make_shared<basis_map_type>(*basis_, mol);
@@ -24,12 +27,16 @@ LoadBalancerImpl::LoadBalancerImpl( const RuntimeEnvironment& rt, const Molecule
 }
 
 LoadBalancerImpl::LoadBalancerImpl( const RuntimeEnvironment& rt, const Molecule& mol, 
-  const MolGrid& mg, const basis_type& basis, const MolMeta& molmeta, size_t pv ) :
-  LoadBalancerImpl( rt, mol, mg, basis, std::make_shared<MolMeta>(molmeta), pv ) { }
+  const MolGrid& mg, const basis_type& basis, const MolMeta& molmeta, size_t pv,
+  const LoadBalancerSettings& settings ) :
+  LoadBalancerImpl( rt, mol, mg, basis, std::make_shared<MolMeta>(molmeta), pv,
+    settings ) { }
 
 LoadBalancerImpl::LoadBalancerImpl( const RuntimeEnvironment& rt, const Molecule& mol, 
-  const MolGrid& mg, const basis_type& basis, size_t pv ) :
-  LoadBalancerImpl( rt, mol, mg, basis, std::make_shared<MolMeta>(mol), pv ) { }
+  const MolGrid& mg, const basis_type& basis, size_t pv,
+  const LoadBalancerSettings& settings ) :
+  LoadBalancerImpl( rt, mol, mg, basis, std::make_shared<MolMeta>(mol), pv,
+    settings ) { }
 
 
 LoadBalancerImpl::LoadBalancerImpl( const LoadBalancerImpl& ) = default;
@@ -38,15 +45,22 @@ LoadBalancerImpl::LoadBalancerImpl( LoadBalancerImpl&& ) noexcept = default;
 LoadBalancerImpl::~LoadBalancerImpl() noexcept = default;
 
 const std::vector<XCTask>& LoadBalancerImpl::get_tasks() const {
-  if( not local_tasks_.size() ) GAUXC_GENERIC_EXCEPTION("No Tasks Created");
+  if( not tasks_created_ ) GAUXC_GENERIC_EXCEPTION("No Tasks Created");
   return local_tasks_;
 }
 
 std::vector<XCTask>& LoadBalancerImpl::get_tasks() {
 
-  if( not local_tasks_.size() ) {
+  if( not tasks_created_ ) {
     auto create_tasks_st = std::chrono::high_resolution_clock::now();
     local_tasks_ = create_local_tasks_();
+    populate_submat_maps_();
+    tasks_modified_();
+    tasks_created_ = true;
+    if( settings_.fuse_partition_weights ) {
+      state_.modified_weights_are_stored = true;
+      state_.weight_alg = settings_.weight_alg;
+    }
     auto create_tasks_en = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> create_tasks_dr = create_tasks_en - create_tasks_st; 
     timer_.add_timing("LoadBalancer.CreateTasks", create_tasks_dr);
@@ -56,6 +70,177 @@ std::vector<XCTask>& LoadBalancerImpl::get_tasks() {
   return local_tasks_;
 }
 
+void LoadBalancerImpl::populate_submat_maps_() {
+
+  // Submatrix maps only depend on the (bfn) shell list, so they are
+  // generated once here and reused by every integrator call. Maps
+  // already present (e.g. chunked maps from a device integrator) are
+  // valid partitions as well and are left untouched.
+  const int32_t nbf    = basis_->nbf();
+  const size_t  ntasks = local_tasks_.size();
+
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    auto& bfn_screening = local_tasks_[iT].bfn_screening;
+    if( bfn_screening.shell_list.size() and bfn_screening.submat_map.empty() ) {
+      std::tie( bfn_screening.submat_map, bfn_screening.submat_block ) =
+        gen_compressed_submat_map( *basis_map_, bfn_screening.shell_list, 
+          nbf, nbf );
+    }
+  }
+
+}
+
+void LoadBalancerImpl::tasks_modified_() {
+
+  const size_t ntasks = local_tasks_.size();
+  for( size_t iT = 0; iT < ntasks; ++iT ) local_tasks_[iT].task_id = iT;
+  state_.task_generation++;
+
+}
+
+void LoadBalancerImpl::basis_modified_() { }
+
+void LoadBalancerImpl::rescreen_local_tasks_() {
+  GAUXC_GENERIC_EXCEPTION("Task Rescreening NYI for this LoadBalancer");
+}
+
+void LoadBalancerImpl::update_geometry( const Molecule& mol ) {
+
+  const size_t natoms = mol_->natoms();
+  if( mol.natoms() != natoms )
+    GAUXC_GENERIC_EXCEPTION("Geometry Update Cannot Change the Number of Atoms");
+  for( size_t iA = 0; iA < natoms; ++iA )
+  if( mol[iA].Z != (*mol_)[iA].Z )
+    GAUXC_GENERIC_EXCEPTION("Geometry Update Cannot Change Atomic Numbers");
+
+  // Partition weights can only be updated from the raw quadrature weights
+  if( state_.modified_weights_are_stored )
+  for( const auto& task : local_tasks_ )
+  if( task.unpartitioned_weights.size() != task.weights.size() )
+    GAUXC_GENERIC_EXCEPTION("Geometry Update Would Invalidate Stored Weights");
+
+  auto update_st = std::chrono::high_resolution_clock::now();
+
+  std::vector<std::array<double,3>> disp( natoms );
+  for( size_t iA = 0; iA < natoms; ++iA ) {
+    disp[iA] = { mol[iA].x - (*mol_)[iA].x, mol[iA].y - (*mol_)[iA].y,
+                 mol[iA].z - (*mol_)[iA].z };
+  }
+
+  // Translate the basis shells with their centers. New instances are
+  // created as these may be shared with copies of this LoadBalancer
+  auto basis = std::make_shared<basis_type>( *basis_ );
+  const auto& shell_to_center = basis_map_->shell_to_center();
+  for( size_t iSh = 0; iSh < basis->size(); ++iSh ) {
+    const auto iA = shell_to_center[iSh];
+    if( iA < 0 ) continue;
+    auto& O = (*basis)[iSh].O();
+    for( int d = 0; d < 3; ++d ) O[d] += disp[iA][d];
+  }
+
+  mol_         = std::make_shared<Molecule>( mol );
+  molmeta_     = std::make_shared<MolMeta>( mol );
+  basis_       = basis;
+  shell_pairs_ = std::make_shared<shell_pair_type>( *basis_ );
+  basis_map_   = std::make_shared<basis_map_type>( *basis_, mol );
+  basis_modified_();
+
+  if( local_tasks_.size() ) {
+
+    // Translate the quadrature points with their parent atom
+    const auto& dist_nearest = molmeta_->dist_nearest();
+    for( auto& task : local_tasks_ ) {
+      const auto& d = disp[task.iParent];
+      for( auto& point : task.points )
+      for( int i = 0; i < 3; ++i ) point[i] += d[i];
+      task.dist_nearest = dist_nearest[task.iParent];
+      task.measured_cost = XCTask::cost_data(); // Screening changes
+    }
+
+    rescreen_local_tasks_();
+    populate_submat_maps_();
+
+  }
+  tasks_modified_();
+
+  auto update_en = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> update_dr = update_en - update_st;
+  timer_.add_timing("LoadBalancer.UpdateGeometry", update_dr);
+
+}
+
+size_t LoadBalancerImpl::compact_tasks( double weight_tol ) {
+
+  // Negligible points are identified by their partitioned weights
+  auto& tasks = get_tasks();
+  if( not state_.modified_weights_are_stored )
+    GAUXC_GENERIC_EXCEPTION("Task Compaction Requires Partitioned Weights");
+  const size_t ntasks = tasks.size();
+
+  auto compact_st = std::chrono::high_resolution_clock::now();
+
+  size_t npts_old = 0, npts_new = 0;
+  #pragma omp parallel for schedule(dynamic) reduction(+:npts_old,npts_new)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto& task = tasks[iT];
+    const size_t npts = task.points.size();
+    const bool keep_unpartitioned = task.unpartitioned_weights.size() == npts;
+    npts_old += npts;
+
+    // Stream compaction of the significant points
+    size_t nkeep = 0;
+    for( size_t i = 0; i < npts; ++i ) 
+    if( std::abs(task.weights[i]) > weight_tol ) {
+      task.points[nkeep]  = task.points[i];
+      task.weights[nkeep] = task.weights[i];
+      if( keep_unpartitioned ) 
+        task.unpartitioned_weights[nkeep] = task.unpartitioned_weights[i];
+      nkeep++;
+    }
+
+    // Pad the points with zero-weights (replicate the first point)
+    const size_t npts_pad = nkeep and (nkeep % pad_value_) ?
+      pad_value_ - (nkeep % pad_value_) : 0;
+    const size_t npts_task = nkeep + npts_pad;
+    if( nkeep ) {
+      const auto pt_to_add = task.points.front();
+      task.points.resize( nkeep );
+      task.points.resize( npts_task, pt_to_add );
+      task.weights.resize( nkeep ); 
+      task.weights.resize( npts_task, 0. );
+      if( keep_unpartitioned ) {
+        task.unpartitioned_weights.resize( nkeep );
+        task.unpartitioned_weights.resize( npts_task, 0. );
+      }
+    } else {
+      task.points.clear(); task.weights.clear(); 
+      task.unpartitioned_weights.clear();
+    }
+    task.npts = npts_task;
+    if( npts ) {
+      // Rescale measured costs to the compacted task
+      task.measured_cost.exc_vxc *= double(npts_task) / npts;
+      task.measured_cost.exx     *= double(npts_task) / npts;
+    }
+    npts_new += npts_task;
+
+  }
+
+  // Remove empty tasks
+  tasks.erase( std::remove_if( tasks.begin(), tasks.end(),
+    []( const auto& task ){ return task.points.empty(); } ), tasks.end() );
+  tasks_modified_();
+
+  auto compact_en = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> compact_dr = compact_en - compact_st;
+  timer_.add_timing("LoadBalancer.CompactTasks", compact_dr);
+
+  return npts_old - npts_new;
+
+}
+
 const util::Timer& LoadBalancerImpl::get_timings() const {
   return timer_;
 }
@@ -31,6 +31,7 @@ protected:
   std::shared_ptr<shell_pair_type> shell_pairs_;
 
   std::vector< XCTask >     local_tasks_;
+  bool                      tasks_created_ = false; ///< local_tasks_ may be empty after creation
 
   LoadBalancerState         state_;
 
@@ -38,18 +39,36 @@ protected:
 
   size_t                    pad_value_;
 
+  LoadBalancerSettings      settings_;
+
   virtual std::vector< XCTask > create_local_tasks_() const = 0;
 
+  /// Generate the (bfn) submatrix maps of local tasks which do not have them
+  void populate_submat_maps_();
+
+  /// Update data derived from basis_ after its shells have been moved
+  virtual void basis_modified_();
+
+  /// Regenerate the (bfn) screening of local tasks after a geometry update
+  virtual void rescreen_local_tasks_();
+
+  /// Assign task identifiers and advance the task generation after the
+  /// local tasks have been created or modified
+  void tasks_modified_();
+
 public:
 
   LoadBalancerImpl() = delete;
 
   LoadBalancerImpl( const RuntimeEnvironment&, const Molecule&, const MolGrid& mg,  
-    const basis_type&, size_t pv );
+    const basis_type&, size_t pv, 
+    const LoadBalancerSettings& = LoadBalancerSettings() );
   LoadBalancerImpl( const RuntimeEnvironment&, const Molecule&, const MolGrid& mg,  
-    const basis_type&, const MolMeta&, size_t pv );
+    const basis_type&, const MolMeta&, size_t pv,
+    const LoadBalancerSettings& = LoadBalancerSettings() );
   LoadBalancerImpl( const RuntimeEnvironment&, const Molecule&, const MolGrid& mg,  
-    const basis_type&, std::shared_ptr<MolMeta>, size_t pv );
+    const basis_type&, std::shared_ptr<MolMeta>, size_t pv,
+    const LoadBalancerSettings& = LoadBalancerSettings() );
 
   LoadBalancerImpl( const LoadBalancerImpl& );
   LoadBalancerImpl( LoadBalancerImpl&& ) noexcept;
@@ -63,6 +82,9 @@ public:
   void rebalance_exc_vxc();
   void rebalance_exx();
 
+  void update_geometry( const Molecule& mol );
+  size_t compact_tasks( double weight_tol );
+
   const util::Timer& get_timings() const;
 
   size_t max_npts()       const;
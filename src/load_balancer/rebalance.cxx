@@ -1,358 +1,236 @@
-/**
- * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
- * through Lawrence Berkeley National Laboratory (subject to receipt of
- * any required approvals from the U.S. Dept. of Energy). All rights reserved.
- *
- * See LICENSE.txt for details
- */
 #include "load_balancer_impl.hpp"
+#include "integrator_util/task_merge.hpp"
 #include <gauxc/util/mpi.hpp>
-#include <gauxc/util/div_ceil.hpp>
-#include <fstream>
+#include <cmath>
+#include <climits>
+#include <numeric>
+#include <type_traits>
 
 namespace GauXC::detail {
 
 #ifdef GAUXC_ENABLE_MPI
+namespace {
+
+template <typename T> struct is_std_vector                 : std::false_type {};
+template <typename T> struct is_std_vector<std::vector<T>> : std::true_type  {};
+
+/// Apply an operation to every task member which is migrated
+template <typename Task, typename Op>
+void for_each_migrated_member( Task& task, Op&& op ) {
+  op( task.iParent );
+  op( task.npts );
+  op( task.points );
+  op( task.weights );
+  op( task.unpartitioned_weights );
+  op( task.dist_nearest );
+  op( task.max_weight );
+  op( task.measured_cost.exc_vxc );
+  op( task.measured_cost.exx );
+  op( task.bfn_screening.shell_list );
+  op( task.bfn_screening.shell_pair_list );
+  op( task.bfn_screening.nbe );
+  op( task.cou_screening.shell_list );
+  op( task.cou_screening.shell_pair_list );
+  op( task.cou_screening.shell_pair_idx_list );
+  op( task.cou_screening.nbe );
+}
+
+/// Upper bound of the packed size of a scalar / vector in bytes
+size_t packed_size( size_t nbytes, MPI_Comm comm ) {
+  int sz; MPI_Pack_size( nbytes, MPI_BYTE, comm, &sz );
+  return sz;
+}
+
+/// Upper bound of the packed size of a task in bytes
+size_t packed_size( const XCTask& task, MPI_Comm comm ) {
+  size_t sz = 0;
+  for_each_migrated_member( task, [&]( const auto& member ) {
+    using member_type = std::decay_t<decltype(member)>;
+    if constexpr ( is_std_vector<member_type>::value ) {
+      sz += packed_size( sizeof(size_t), comm );
+      if( member.size() ) sz += packed_size( 
+        member.size() * sizeof(typename member_type::value_type), comm );
+    } else sz += packed_size( sizeof(member_type), comm );
+  });
+  return sz;
+}
+
+}
+
+/** Migrate tasks between ranks such that their total cost is balanced
+ *
+ *  Rank r is assigned the tasks whose cost midpoint falls into the global
+ *  cost interval [r, r+1) * total / nranks, which retains the global task
+ *  order and bounds the deviation from the average load by the largest
+ *  task cost. Tasks may be migrated to any number of ranks. Payloads are
+ *  packed per destination and exchanged with a nonblocking all-to-all.
+ *
+ *  Load imbalance (max / average rank cost) before and after migration
+ *  as well as timings are recorded in `timer` under `name`.
+ */
 template <typename TaskIterator, typename CostFunctor>
-auto rebalance(TaskIterator begin, TaskIterator end, const CostFunctor& cost, MPI_Comm comm) {
+std::vector<XCTask> rebalance( TaskIterator begin, TaskIterator end, 
+  const CostFunctor& cost, MPI_Comm comm, util::Timer& timer, 
+  const std::string& name ) {
 
   using hrt_t = std::chrono::high_resolution_clock;
-  using dur_t = std::chrono::duration<double, std::milli>;
 
   int world_rank, world_size;
   MPI_Comm_rank(comm, &world_rank);
   MPI_Comm_size(comm, &world_size);
 
-  MPI_Barrier(MPI_COMM_WORLD);
-  printf(
-  "RANK %d BEFORE REBALNACE: LW = %lu\n",
-    world_rank,
-    std::accumulate(begin, end, 0ul,
-      [=](const auto& a, const auto& b){ return a + cost(b); })
-  );
-
-  // Compute local task costs
-  size_t ntask_local = std::distance(begin, end);
-  std::vector<size_t> local_task_cost(ntask_local);
+  auto rebalance_st = hrt_t::now();
+
+  // Compute local task costs and their global prefix sum
+  const size_t ntask_local = std::distance(begin, end);
+  std::vector<size_t> local_task_cost(ntask_local), local_prefix_sum(ntask_local);
   std::transform(begin, end, local_task_cost.begin(),
     [&](const auto& task){ return cost(task); });
-
-  // Compute task prefix sum
-  auto prefix_st = hrt_t::now();
-  std::vector<size_t> local_prefix_sum(ntask_local);
-  auto [local_task_sum, prefix_seed] =
-    mpi_prefix_sum(local_task_cost.begin(), local_task_cost.end(),
-      local_prefix_sum.begin(), comm);
-
-  // Compute total/avg cost
-  auto total_task_sum = allreduce( local_task_sum, MPI_SUM, comm );
-  size_t task_avg = util::div_ceil(total_task_sum, world_size);
-
-
-  // Generate outgoing messages
-  struct task_message {
-    int dst;
-    size_t idx_st, idx_en, vol;
-  };
-
-  std::vector<task_message> task_outgoing;
-  auto it = local_prefix_sum.begin();
-  for( int i = 0; i < world_size; ++i) {
-    auto n_it = std::lower_bound(it, local_prefix_sum.end(), i,
-      [=](auto a, auto b) { return a / task_avg < b+1; });
-    size_t st_idx = std::distance(local_prefix_sum.begin(), it  );
-    size_t en_idx = std::distance(local_prefix_sum.begin(), n_it);
-    if(st_idx != en_idx and i != world_rank) {
-      size_t vol = 0;
-      for( size_t t = st_idx; t < en_idx; ++t ) {
-        vol += (begin + t)->volume();
-      }
-      task_outgoing.push_back({i,st_idx,en_idx,vol});
-      size_t work_to_send = 0;
-      for( size_t t = st_idx; t < en_idx; ++t ) {
-        work_to_send += cost(*(begin + t));
-      }
-      printf("RANK %d SENDING %lu to RANK %d\n", world_rank, work_to_send, i);
-    }
-    it = n_it;
-  }
-
-  auto prefix_en = hrt_t::now();
-
-  // Sanity check
-  if(task_outgoing.size() > 2 )
-    GAUXC_GENERIC_EXCEPTION("Incorrect Outgoing Task Message Size RANK = " + std::to_string(world_rank) + " SZ = " + std::to_string(task_outgoing.size()));
-
-  MPI_Barrier(comm);
-  ring_execute(
-  [&]() {
-    printf("RANK %d MESSAGES:\n", world_rank);
-    for(auto& msg : task_outgoing) {
-      printf("  DST %d ST %lu EN %lu V %lu\n",
-        msg.dst, msg.idx_st, msg.idx_en, msg.vol);
-    }
-  } , comm);
-  MPI_Barrier(comm);
-
-  std::vector<MPI_Request> packed_req; packed_req.reserve(8);
-
-  // Ask neighbors if they're sending messages
-  int recv_from_backward = 0;
-  int recv_from_forward = 0;
-  int send_forward = 0;
-  int send_backward = 0;
-  if(world_rank) {
-    auto& req = packed_req.emplace_back();
-    MPI_Irecv( &recv_from_backward, 1, MPI_INT, world_rank-1, 0, comm, &req );
-  }
-  if(world_rank < world_size-1) {
-    auto& req = packed_req.emplace_back();
-    MPI_Irecv( &recv_from_forward, 1, MPI_INT, world_rank+1, 1, comm, &req );
+  const size_t local_cost = mpi_prefix_sum( local_task_cost.begin(), 
+    local_task_cost.end(), local_prefix_sum.begin(), comm ).first;
+
+  const size_t total_cost      = allreduce( local_cost, MPI_SUM, comm );
+  const size_t max_cost_before = allreduce( local_cost, MPI_MAX, comm );
+
+  // Target rank of each task (nondecreasing)
+  std::vector<int> task_dst( ntask_local, world_rank );
+  if( total_cost )
+  for( size_t i = 0; i < ntask_local; ++i ) {
+    const double mid = local_prefix_sum[i] + 0.5 * local_task_cost[i];
+    task_dst[i] = std::min<double>( world_size - 1, 
+      std::floor( mid * world_size / total_cost ) );
   }
-  if(world_rank < world_size-1) {
-    auto& req = packed_req.emplace_back();
-    for(auto& msg : task_outgoing) send_forward |= (msg.dst == world_rank+1);
-    MPI_Isend( &send_forward, 1, MPI_INT, world_rank+1, 0, comm, &req );
-  }
-  if(world_rank) {
-    auto& req = packed_req.emplace_back();
-    for(auto& msg : task_outgoing) send_backward |= (msg.dst == world_rank-1);
-    MPI_Isend( &send_backward, 1, MPI_INT, world_rank-1, 1, comm, &req );
-  }
-
-
-
-  // Wait for messages to complete
-  if(packed_req.size()) {
-    MPI_Waitall(packed_req.size(), packed_req.data(), MPI_STATUS_IGNORE);
-  }
-  // Reset messages
-  packed_req.clear();
-
-  printf("RANK %d, BW %d, FW %d\n", world_rank, recv_from_backward, recv_from_forward );
-  MPI_Barrier(MPI_COMM_WORLD);
-
 
-#if 0
-  // Sanity check
-  if( world_rank < world_size - 1 and task_outgoing.size() != 1 )
-    GAUXC_GENERIC_EXCEPTION("Incorrect Outgoing Task Message Size RANK = " + std::to_string(world_rank));
-  if( world_rank == world_size - 1 and task_outgoing.size() )
-    GAUXC_GENERIC_EXCEPTION("Incorrect Outgoing Task Message Size RANK = " + std::to_string(world_rank));
-#endif
+  // Pack outgoing tasks, grouped by destination
+  auto pack_st = hrt_t::now();
+  size_t send_bound = 0;
+  for( size_t i = 0; i < ntask_local; ++i )
+  if( task_dst[i] != world_rank ) send_bound += packed_size( *(begin+i), comm );
+  send_bound += world_size * packed_size( sizeof(size_t), comm );
+  if( send_bound > INT_MAX )
+    GAUXC_GENERIC_EXCEPTION("Rebalance Send Volume Exceeds MPI Count Limit");
+
+  MPI_Packed_Buffer send_buffer( send_bound, comm );
+  std::vector<int> send_counts( world_size, 0 ), send_displs( world_size, 0 );
+  size_t local_st = 0, local_en = 0, ntask_sent = 0, i = 0;
+  for( int dst = 0; dst < world_size; ++dst ) {
+
+    const size_t st = i;
+    while( i < ntask_local and task_dst[i] == dst ) ++i;
+    if( dst == world_rank ) { local_st = st; local_en = i; continue; }
+    if( st == i ) continue;
+
+    send_displs[dst] = send_buffer.position();
+    send_buffer.pack( i - st );
+    for( size_t t = st; t < i; ++t )
+      for_each_migrated_member( *(begin+t), 
+        [&]( const auto& member ){ send_buffer.pack( member ); } );
+    send_counts[dst] = send_buffer.position() - send_displs[dst];
+    ntask_sent += i - st;
 
-  // Allocate incoming and outgoing buffers = 64 MiB
-  constexpr size_t packed_buffer_size = 64 * 1024 * 1024;
-  MPI_Packed_Buffer packed_outgoing_forward( packed_buffer_size, comm );
-  MPI_Packed_Buffer packed_incoming_forward( packed_buffer_size, comm );
-  MPI_Packed_Buffer packed_outgoing_backward( packed_buffer_size, comm );
-  MPI_Packed_Buffer packed_incoming_backward( packed_buffer_size, comm );
-
-  // Post receives
-  if(recv_from_backward) {
-    auto& packed_recv_req = packed_req.emplace_back();
-    MPI_Irecv( packed_incoming_backward.buffer(), packed_buffer_size, MPI_PACKED,
-      world_rank-1, 0, comm, &packed_recv_req );
-  }
-  if(recv_from_forward) {
-    auto& packed_recv_req = packed_req.emplace_back();
-    MPI_Irecv( packed_incoming_forward.buffer(), packed_buffer_size, MPI_PACKED,
-      world_rank+1, 0, comm, &packed_recv_req );
   }
+  auto pack_en = hrt_t::now();
 
-  auto pack_st = hrt_t::now();
-  {
-
-  //std::ofstream ofile("task_send." + std::to_string(world_rank) + ".txt");
-
-  auto pack_msg = [&](const auto& msg, auto& mpi_buffer) {
-    size_t ntask_send = msg.idx_en - msg.idx_st;
-    //ofile << "DEST " << msg.dst << std::endl;
-    mpi_buffer.pack(ntask_send); //ofile << ntask_send << std::endl;
-    for(size_t i = msg.idx_st; i < msg.idx_en; ++i) {
-      const auto& task = *(begin + i);
-      mpi_buffer.pack(task.iParent);
-      mpi_buffer.pack(task.npts);
-      mpi_buffer.pack(task.points);
-      mpi_buffer.pack(task.weights);
-      mpi_buffer.pack(task.bfn_screening.shell_list);
-      mpi_buffer.pack(task.bfn_screening.nbe);
-      mpi_buffer.pack(task.cou_screening.shell_list);
-      mpi_buffer.pack(task.cou_screening.shell_pair_list);
-      mpi_buffer.pack(task.cou_screening.shell_pair_idx_list);
-      mpi_buffer.pack(task.cou_screening.nbe);
-      mpi_buffer.pack(task.dist_nearest);
-      //ofile << task.iParent << ", " << task.npts << ", " << task.dist_nearest <<
-      //  ", " << task.bfn_screening.nbe << ", " << task.points.size() <<
-      //  ", " << task.cou_screening.nbe << ", " << task.cou_screening.shell_list.size() <<
-      //  ", " << task.cou_screening.shell_pair_list.size() << ", " << task.cou_screening.shell_pair_idx_list.size()
-      //  << std::endl;
+  // Exchange message sizes
+  std::vector<int> recv_counts( world_size ), recv_displs( world_size );
+  MPI_Alltoall( send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, 
+    MPI_INT, comm );
+  const size_t recv_size = 
+    std::accumulate( recv_counts.begin(), recv_counts.end(), 0ul );
+  if( recv_size > INT_MAX )
+    GAUXC_GENERIC_EXCEPTION("Rebalance Recv Volume Exceeds MPI Count Limit");
+  std::exclusive_scan( recv_counts.begin(), recv_counts.end(), 
+    recv_displs.begin(), 0 );
+
+  // Exchange tasks, retained tasks are moved in the meantime
+  auto exchange_st = hrt_t::now();
+  MPI_Packed_Buffer recv_buffer( recv_size, comm );
+  MPI_Request exchange_req;
+  MPI_Ialltoallv( send_buffer.buffer(), send_counts.data(), send_displs.data(),
+    MPI_PACKED, recv_buffer.buffer(), recv_counts.data(), recv_displs.data(),
+    MPI_PACKED, comm, &exchange_req );
+
+  std::vector<XCTask> retained_work( std::make_move_iterator(begin + local_st),
+    std::make_move_iterator(begin + local_en) );
+
+  MPI_Wait( &exchange_req, MPI_STATUS_IGNORE );
+  auto exchange_en = hrt_t::now();
+
+  // Unpack in rank order to retain the global task order
+  std::vector<XCTask> local_work;
+  for( int src = 0; src < world_size; ++src ) {
+
+    if( src == world_rank ) {
+      local_work.insert( local_work.end(), 
+        std::make_move_iterator(retained_work.begin()),
+        std::make_move_iterator(retained_work.end()) );
+      continue;
     }
+    if( not recv_counts[src] ) continue;
 
-    // Send data to neighbor
-    auto& packed_send_req = packed_req.emplace_back();
-    auto* buffer = mpi_buffer.buffer();
-    MPI_Isend(buffer, packed_buffer_size, MPI_PACKED, msg.dst, 0,
-      comm, &packed_send_req);
-  };
-
-  // Pack and send to neighbor
-  #if 0
-  if(send_backward or send_forward) {
-    // Pack Data
-    auto& msg = task_outgoing[0];
-    if( msg.dst != world_rank+1 )
-      GAUXC_GENERIC_EXCEPTION("Invalid Destination Rank");
-
-    size_t ntask_send = msg.idx_en - msg.idx_st;
-
-    //std::ofstream ofile("task_send." + std::to_string(world_rank) + ".txt");
-
-    packed_outgoing.pack(ntask_send); //ofile << ntask_send << std::endl;
-    //printf("RANK = %d SEND = %lu\n", world_rank, ntask_send);
-    for(size_t i = msg.idx_st; i < msg.idx_en; ++i) {
-      const auto& task = *(begin + i);
-      packed_outgoing.pack(task.iParent);
-      packed_outgoing.pack(task.npts);
-      packed_outgoing.pack(task.points);
-      packed_outgoing.pack(task.weights);
-      packed_outgoing.pack(task.bfn_screening.shell_list);
-      packed_outgoing.pack(task.bfn_screening.nbe);
-      packed_outgoing.pack(task.cou_screening.shell_list);
-      packed_outgoing.pack(task.cou_screening.shell_pair_list);
-      packed_outgoing.pack(task.cou_screening.shell_pair_idx_list);
-      packed_outgoing.pack(task.cou_screening.nbe);
-      packed_outgoing.pack(task.dist_nearest);
-      //ofile << task.iParent << ", " << task.npts << ", " << task.dist_nearest <<
-      //  ", " << task.bfn_screening.nbe << ", " << task.points.size() << std::endl;
+    size_t ntask_recv = 0;
+    recv_buffer.unpack( ntask_recv );
+    for( size_t iT = 0; iT < ntask_recv; ++iT ) {
+      auto& task = local_work.emplace_back();
+      for_each_migrated_member( task, 
+        [&]( auto& member ){ recv_buffer.unpack( member ); } );
     }
 
-    // Send data to neighbor
-    auto& packed_send_req = packed_req.emplace_back();
-    auto* buffer = packed_outgoing.buffer();
-    MPI_Isend(buffer, packed_buffer_size, MPI_PACKED, world_rank+1, 0,
-      comm, &packed_send_req);
-
-  }
-  #else
-  for( auto& msg : task_outgoing ) {
-    if(msg.dst == world_rank + 1)
-      pack_msg(msg, packed_outgoing_forward);
-    else
-      pack_msg(msg, packed_outgoing_backward);
-  }
-  #endif
   }
+  auto unpack_en = hrt_t::now();
+
+  // Report load imbalance
+  const size_t local_cost_after = std::accumulate( local_work.begin(),
+    local_work.end(), 0ul, 
+    [&]( const auto& a, const auto& task ){ return a + cost(task); } );
+  const size_t max_cost_after = allreduce( local_cost_after, MPI_MAX, comm );
+  const size_t total_sent     = allreduce( ntask_sent,       MPI_SUM, comm );
+
+  const double avg_cost = double(total_cost) / world_size;
+  auto imbalance = [=]( size_t max_cost ) {
+    return total_cost ? max_cost / avg_cost : 1.;
+  };
 
-  auto pack_en = hrt_t::now();
+  timer.add_counter( name + ".ImbalanceBefore", imbalance(max_cost_before) );
+  timer.add_counter( name + ".ImbalanceAfter",  imbalance(max_cost_after)  );
+  timer.add_counter( name + ".TasksMigrated",   total_sent                 );
+  timer.add_timing( name + ".Pack",     pack_en - pack_st         );
+  timer.add_timing( name + ".Exchange", exchange_en - exchange_st );
+  timer.add_timing( name + ".Unpack",   unpack_en - exchange_en   );
+  timer.add_timing( name,               unpack_en - rebalance_st  );
 
-  // Local task storage
-  std::vector< XCTask > local_work;
-
-  // Move local tasks to task storage
-  {
-    auto func = [=](auto a, auto b) { return a / task_avg < b+1; };
-    auto lps_begin = local_prefix_sum.begin();
-    auto lps_end   = local_prefix_sum.end();
-    auto local_begin =
-      world_rank ? std::lower_bound(lps_begin,lps_end,world_rank-1,func) : lps_begin;
-    auto local_end = std::lower_bound(local_begin, lps_end, world_rank,func);
-    size_t st_idx = std::distance(lps_begin, local_begin);
-    size_t en_idx = std::distance(lps_begin, local_end  );
-
-    size_t local_cost = 0;
-    for(size_t i = st_idx; i < en_idx; ++i) {
-      local_work.emplace_back( std::move(*(begin + i)) );
-      local_cost += cost(local_work.back());
-    }
-    printf("RANK %d LC %lu\n", world_rank, local_cost);
-  }
+  return local_work;
 
+}
 
-  // Wait on sends and receives
-  auto wait_st = hrt_t::now();
-  if(packed_req.size()) {
-    MPI_Waitall(packed_req.size(), packed_req.data(), MPI_STATUS_IGNORE);
+/** Cost functor calibrated against measured task costs
+ *
+ *  Tasks with a measured cost use it directly (ns). The static estimate of
+ *  the remaining tasks is scaled by the ratio of measured to static cost
+ *  over the measured tasks of all ranks, which reduces to the static
+ *  estimate if no task has been measured.
+ */
+template <typename StaticCost, typename MeasuredCost>
+auto calibrated_cost( const std::vector<XCTask>& tasks, 
+  const StaticCost& static_cost, const MeasuredCost& measured_cost, 
+  MPI_Comm comm ) {
+
+  // Sum of measured (ns) and static costs over the measured tasks
+  double local_sums[2] = {0., 0.};
+  for( const auto& task : tasks ) 
+  if( measured_cost(task) > 0. ) {
+    local_sums[0] += 1e9 * measured_cost(task);
+    local_sums[1] += static_cost(task);
   }
-  auto wait_en = hrt_t::now();
-
 
-  auto unpack_st  = hrt_t::now();
+  double sums[2];
+  allreduce( local_sums, sums, 2, MPI_SUM, comm );
+  const double scale = sums[1] > 0. ? sums[0] / sums[1] : 1.;
 
-  {
-
-  //std::ofstream ofile("task_recv." + std::to_string(world_rank) + ".txt");
-  auto unpack_msg = [&](auto& mpi_buffer) {
-    size_t ntask_recv = 0;
-    //if(&mpi_buffer == &packed_incoming_backward) ofile << "SRC " << world_rank - 1 << std::endl;
-    //else ofile << "SRC " << world_rank + 1 << std::endl;
-
-    mpi_buffer.unpack(ntask_recv); //ofile << ntask_recv << std::endl;
-    for(size_t i = 0; i < ntask_recv; ++i) {
-      auto& task = local_work.emplace_back();
-      mpi_buffer.unpack(task.iParent);
-      mpi_buffer.unpack(task.npts);
-      mpi_buffer.unpack(task.points);
-      mpi_buffer.unpack(task.weights);
-      mpi_buffer.unpack(task.bfn_screening.shell_list);
-      mpi_buffer.unpack(task.bfn_screening.nbe);
-      mpi_buffer.unpack(task.cou_screening.shell_list);
-      mpi_buffer.unpack(task.cou_screening.shell_pair_list);
-      mpi_buffer.unpack(task.cou_screening.shell_pair_idx_list);
-      mpi_buffer.unpack(task.cou_screening.nbe);
-      mpi_buffer.unpack(task.dist_nearest);
-      //ofile << task.iParent << ", " << task.npts << ", " << task.dist_nearest <<
-      //  ", " << task.bfn_screening.nbe << ", " << task.points.size() <<
-      //  ", " << task.cou_screening.nbe << ", " << task.cou_screening.shell_list.size() <<
-      //  ", " << task.cou_screening.shell_pair_list.size() << ", " << task.cou_screening.shell_pair_idx_list.size()
-      //  << std::endl;
-    }
+  return [=]( const auto& task ) -> size_t {
+    const double m = measured_cost(task);
+    return std::llround( m > 0. ? 1e9 * m : scale * static_cost(task) );
   };
-  #if 0
-  // Unpack
-  if(world_rank) {
-    size_t ntask_recv = 0;
-    packed_incoming.unpack(ntask_recv); 
-    for(size_t i = 0; i < ntask_recv; ++i) {
-      auto& task = local_work.emplace_back();
-      packed_incoming.unpack(task.iParent);
-      packed_incoming.unpack(task.npts);
-      packed_incoming.unpack(task.points);
-      packed_incoming.unpack(task.weights);
-      packed_incoming.unpack(task.bfn_screening.shell_list);
-      packed_incoming.unpack(task.bfn_screening.nbe);
-      packed_incoming.unpack(task.cou_screening.shell_list);
-      packed_incoming.unpack(task.cou_screening.shell_pair_list);
-      packed_incoming.unpack(task.cou_screening.shell_pair_idx_list);
-      packed_incoming.unpack(task.cou_screening.nbe);
-      packed_incoming.unpack(task.dist_nearest);
-      //ofile << task.iParent << ", " << task.npts << ", " << task.dist_nearest <<
-      //  ", " << task.bfn_screening.nbe << ", " << task.points.size() << std::endl;
-    }
-
-  }
-  #else
-  if(recv_from_backward) unpack_msg(packed_incoming_backward);
-  if(recv_from_forward ) unpack_msg(packed_incoming_forward );
-  #endif
-  }
-  auto unpack_en  = hrt_t::now();
-
-
-  MPI_Barrier(MPI_COMM_WORLD);
-  printf(
-  "RANK %d AFTER REBALNACE: PREFIX_DUR = %f PACK_DUR = %f WAIT_DUR = %f UNPACK_DUR = %f LW = %lu\n",
-    world_rank,
-    dur_t(prefix_en-prefix_st).count(),
-    dur_t(pack_en-pack_st).count(),
-    dur_t(wait_en-wait_st).count(),
-    dur_t(unpack_en-unpack_st).count(),
-    //local_work.size()
-    std::accumulate(local_work.begin(),local_work.end(),0ul,
-      [=](const auto& a, const auto& b){ return a + cost(b); })
-  );
-
-  return local_work;
 
 }
 #endif
@@ -363,28 +241,39 @@ void LoadBalancerImpl::rebalance_weights() {
   auto& tasks = get_tasks();
   const size_t natoms = molecule().natoms();
   auto cost = [=](const auto& task){ return task.cost(1,natoms); };
-  auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm());
-  tasks = std::move(new_tasks);
+  auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm(),
+    timer_, "LoadBalancer.RebalanceWeights" );
+  tasks = merge_equivalent_tasks( std::move(new_tasks) );
+  populate_submat_maps_();
+  tasks_modified_();
 #endif
 }
 
 void LoadBalancerImpl::rebalance_exc_vxc() {
 #ifdef GAUXC_ENABLE_MPI
   auto& tasks = get_tasks();
-  const size_t natoms = molecule().natoms();
-  auto cost = [=](const auto& task){ return task.cost_exc_vxc(1); };
-  auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm());
-  tasks = std::move(new_tasks);
+  auto cost = calibrated_cost( tasks,
+    [](const auto& task){ return task.cost_exc_vxc(1); },
+    [](const auto& task){ return task.measured_cost.exc_vxc; }, runtime_.comm() );
+  auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm(),
+    timer_, "LoadBalancer.RebalanceEXC_VXC" );
+  tasks = merge_equivalent_tasks( std::move(new_tasks) );
+  populate_submat_maps_();
+  tasks_modified_();
 #endif
 }
 
 void LoadBalancerImpl::rebalance_exx() {
 #ifdef GAUXC_ENABLE_MPI
   auto& tasks = get_tasks();
-  auto cost = [=](const auto& task){ return task.cost_exx(); };
-  auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm());
-  local_tasks_ = std::move(new_tasks);
-  MPI_Barrier(MPI_COMM_WORLD);
+  auto cost = calibrated_cost( tasks,
+    [](const auto& task){ return task.cost_exx(); },
+    [](const auto& task){ return task.measured_cost.exx; }, runtime_.comm() );
+  auto new_tasks = rebalance( tasks.begin(), tasks.end(), cost, runtime_.comm(),
+    timer_, "LoadBalancer.RebalanceEXX" );
+  local_tasks_ = merge_equivalent_tasks( std::move(new_tasks), true );
+  populate_submat_maps_();
+  tasks_modified_();
 #endif
 }
 
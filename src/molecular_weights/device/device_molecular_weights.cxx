@@ -79,7 +79,12 @@ void DeviceMolecularWeights::modify_weights( LoadBalancer& lb ) const {
   rt.device_backend()->master_queue_synchronize();
  
   lb.state().modified_weights_are_stored = true;
+  lb.state().weight_alg = XCWeightAlg::SSF;
 
 }
 
+void DeviceMolecularWeights::update_weights( LoadBalancer& ) const {
+  GAUXC_GENERIC_EXCEPTION("Incremental Weight Updates NYI for Device Integration");
+}
+
 }
@@ -23,6 +23,7 @@ public:
     MolecularWeightsImpl(std::forward<Args>(args)...) {}
 
   void modify_weights(LoadBalancer&) const final;
+  void update_weights(LoadBalancer&) const final;
 
 };
 
@@ -7,33 +7,135 @@
  */
 #include "host_molecular_weights.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host/reference/ssf_task_screening.hpp"
 
 namespace GauXC::detail {
 
 void HostMolecularWeights::modify_weights( LoadBalancer& lb ) const {
 
+  // (Possibly) Generate tasks. This has to precede the check, as task
+  // generation with fused partition weights stores modified weights
+  auto& tasks = lb.get_tasks();
+
   if(lb.state().modified_weights_are_stored)
     GAUXC_GENERIC_EXCEPTION("Attempting to Overwrite Modified Weights");
 
   // Cast LWD to LocalHostWorkDriver
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
 
-  // (Possibly) Generate tasks
-  auto& tasks = lb.get_tasks();
-
   // Sort tasks on size (XXX: maybe doesnt matter?)
   auto task_comparator = []( const XCTask& a, const XCTask& b ) {
     return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
   };
   std::sort( tasks.begin(), tasks.end(), task_comparator );
 
-  // Modify the weights
+  // Keep the raw quadrature weights for subsequent incremental updates
   const auto& mol  = lb.molecule();
+  if( this->settings_.incremental ) {
+    for( auto& task : tasks ) task.unpartitioned_weights = task.weights;
+    lb.state().weights_geometry = mol;
+  }
+
+  // Modify the weights
   const auto& meta = lb.molmeta();
   lwd->partition_weights( this->settings_.weight_alg, mol, meta, 
     tasks.begin(), tasks.end() );
 
   lb.state().modified_weights_are_stored = true;
+  lb.state().weight_alg = this->settings_.weight_alg;
+}
+
+void HostMolecularWeights::update_weights( LoadBalancer& lb ) const {
+
+  if(not lb.state().modified_weights_are_stored) {
+    modify_weights(lb);
+    return;
+  }
+  if(not this->settings_.incremental)
+    GAUXC_GENERIC_EXCEPTION("Incremental Weight Updates Require Unpartitioned Weights");
+  if(lb.state().weight_alg != this->settings_.weight_alg)
+    GAUXC_GENERIC_EXCEPTION("Weight Update Inconsistent with Stored Partitioning Scheme");
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  auto& tasks = lb.get_tasks();
+  const size_t ntasks = tasks.size();
+  for( const auto& task : tasks )
+  if( task.unpartitioned_weights.size() != task.weights.size() )
+    GAUXC_GENERIC_EXCEPTION("Task is Missing Unpartitioned Weights");
+
+  const auto& mol      = lb.molecule();
+  const auto& meta     = lb.molmeta();
+  auto&       ref_mol  = lb.state().weights_geometry;
+  const size_t natoms  = mol.natoms();
+  if( ref_mol.natoms() != natoms )
+    GAUXC_GENERIC_EXCEPTION("Weights Geometry Inconsistent with LoadBalancer");
+
+  // Atoms displaced beyond tolerance since the last weight update
+  std::vector<char> moved( natoms, 0 );
+  bool any_moved = false;
+  for( size_t iA = 0; iA < natoms; ++iA ) {
+    const double dx = mol[iA].x - ref_mol[iA].x;
+    const double dy = mol[iA].y - ref_mol[iA].y;
+    const double dz = mol[iA].z - ref_mol[iA].z;
+    moved[iA] = std::sqrt(dx*dx + dy*dy + dz*dz) > this->settings_.displacement_tol;
+    any_moved = any_moved or moved[iA];
+  }
+  if( not any_moved ) return;
+
+  // Determine the affected tasks. For SSF, a task is unaffected if neither
+  // its parent nor any atom which contributes to its partition function
+  // (before or after the displacement) moved. Other schemes are global
+  std::vector<char> affected( ntasks, 1 );
+  if( this->settings_.weight_alg == XCWeightAlg::SSF ) {
+
+    const MolMeta      ref_meta( ref_mol );
+    const AtomCellList ref_cell_list( ref_mol );
+    const AtomCellList cell_list( mol );
+
+    #pragma omp parallel
+    {
+
+    SSFTaskScreening     ref_screen_task( ref_cell_list, ref_meta );
+    SSFTaskScreening     screen_task( cell_list, meta );
+    std::vector<int32_t> task_atoms;
+
+    auto contains_moved = [&]( auto& screen, const XCTask& task ) {
+      return screen( task, task_atoms ) and 
+        std::any_of( task_atoms.begin(), task_atoms.end(),
+          [&]( auto iA ){ return moved[iA]; } );
+    };
+
+    #pragma omp for schedule(dynamic)
+    for( size_t iT = 0; iT < ntasks; ++iT ) {
+      const auto& task = tasks[iT];
+      const auto  iP   = task.iParent;
+      affected[iT] = moved[iP] or
+        ref_meta.dist_nearest()[iP] != meta.dist_nearest()[iP] or
+        contains_moved( ref_screen_task, task ) or
+        contains_moved( screen_task, task );
+    }
+
+    } // OMP context
+
+  }
+
+  // Move the affected tasks to the front and recompute their weights
+  size_t naffected = 0;
+  for( size_t iT = 0; iT < ntasks; ++iT )
+  if( affected[iT] ) std::swap( tasks[iT], tasks[naffected++] );
+
+  for( size_t iT = 0; iT < naffected; ++iT )
+    tasks[iT].weights = tasks[iT].unpartitioned_weights;
+  lwd->partition_weights( this->settings_.weight_alg, mol, meta, 
+    tasks.begin(), tasks.begin() + naffected );
+
+  // Atoms within tolerance keep their reference position such that
+  // displacements accumulate across updates
+  for( size_t iA = 0; iA < natoms; ++iA )
+  if( moved[iA] ) ref_mol[iA] = mol[iA];
+
 }
 
 }
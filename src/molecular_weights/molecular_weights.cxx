@@ -26,6 +26,12 @@ void MolecularWeights::modify_weights(load_balancer_reference lb) const {
   timer.time_op("MolecularWeights",[&](){ pimpl_->modify_weights(lb);});
 }
 
+void MolecularWeights::update_weights(load_balancer_reference lb) const {
+  if(not pimpl_) GAUXC_PIMPL_NOT_INITIALIZED();
+  auto& timer = pimpl_->get_timer();
+  timer.time_op("MolecularWeights.Update",[&](){ pimpl_->update_weights(lb);});
+}
+
 const util::Timer& MolecularWeights::get_timings() const {
   if(not pimpl_) GAUXC_PIMPL_NOT_INITIALIZED();
   return pimpl_->get_timings();
@@ -32,6 +32,7 @@ public:
     settings_(settings) {}
 
   virtual void modify_weights(LoadBalancer&) const = 0;
+  virtual void update_weights(LoadBalancer&) const = 0;
   inline const util::Timer& get_timings() const {
     return timer_;
   };
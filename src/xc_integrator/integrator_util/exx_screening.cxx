@@ -29,6 +29,7 @@ void exx_ek_screening(
   const BasisSet<double>& basis, const BasisSetMap& basis_map,
   const double* P_abs, size_t ldp, const double* V_shell_max, size_t ldv,
   double eps_E, double eps_K, LocalHostWorkDriver* lwd, 
+  const XCHostDataMaxima& host_max,
   exx_detail::host_task_iterator task_begin,
   exx_detail::host_task_iterator task_end ) {
 
@@ -48,7 +49,7 @@ void exx_ek_screening(
   //auto coll_st = hrt_t::now();
   #pragma omp parallel
   { // Scope temp mem
-  std::vector<double> basis_eval;
+  XCHostData<double> host_data( host_max, 1, 0, 0 ); // Only the collocation is needed
   std::vector<double> bfn_max_grid(nbf);
 
   #pragma omp for schedule(dynamic)
@@ -69,12 +70,13 @@ void exx_ek_screening(
       basis.nbf_subset( shell_list_bfn_.begin(), shell_list_bfn_.end() );
 
     // Resize scratch
-    basis_eval.resize( nbe_bfn * npts );
+    host_data.basis_eval.resize( nbe_bfn * npts );
+    const auto* basis_eval = host_data.basis_eval.data();
 
 
     // Evaluate basis functions
     lwd->eval_collocation( npts, nshells_bfn, nbe_bfn, points, basis,
-      shell_list_bfn, basis_eval.data() );
+      shell_list_bfn, host_data.basis_eval.data() );
 
     // Compute max bfn sum
     // MBFS = max_i sqrt(W[i]) * \sum_mu B(mu,i)
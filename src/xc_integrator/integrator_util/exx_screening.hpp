@@ -8,6 +8,7 @@
 #pragma once
 #include <gauxc/xc_task.hpp>
 #include <host/local_host_work_driver.hpp>
+#include "replicated/host/xc_host_data.hpp"
 #ifdef GAUXC_ENABLE_DEVICE
 #include <device/local_device_work_driver.hpp>
 #endif
@@ -22,6 +23,7 @@ void exx_ek_screening(
   const BasisSet<double>& basis, const BasisSetMap& basis_map,
   const double* P_abs, size_t ldp, const double* V_shell_max, size_t ldv,
   double eps_E, double eps_K, LocalHostWorkDriver* lwd, 
+  const XCHostDataMaxima& host_max,
   exx_detail::host_task_iterator task_begin,
   exx_detail::host_task_iterator task_end );
 
@@ -0,0 +1,38 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <chrono>
+
+namespace GauXC {
+
+/** Records the wall time of a scope (e.g. the evaluation of a task)
+ *
+ *  The elapsed time (s) is written to the referenced cost upon destruction,
+ *  i.e. also on early exit from the scope.
+ */
+class TaskCostRecorder {
+
+  using clock_type = std::chrono::steady_clock;
+
+  double&                cost_;
+  clock_type::time_point st_;
+
+public:
+
+  TaskCostRecorder( double& cost ) : cost_(cost), st_(clock_type::now()) { }
+
+  TaskCostRecorder( const TaskCostRecorder& )            = delete;
+  TaskCostRecorder& operator=( const TaskCostRecorder& ) = delete;
+
+  ~TaskCostRecorder() noexcept {
+    cost_ = std::chrono::duration<double>( clock_type::now() - st_ ).count();
+  }
+
+};
+
+}
@@ -0,0 +1,158 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "task_merge.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace GauXC {
+
+namespace {
+
+/// splitmix64 finalizer
+inline uint64_t mix64( uint64_t x ) {
+  x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27; x *= 0x94d049bb133111ebull;
+  x ^= x >> 31; return x;
+}
+
+inline void hash_combine( uint64_t& h, uint64_t v ) {
+  h = mix64( h ^ (v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2)) );
+}
+
+inline uint64_t pack( int32_t a, int32_t b ) {
+  return (uint64_t(uint32_t(a)) << 32) | uint64_t(uint32_t(b));
+}
+
+void hash_screening( uint64_t& h, const XCTask::screening_data& s ) {
+
+  const auto& sl = s.shell_list;
+  hash_combine( h, sl.size() );
+  size_t i = 0;
+  for( ; i + 1 < sl.size(); i += 2 ) hash_combine( h, pack(sl[i], sl[i+1]) );
+  if( i < sl.size() ) hash_combine( h, pack(sl[i], -1) );
+
+  hash_combine( h, s.shell_pair_list.size() );
+  for( const auto& [a,b] : s.shell_pair_list ) hash_combine( h, pack(a,b) );
+
+}
+
+}
+
+uint64_t task_fingerprint( const XCTask& task, bool include_cou ) {
+  uint64_t h = mix64( uint64_t(uint32_t(task.iParent)) );
+  hash_screening( h, task.bfn_screening );
+  if( include_cou ) hash_screening( h, task.cou_screening );
+  return h;
+}
+
+std::vector<XCTask> merge_equivalent_tasks( std::vector<XCTask>&& tasks,
+  bool include_cou, std::vector<size_t>* group_ptr, 
+  std::vector<size_t>* group_members ) {
+
+  const size_t ntasks = tasks.size();
+  auto task_equiv = [=]( const XCTask& a, const XCTask& b ) {
+    return a.equiv_with(b) and 
+      (not include_cou or a.cou_screening.equiv_with(b.cou_screening));
+  };
+
+  // Fingerprints (dominant cost for long shell lists)
+  std::vector< std::pair<uint64_t,size_t> > keys( ntasks );
+  #pragma omp parallel for schedule(dynamic, 64)
+  for( size_t i = 0; i < ntasks; ++i )
+    keys[i] = { task_fingerprint( tasks[i], include_cou ), i };
+
+  // Group tasks with equal fingerprints. Integer keys are sorted instead of
+  // populating a hash map, which keeps the grouping deterministic
+  std::sort( keys.begin(), keys.end() );
+
+  std::vector<size_t> group_of( ntasks ), group_first;
+  for( size_t st = 0; st < ntasks; ) {
+
+    size_t en = st + 1;
+    while( en < ntasks and keys[en].first == keys[st].first ) ++en;
+
+    // Resolve fingerprint collisions
+    const size_t group_st = group_first.size();
+    for( size_t k = st; k < en; ++k ) {
+      const auto i = keys[k].second;
+      size_t g = group_st;
+      while( g < group_first.size() and 
+        not task_equiv( tasks[group_first[g]], tasks[i] ) ) ++g;
+      if( g == group_first.size() ) group_first.push_back( i );
+      group_of[i] = g;
+    }
+
+    st = en;
+  }
+
+  // Order groups by first appearance
+  const size_t ngroups = group_first.size();
+  std::vector<size_t> group_order( ngroups ), group_rank( ngroups );
+  std::iota( group_order.begin(), group_order.end(), 0 );
+  std::sort( group_order.begin(), group_order.end(), 
+    [&]( auto a, auto b ){ return group_first[a] < group_first[b]; } );
+  for( size_t g = 0; g < ngroups; ++g ) group_rank[group_order[g]] = g;
+
+  // Group members (CSR), in input order
+  std::vector<size_t> member_st( ngroups + 1, 0 ), members( ntasks );
+  for( size_t i = 0; i < ntasks; ++i ) member_st[ group_rank[group_of[i]] + 1 ]++;
+  for( size_t g = 0; g < ngroups; ++g ) member_st[g+1] += member_st[g];
+  {
+  std::vector<size_t> fill( member_st.begin(), member_st.end() - 1 );
+  for( size_t i = 0; i < ntasks; ++i ) 
+    members[ fill[group_rank[group_of[i]]]++ ] = i;
+  }
+
+  // Move point blocks into presized buffers
+  std::vector<XCTask> merged( ngroups );
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t g = 0; g < ngroups; ++g ) {
+
+    const auto m_st = members.begin() + member_st[g];
+    const auto m_en = members.begin() + member_st[g+1];
+
+    size_t npts = 0;
+    bool keep_unpartitioned = true;
+    for( auto it = m_st; it != m_en; ++it ) {
+      const auto& t = tasks[*it];
+      npts += t.points.size();
+      keep_unpartitioned = keep_unpartitioned and 
+        t.unpartitioned_weights.size() == t.points.size();
+    }
+
+    auto& task = merged[g];
+    task = std::move( tasks[*m_st] );
+    task.points.reserve( npts );
+    task.weights.reserve( npts );
+    if( keep_unpartitioned ) task.unpartitioned_weights.reserve( npts );
+    else                     task.unpartitioned_weights.clear();
+
+    for( auto it = m_st + 1; it != m_en; ++it ) {
+      const auto& t = tasks[*it];
+      task.points.insert( task.points.end(), t.points.begin(), t.points.end() );
+      task.weights.insert( task.weights.end(), t.weights.begin(), 
+        t.weights.end() );
+      if( keep_unpartitioned ) 
+        task.unpartitioned_weights.insert( task.unpartitioned_weights.end(),
+          t.unpartitioned_weights.begin(), t.unpartitioned_weights.end() );
+      task.measured_cost.exc_vxc += t.measured_cost.exc_vxc;
+      task.measured_cost.exx     += t.measured_cost.exx;
+    }
+    task.npts = task.points.size();
+
+  }
+
+  tasks.clear();
+  if( group_ptr     ) *group_ptr     = std::move( member_st );
+  if( group_members ) *group_members = std::move( members   );
+  return merged;
+
+}
+
+}
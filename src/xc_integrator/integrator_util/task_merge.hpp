@@ -0,0 +1,40 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/xc_task.hpp>
+
+namespace GauXC {
+
+/** 64-bit fingerprint of the data which determines task equivalence
+ *
+ *  Hashes iParent and the bfn shell (pair) lists, and optionally the
+ *  coulomb shell (pair) lists. Equivalent tasks have equal fingerprints.
+ */
+uint64_t task_fingerprint( const XCTask& task, bool include_cou );
+
+/** Merge equivalent quadrature tasks
+ *
+ *  Tasks are equivalent if they share iParent and bfn screening data (and
+ *  coulomb screening data if include_cou is set). Tasks are grouped by
+ *  their fingerprint (collisions are resolved by full comparison) and the
+ *  points of each group are moved into presized buffers, preserving the
+ *  order of the input tasks.
+ *
+ *  @param[in]  tasks       Tasks to merge (consumed)
+ *  @param[in]  include_cou Whether the coulomb screening data is considered
+ *  @param[out] group_ptr   (Optional) CSR offsets of the groups into
+ *                          group_members (number of merged tasks + 1)
+ *  @param[out] group_members (Optional) Input indices of the tasks merged
+ *                          into each merged task, in input order
+ *  @returns    Merged tasks, in order of the first appearance of each group
+ */
+std::vector<XCTask> merge_equivalent_tasks( std::vector<XCTask>&& tasks,
+  bool include_cou = false, std::vector<size_t>* group_ptr = nullptr,
+  std::vector<size_t>* group_members = nullptr );
+
+}
@@ -7,6 +7,8 @@
  */
 #include <gauxc/xc_integrator/local_work_driver.hpp>
 #include "host/reference_local_host_work_driver.hpp"
+#include "host/fused_local_host_work_driver.hpp"
+#include "host/native_local_host_work_driver.hpp"
 #ifdef GAUXC_ENABLE_DEVICE
 #include "device/cuda/cuda_aos_scheme1.hpp"
 #include "device/hip/hip_aos_scheme1.hpp"
@@ -19,20 +21,33 @@ LocalWorkDriverFactory::ptr_return_t
     std::string name, LocalWorkSettings settings ) {
 
   std::transform( name.begin(), name.end(), name.begin(), ::toupper );
-  (void)(settings);
 
   switch(ex) {
 
   case ExecutionSpace::Host:
+  {
     if( name == "DEFAULT" ) name = "REFERENCE";
 
+    std::unique_ptr<LocalHostWorkDriver> lwd;
     if( name == "REFERENCE" )
-      return std::make_unique<LocalHostWorkDriver>(
+      lwd = std::make_unique<LocalHostWorkDriver>(
         std::make_unique<ReferenceLocalHostWorkDriver>()
       );
+    else if( name == "FUSED" )
+      lwd = std::make_unique<LocalHostWorkDriver>(
+        std::make_unique<FusedLocalHostWorkDriver>()
+      );
+    else if( name == "NATIVE" )
+      lwd = std::make_unique<LocalHostWorkDriver>(
+        std::make_unique<NativeLocalHostWorkDriver>()
+      );
     else
       GAUXC_GENERIC_EXCEPTION("LWD Not Recognized: " + name);
 
+    lwd->enable_mixed_precision( settings.mixed_precision );
+    return lwd;
+  }
+
   case ExecutionSpace::Device:
     if( name == "DEFAULT" ) name = "SCHEME1";
 
@@ -0,0 +1,141 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/fused_local_host_work_driver.hpp"
+#include "host/reference/collocation.hpp"
+#include "host/util.hpp"
+#include "host/blas.hpp"
+#include <algorithm>
+
+namespace GauXC {
+
+  FusedLocalHostWorkDriver::FusedLocalHostWorkDriver( size_t block_bytes ) :
+    ReferenceLocalHostWorkDriver(), block_bytes_(block_bytes) { }
+
+  FusedLocalHostWorkDriver::~FusedLocalHostWorkDriver() noexcept = default;
+
+  size_t FusedLocalHostWorkDriver::block_npts( size_t nbe, size_t nvec ) const {
+    // Keep blocks a multiple of 8 points, and never smaller than 8
+    const size_t bytes_per_pt = std::max( nbe * nvec * sizeof(double), 1ul );
+    const size_t npts_blk     = block_bytes_ / bytes_per_pt;
+    return std::max( 8ul, npts_blk - (npts_blk % 8) );
+  }
+
+  namespace {
+
+    // Select the (packed) density block used for X = P * B
+    const double* pack_density( size_t nbf, size_t nbe, 
+      const FusedLocalHostWorkDriver::submat_map_t& submat_map,
+      const double* P, size_t ldp, double* scr, size_t& ldp_use ) {
+
+      if( submat_map.size() > 1 ) {
+        detail::submat_set( nbf, nbf, nbe, nbe, P, ldp, scr, nbe, submat_map );
+        ldp_use = nbe;
+        return scr;
+      } 
+
+      ldp_use = ldp;
+      return (nbe != nbf) ? P + submat_map[0][0]*(ldp+1) : P;
+
+    }
+
+  }
+
+  // Fused Collocation + X + U/V variables LDA
+  void FusedLocalHostWorkDriver::eval_collocation_uvvar_lda( size_t npts, 
+    size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, size_t nbf, const submat_map_t& submat_map, 
+    const double* P, size_t ldp, double* basis_eval, double* X, size_t ldx, 
+    double* den_eval, double* scr ) {
+
+    // Pack P once for all blocks
+    size_t ldp_use;
+    const auto* P_use = pack_density( nbf, nbe, submat_map, P, ldp, scr, ldp_use );
+
+    const size_t nb = block_npts( nbe, 2 );
+    for( size_t ist = 0; ist < npts; ist += nb ) {
+
+      const size_t npts_blk = std::min( nb, npts - ist );
+      auto* B_blk = basis_eval + ist * nbe;
+      auto* X_blk = X + ist * ldx;
+
+      gau2grid_collocation( npts_blk, nshells, nbe, pts + 3*ist, basis, 
+        shell_list, B_blk );
+
+      blas::gemm( 'N', 'N', nbe, npts_blk, nbe, 2., P_use, ldp_use, B_blk, nbe,
+        0., X_blk, ldx );
+
+      for( size_t i = 0; i < npts_blk; ++i ) 
+        den_eval[ist + i] = blas::dot( nbe, B_blk + i*nbe, 1, X_blk + i*ldx, 1 );
+
+    }
+
+  }
+
+  // Fused Collocation Gradient + X + U/V variables GGA
+  void FusedLocalHostWorkDriver::eval_collocation_uvvar_gga( size_t npts, 
+    size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, size_t nbf, const submat_map_t& submat_map, 
+    const double* P, size_t ldp, double* basis_eval, double* dbasis_x_eval, 
+    double* dbasis_y_eval, double* dbasis_z_eval, double* X, size_t ldx, 
+    double* den_eval, double* dden_x_eval, double* dden_y_eval, 
+    double* dden_z_eval, double* gamma, double* scr ) {
+
+    // Pack P once for all blocks
+    size_t ldp_use;
+    const auto* P_use = pack_density( nbf, nbe, submat_map, P, ldp, scr, ldp_use );
+
+    const size_t nb = block_npts( nbe, 5 );
+    for( size_t ist = 0; ist < npts; ist += nb ) {
+
+      const size_t npts_blk = std::min( nb, npts - ist );
+      const size_t boff     = ist * nbe;
+      auto* B_blk  = basis_eval    + boff;
+      auto* Bx_blk = dbasis_x_eval + boff;
+      auto* By_blk = dbasis_y_eval + boff;
+      auto* Bz_blk = dbasis_z_eval + boff;
+      auto* X_blk  = X + ist * ldx;
+
+      gau2grid_collocation_gradient( npts_blk, nshells, nbe, pts + 3*ist, basis,
+        shell_list, B_blk, Bx_blk, By_blk, Bz_blk );
+
+      blas::gemm( 'N', 'N', nbe, npts_blk, nbe, 2., P_use, ldp_use, B_blk, nbe,
+        0., X_blk, ldx );
+
+      // Single sweep over X(:,i) for rho and grad rho
+      for( size_t i = 0; i < npts_blk; ++i ) {
+
+        const auto* X_i  = X_blk  + i * ldx;
+        const auto* B_i  = B_blk  + i * nbe;
+        const auto* Bx_i = Bx_blk + i * nbe;
+        const auto* By_i = By_blk + i * nbe;
+        const auto* Bz_i = Bz_blk + i * nbe;
+
+        double rho = 0., dx = 0., dy = 0., dz = 0.;
+        for( size_t mu = 0; mu < nbe; ++mu ) {
+          const auto x = X_i[mu];
+          rho += B_i[mu]  * x;
+          dx  += Bx_i[mu] * x;
+          dy  += By_i[mu] * x;
+          dz  += Bz_i[mu] * x;
+        }
+
+        dx *= 2.; dy *= 2.; dz *= 2.;
+
+        den_eval   [ist + i] = rho;
+        dden_x_eval[ist + i] = dx;
+        dden_y_eval[ist + i] = dy;
+        dden_z_eval[ist + i] = dz;
+        gamma      [ist + i] = dx*dx + dy*dy + dz*dz;
+
+      }
+
+    }
+
+  }
+
+}
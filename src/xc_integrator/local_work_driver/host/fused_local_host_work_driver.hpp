@@ -0,0 +1,57 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "host/reference_local_host_work_driver.hpp"
+
+namespace GauXC {
+
+/** Host LWD which fuses collocation, X = P * B and the U/V variables
+ *
+ *  Points are processed in blocks sized such that the collocation
+ *  (+ gradient) and X blocks remain resident in cache between the
+ *  three stages. All other kernels are inherited from the reference
+ *  implementation.
+ */
+struct FusedLocalHostWorkDriver : public ReferenceLocalHostWorkDriver {
+
+  using submat_map_t   = ReferenceLocalHostWorkDriver::submat_map_t;
+
+  /// Default working set per block of points (bytes)
+  static constexpr size_t default_block_bytes = 256 * 1024;
+
+  FusedLocalHostWorkDriver( size_t block_bytes = default_block_bytes );
+
+  virtual ~FusedLocalHostWorkDriver() noexcept;
+
+  FusedLocalHostWorkDriver( const FusedLocalHostWorkDriver& )     = delete;
+  FusedLocalHostWorkDriver( FusedLocalHostWorkDriver&& ) noexcept = delete;
+
+  void eval_collocation_uvvar_lda( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    size_t nbf, const submat_map_t& submat_map, const double* P, size_t ldp,
+    double* basis_eval, double* X, size_t ldx, double* den_eval, 
+    double* scr ) override;
+  void eval_collocation_uvvar_gga( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    size_t nbf, const submat_map_t& submat_map, const double* P, size_t ldp,
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* X, size_t ldx, double* den_eval, 
+    double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, 
+    double* gamma, double* scr ) override;
+
+private:
+
+  size_t block_bytes_;
+
+  /// Number of points per block given nbe and the number of nbe-sized 
+  /// quantities stored per point
+  size_t block_npts( size_t nbe, size_t nvec ) const;
+
+};
+
+}
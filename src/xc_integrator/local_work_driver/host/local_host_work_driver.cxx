@@ -24,6 +24,39 @@ LocalHostWorkDriver::LocalHostWorkDriver( LocalHostWorkDriver&& other ) noexcept
   if(not ptr) GAUXC_PIMPL_NOT_INITIALIZED()
 
 
+// Mixed precision
+bool LocalHostWorkDriver::mixed_precision_enabled() const {
+  throw_if_invalid_pimpl(pimpl_);
+  return pimpl_->mixed_precision_enabled();
+}
+
+void LocalHostWorkDriver::enable_mixed_precision( bool mp ) {
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->enable_mixed_precision(mp);
+}
+
+bool LocalHostWorkDriver::mixed_precision() const {
+  throw_if_invalid_pimpl(pimpl_);
+  return pimpl_->mixed_precision();
+}
+
+void LocalHostWorkDriver::set_mixed_precision( bool mp ) {
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->set_mixed_precision(mp);
+}
+
+void LocalHostWorkDriver::register_single_precision_basis( size_t npts, 
+  size_t nbe, const double* basis_eval ) {
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->register_single_precision_basis(npts, nbe, basis_eval);
+}
+
+void LocalHostWorkDriver::release_single_precision_basis() {
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->release_single_precision_basis();
+}
+
+
 
 
 
@@ -37,6 +70,17 @@ void LocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg,
 
 }
 
+// Partition weight gradient
+void LocalHostWorkDriver::eval_weight_gradient( XCWeightAlg weight_alg, 
+  const Molecule& mol, const MolMeta& meta, task_iterator task_begin, 
+  task_iterator task_end, const double* f, double* grad ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_weight_gradient(weight_alg, mol, meta, task_begin, task_end, 
+    f, grad);
+
+}
+
 
 // Collocation
 void LocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, size_t nbe, 
@@ -89,6 +133,17 @@ void LocalHostWorkDriver::eval_xmat( size_t npts, size_t nbf, size_t nbe,
 
 }
 
+void LocalHostWorkDriver::eval_xmat_batched( size_t ndm, size_t npts, 
+  size_t nbf, size_t nbe, const submat_map_t& submat_map, 
+  const double* const* P, size_t ldp, const double* basis_eval, size_t ldb, 
+  double* X, size_t ldx, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_xmat_batched(ndm, npts, nbf, nbe, submat_map, P, ldp, 
+    basis_eval, ldb, X, ldx, scr);
+
+}
+
 
 void LocalHostWorkDriver::eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
   size_t nbe_ket, const submat_map_t& submat_map_bra,
@@ -153,6 +208,32 @@ void LocalHostWorkDriver::eval_uvvar_gga( size_t npts, size_t nbe,
 
 }
 
+// U/VVar LDA UKS (spin densities)
+void LocalHostWorkDriver::eval_uvvar_lda_uks( size_t npts, size_t nbe, 
+  const double* basis_eval, const double* Xa, size_t ldxa, const double* Xb, 
+  size_t ldxb, double* den_eval ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_uvvar_lda_uks(npts, nbe, basis_eval, Xa, ldxa, Xb, ldxb, 
+    den_eval);
+
+}
+
+// U/VVar GGA UKS (spin densities + grad, gamma)
+void LocalHostWorkDriver::eval_uvvar_gga_uks( size_t npts, size_t nbe, 
+  const double* basis_eval, const double* dbasis_x_eval, 
+  const double *dbasis_y_eval, const double* dbasis_z_eval, const double* Xa, 
+  size_t ldxa, const double* Xb, size_t ldxb, double* den_eval, 
+  double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, 
+  double* gamma ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_uvvar_gga_uks(npts, nbe, basis_eval, dbasis_x_eval, 
+    dbasis_y_eval, dbasis_z_eval, Xa, ldxa, Xb, ldxb, den_eval, dden_x_eval, 
+    dden_y_eval, dden_z_eval, gamma);
+
+}
+
 // Eval Z Matrix LDA VXC
 void LocalHostWorkDriver::eval_zmat_lda_vxc( size_t npts, size_t nbe, 
   const double* vrho, const double* basis_eval, double* Z, size_t ldz ) {
@@ -177,6 +258,89 @@ void LocalHostWorkDriver::eval_zmat_gga_vxc( size_t npts, size_t nbe,
 }
 
 
+// Eval Z Matrices LDA VXC UKS
+void LocalHostWorkDriver::eval_zmat_lda_vxc_uks( size_t npts, size_t nbe, 
+  const double* vrho, const double* basis_eval, double* Za, size_t ldza,
+  double* Zb, size_t ldzb ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_zmat_lda_vxc_uks(npts, nbe, vrho, basis_eval, Za, ldza, Zb, ldzb);
+
+}
+
+// Eval Z Matrices GGA VXC UKS
+void LocalHostWorkDriver::eval_zmat_gga_vxc_uks( size_t npts, size_t nbe, 
+  const double* vrho, const double* vgamma, const double* basis_eval, 
+  const double* dbasis_x_eval, const double* dbasis_y_eval, 
+  const double* dbasis_z_eval, const double* dden_x_eval, 
+  const double* dden_y_eval, const double* dden_z_eval, double* Za, size_t ldza,
+  double* Zb, size_t ldzb ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_zmat_gga_vxc_uks(npts, nbe, vrho, vgamma, basis_eval, 
+    dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval, 
+    dden_z_eval, Za, ldza, Zb, ldzb);
+
+}
+
+// Eval Z Matrix LDA FXC
+void LocalHostWorkDriver::eval_zmat_lda_fxc( size_t npts, size_t nbe, 
+  const double* v2rho2, const double* basis_eval, const double* den1_eval,
+  double* Z, size_t ldz ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_zmat_lda_fxc(npts, nbe, v2rho2, basis_eval, den1_eval, Z, ldz);
+
+}
+
+// Eval Z Matrix GGA FXC
+void LocalHostWorkDriver::eval_zmat_gga_fxc( size_t npts, size_t nbe, 
+  const double* vgamma, const double* v2rho2, const double* v2rhogamma, 
+  const double* v2gamma2, const double* basis_eval, const double* dbasis_x_eval,
+  const double* dbasis_y_eval, const double* dbasis_z_eval, 
+  const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+  const double* den1_eval, const double* dden1_x_eval, const double* dden1_y_eval,
+  const double* dden1_z_eval, double* Z, size_t ldz ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_zmat_gga_fxc(npts, nbe, vgamma, v2rho2, v2rhogamma, v2gamma2,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, dden_x_eval,
+    dden_y_eval, dden_z_eval, den1_eval, dden1_x_eval, dden1_y_eval, 
+    dden1_z_eval, Z, ldz);
+
+}
+
+
+// Fused Collocation + X + U/V variables LDA
+void LocalHostWorkDriver::eval_collocation_uvvar_lda( size_t npts, 
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, size_t nbf, const submat_map_t& submat_map, 
+  const double* P, size_t ldp, double* basis_eval, double* X, size_t ldx, 
+  double* den_eval, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_uvvar_lda(npts, nshells, nbe, pts, basis, shell_list,
+    nbf, submat_map, P, ldp, basis_eval, X, ldx, den_eval, scr);
+
+}
+
+// Fused Collocation Gradient + X + U/V variables GGA
+void LocalHostWorkDriver::eval_collocation_uvvar_gga( size_t npts, 
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, size_t nbf, const submat_map_t& submat_map, 
+  const double* P, size_t ldp, double* basis_eval, double* dbasis_x_eval, 
+  double* dbasis_y_eval, double* dbasis_z_eval, double* X, size_t ldx, 
+  double* den_eval, double* dden_x_eval, double* dden_y_eval, 
+  double* dden_z_eval, double* gamma, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_uvvar_gga(npts, nshells, nbe, pts, basis, shell_list,
+    nbf, submat_map, P, ldp, basis_eval, dbasis_x_eval, dbasis_y_eval, 
+    dbasis_z_eval, X, ldx, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
+    gamma, scr);
+
+}
+
 // Increment VXC by Z
 void LocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe, 
   const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
@@ -188,6 +352,17 @@ void LocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe,
 
 }
 
+// Increment a batch of VXC by stacked Z
+void LocalHostWorkDriver::inc_vxc_batched( size_t ndm, size_t npts, size_t nbf,
+  size_t nbe, const double* basis_eval, const submat_map_t& submat_map, 
+  const double* Z, size_t ldz, double* const* VXC, size_t ldvxc, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->inc_vxc_batched(ndm, npts, nbf, nbe, basis_eval, submat_map, Z, ldz,
+    VXC, ldvxc, scr);
+
+}
+
 
 
 }
@@ -56,6 +56,50 @@ public:
 
   // Public APIs
 
+  /** Whether the LWD was constructed with mixed precision enabled
+   *  (LocalWorkSettings::mixed_precision). This does not change the
+   *  precision of any kernel, the integrator activates mixed precision
+   *  (see MixedPrecisionGuard) only for the EXC / VXC evaluations which
+   *  support it.
+   */
+  bool mixed_precision_enabled() const;
+
+  /** Enable / disable mixed precision for this LWD
+   *
+   *  @param[in] mp Whether mixed precision may be activated
+   */
+  void enable_mixed_precision( bool mp );
+
+  /** Whether the X / Z GEMMs (`eval_xmat*`, `inc_vxc*`) are currently
+   *  performed on single precision copies of their operands. Results are
+   *  always returned (and accumulated) in double precision.
+   */
+  bool mixed_precision() const;
+
+  /** Activate / deactivate mixed precision X / Z GEMMs
+   *
+   *  @param[in] mp Whether to perform the X / Z GEMMs in single precision
+   */
+  void set_mixed_precision( bool mp );
+
+  /** Register the collocation matrix of the task in flight (calling thread)
+   *
+   *  In mixed precision, the collocation matrix is converted to single
+   *  precision once and reused by every X / Z GEMM which takes exactly this
+   *  (nbe,npts) matrix (ld = nbe) as an operand, instead of being converted
+   *  on every call. Must be released (or re-registered) before basis_eval
+   *  is modified. No-op in double precision.
+   *
+   *  @param[in] npts       Number of points of the collocation matrix
+   *  @param[in] nbe        Number of basis functions of the collocation matrix
+   *  @param[in] basis_eval Collocation matrix ((nbe,npts), col major)
+   */
+  void register_single_precision_basis( size_t npts, size_t nbe, 
+    const double* basis_eval );
+
+  /// Release the collocation matrix registered by the calling thread
+  void release_single_precision_basis();
+
   /** Evaluate the molecular partition weights
    *
    *  Overwrites the weights of passed XC Tasks to include molecular
@@ -71,6 +115,26 @@ public:
   void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
     const MolMeta& meta, task_iterator task_begin, task_iterator task_end );
 
+  /** Evaluate the partition weight contribution to a nuclear gradient
+   *
+   *  Increments grad by sum_i f_i * d w_i / d R_A, w_i being the modified
+   *  weights of the tasks. Grid points move with their parent atom, the
+   *  parent contribution follows from translational invariance.
+   *
+   *  @param[in] weight_alg Molecular partitioning scheme of task.weights
+   *  @param[in] mol        Molecule being partitioned
+   *  @param[in] molmeta    Metadata associated with mol
+   *  @param[in] task_begin Start iterator for tasks with modified weights
+   *  @param[in] task_end   End iterator for tasks with modified weights
+   *  @param[in] f          Integrand on the task points, concatenated in
+   *                        task order (sum of npts)
+   *
+   *  @param[in/out] grad   Nuclear gradient (3*natoms, atom-major)
+   */
+  void eval_weight_gradient( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta, task_iterator task_begin, task_iterator task_end,
+    const double* f, double* grad );
+
 
   /** Evaluation the collocation matrix
    *
@@ -140,7 +204,7 @@ public:
    *
    *  Includes a factor of 2 for total density in Libxc unpolarized input
    *
-   *  TODO: Need to add an API for UKS/GKS
+   *  TODO: Need to add an API for GKS
    *
    *  @param[in]  npts        The number of points in the collocation matrix 
    *  @param[in]  nbf         The total number of bfns
@@ -159,6 +223,31 @@ public:
     const double* basis_eval, size_t ldb, double* X, size_t ldx, 
     double* scr );
 
+  /** Evaluate the compressed "X" matrices for a batch of densities
+   *
+   *  The ndm density submatrices are stacked row-wise such that all
+   *  X matrices are formed by a single GEMM, i.e. column i of X holds
+   *  [X_0(:,i); X_1(:,i); ...]. X_k is located at X + k*nbe with
+   *  leading dimension ldx.
+   *
+   *  @param[in]  ndm         The number of density matrices
+   *  @param[in]  npts        Same as `eval_xmat`
+   *  @param[in]  nbf         Same as `eval_xmat`
+   *  @param[in]  nbe         Same as `eval_xmat`
+   *  @param[in]  submat_map  Same as `eval_xmat`
+   *  @param[in]  P           The alpha density matrices (ndm pointers to (nbf,nbf) col major)
+   *  @param[in]  ldp         The leading dimension of each P
+   *  @param[in]  basis_eval  Same as `eval_xmat`
+   *  @param[in]  ldb         Same as `eval_xmat`
+   *  @param[out] X           The stacked X matrices ( (ndm*nbe,npts) col major)
+   *  @param[in]  ldx         The leading dimension of X (>= ndm*nbe)
+   *  @param[in/out] scr      Scratch space of at least ndm*nbe*nbe
+   */
+  void eval_xmat_batched( size_t ndm, size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, const double* const* P, size_t ldp,
+    const double* basis_eval, size_t ldb, double* X, size_t ldx, 
+    double* scr );
+
   void eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
     size_t nbe_ket, const submat_map_t& submat_map_bra,
     const submat_map_t& submat_map_ket, const double* P, size_t ldp,
@@ -181,13 +270,14 @@ public:
    *
    *  U = V = rho (total density)
    *
-   *  TODO: Need to add an API for UKS/GKS
+   *  TODO: Need to add an API for GKS
    *
    *  @param[in] npts       The number of points to evaluate the U/V variables
    *  @param[in] nbe        The number of basis functions in collocation matrix
    *  @param[in] basis_eval The collocation matrix ( (nbe,npts), col major, lb=nbe)
    *  @param[in] X          The X matrix (P*B, (nbe,npts) col major)
-   *  @param[in] ldx        The leading dimension of X
+   *  @param[in] ldx        The leading dimension of X (may exceed nbe, e.g. for
+   *                        one block of a stacked batch of X matrices)
    *  @param[out] den_eval  The total density evaluated on the grid (npts)
    *
    */
@@ -199,7 +289,7 @@ public:
    *  U = rho + gradient
    *  V = rho + gamma
    *
-   *  TODO: Need to add an API for UKS/GKS
+   *  TODO: Need to add an API for GKS
    *
    *  @param[in] npts          Same as `eval_uvvar_lda`
    *  @param[in] nbe           Same as `eval_uvvar_lda`
@@ -221,11 +311,123 @@ public:
     const double* dbasis_z_eval, const double* X, size_t ldx, double* den_eval, 
     double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, double* gamma );
 
+  /** Evaluate the U and V variavles for UKS LDA
+   *
+   *  U = V = (rho_a, rho_b)
+   *
+   *  @param[in] npts       Same as `eval_uvvar_lda`
+   *  @param[in] nbe        Same as `eval_uvvar_lda`
+   *  @param[in] basis_eval Same as `eval_uvvar_lda`
+   *  @param[in] Xa         The alpha X matrix (2*Pa*B as produced by `eval_xmat`)
+   *  @param[in] ldxa       The leading dimension of Xa
+   *  @param[in] Xb         The beta X matrix (2*Pb*B as produced by `eval_xmat`)
+   *  @param[in] ldxb       The leading dimension of Xb
+   *  @param[out] den_eval  The spin densities, interleaved (2*npts)
+   *
+   */
+  void eval_uvvar_lda_uks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* Xa, size_t ldxa, const double* Xb, size_t ldxb, 
+    double* den_eval );
+
+  /** Evaluate the U and V variavles for UKS GGA
+   *
+   *  U = (rho_a, rho_b) + gradients
+   *  V = (rho_a, rho_b) + (gamma_aa, gamma_ab, gamma_bb)
+   *
+   *  @param[in] npts          Same as `eval_uvvar_lda_uks`
+   *  @param[in] nbe           Same as `eval_uvvar_lda_uks`
+   *  @param[in] basis_eval    Same as `eval_uvvar_lda_uks`
+   *  @param[in] dbasis_x_eval Same as `eval_uvvar_gga`
+   *  @param[in] dbasis_y_eval Same as `eval_uvvar_gga`
+   *  @param[in] dbasis_z_eval Same as `eval_uvvar_gga`
+   *  @param[in] Xa            Same as `eval_uvvar_lda_uks`
+   *  @param[in] ldxa          Same as `eval_uvvar_lda_uks`
+   *  @param[in] Xb            Same as `eval_uvvar_lda_uks`
+   *  @param[in] ldxb          Same as `eval_uvvar_lda_uks`
+   *  @param[out] den_eval     Same as `eval_uvvar_lda_uks`
+   *  @param[out] dden_x_eval  Derivative of `den_eval` wrt x, interleaved (2*npts)
+   *  @param[out] dden_y_eval  Derivative of `den_eval` wrt y, interleaved (2*npts)
+   *  @param[out] dden_z_eval  Derivative of `den_eval` wrt z, interleaved (2*npts)
+   *  @param[out] gamma        (aa, ab, bb) gradient contractions, interleaved (3*npts)
+   *                        
+   */
+  void eval_uvvar_gga_uks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* dbasis_x_eval, const double *dbasis_y_eval, 
+    const double* dbasis_z_eval, const double* Xa, size_t ldxa, 
+    const double* Xb, size_t ldxb, double* den_eval, double* dden_x_eval, 
+    double* dden_y_eval, double* dden_z_eval, double* gamma );
+
+  /** Evaluate the collocation matrix, X = P * B and the U/V variables 
+   *  for RKS LDA
+   *
+   *  Equivalent to `eval_collocation` + `eval_xmat` + `eval_uvvar_lda`,
+   *  but allows implementations to fuse these operations over blocks
+   *  of points.
+   *
+   *  @param[in]  npts        Same as `eval_collocation`
+   *  @param[in]  nshells     Same as `eval_collocation`
+   *  @param[in]  nbe         Same as `eval_collocation`
+   *  @param[in]  pts         Same as `eval_collocation`
+   *  @param[in]  basis       Same as `eval_collocation`
+   *  @param[in]  shell_list  Same as `eval_collocation`
+   *  @param[in]  nbf         Same as `eval_xmat`
+   *  @param[in]  submat_map  Same as `eval_xmat`
+   *  @param[in]  P           Same as `eval_xmat`
+   *  @param[in]  ldp         Same as `eval_xmat`
+   *  @param[out] basis_eval  Same as `eval_collocation`
+   *  @param[out] X           Same as `eval_xmat`
+   *  @param[in]  ldx         Same as `eval_xmat`
+   *  @param[out] den_eval    Same as `eval_uvvar_lda`
+   *  @param[in/out] scr      Same as `eval_xmat`
+   */
+  void eval_collocation_uvvar_lda( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    size_t nbf, const submat_map_t& submat_map, const double* P, size_t ldp,
+    double* basis_eval, double* X, size_t ldx, double* den_eval, double* scr );
+
+  /** Evaluate the collocation matrix + gradient, X = P * B and the U/V 
+   *  variables for RKS GGA
+   *
+   *  Equivalent to `eval_collocation_gradient` + `eval_xmat` + 
+   *  `eval_uvvar_gga`, but allows implementations to fuse these 
+   *  operations over blocks of points.
+   *
+   *  @param[in]  npts          Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  nshells       Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  nbe           Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  pts           Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  basis         Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  shell_list    Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  nbf           Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  submat_map    Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  P             Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  ldp           Same as `eval_collocation_uvvar_lda`
+   *  @param[out] basis_eval    Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_y_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_z_eval Same as `eval_collocation_gradient`
+   *  @param[out] X             Same as `eval_collocation_uvvar_lda`
+   *  @param[in]  ldx           Same as `eval_collocation_uvvar_lda`
+   *  @param[out] den_eval      Same as `eval_uvvar_gga`
+   *  @param[out] dden_x_eval   Same as `eval_uvvar_gga`
+   *  @param[out] dden_y_eval   Same as `eval_uvvar_gga`
+   *  @param[out] dden_z_eval   Same as `eval_uvvar_gga`
+   *  @param[out] gamma         Same as `eval_uvvar_gga`
+   *  @param[in/out] scr        Same as `eval_collocation_uvvar_lda`
+   */
+  void eval_collocation_uvvar_gga( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    size_t nbf, const submat_map_t& submat_map, const double* P, size_t ldp,
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* X, size_t ldx, double* den_eval, 
+    double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, 
+    double* gamma, double* scr );
+
   /** Evaluate the VXC Z Matrix for RKS LDA
    *
    *  Z(mu,i) = 0.5 * vrho(i) * B(mu, i)
    *
-   *  TODO: Need to add an API for UKS/GKS
+   *  TODO: Need to add an API for GKS
    *
    *  @param[in] npts        Number of grid points
    *  @param[in] nbe         Number of non-negligible bfns
@@ -243,7 +445,7 @@ public:
    *  Z(mu,i) = 0.5 * vrho(i)   * B(mu, i) +
    *            2.0 * vgamma(i) * (grad B(mu,i)) . (grad rho(i))
    *
-   *  TODO: Need to add an API for UKS/GKS
+   *  TODO: Need to add an API for GKS
    *
    *  @param[in] npts           Same as `eval_zmat_lda_vxc`
    *  @param[in] nbe            Same as `eval_zmat_lda_vxc`
@@ -266,6 +468,108 @@ public:
     const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
     double* Z, size_t ldz );
 
+  /** Evaluate the alpha and beta VXC Z Matrices for UKS LDA
+   *
+   *  Z_s(mu,i) = 0.5 * vrho_s(i) * B(mu, i)
+   *
+   *  @param[in] npts        Same as `eval_zmat_lda_vxc`
+   *  @param[in] nbe         Same as `eval_zmat_lda_vxc`
+   *  @param[in] vrho        Spin derivatives of the XC functional scaled by quad weight, interleaved (2*npts)
+   *  @param[in] basis_eval  Same as `eval_zmat_lda_vxc`
+   *  @param[out] Za         The alpha Z Matrix ((nbe,npts), col major)
+   *  @param[in]  ldza       Leading dimension of Za
+   *  @param[out] Zb         The beta Z Matrix ((nbe,npts), col major)
+   *  @param[in]  ldzb       Leading dimension of Zb
+   *
+   */
+  void eval_zmat_lda_vxc_uks( size_t npts, size_t nbe, const double* vrho, 
+    const double* basis_eval, double* Za, size_t ldza, double* Zb, 
+    size_t ldzb );
+
+  /** Evaluate the alpha and beta VXC Z Matrices for UKS GGA
+   *
+   *  Z_a(mu,i) = 0.5 * vrho_a(i) * B(mu, i) + 
+   *    (2.0 * vgamma_aa(i) * grad rho_a(i) + vgamma_ab(i) * grad rho_b(i)) . grad B(mu,i)
+   *
+   *  and similarly for Z_b
+   *
+   *  @param[in] npts           Same as `eval_zmat_lda_vxc_uks`
+   *  @param[in] nbe            Same as `eval_zmat_lda_vxc_uks`
+   *  @param[in] vrho           Same as `eval_zmat_lda_vxc_uks`
+   *  @param[in] vgamma         Derivatives of the XC functional wrt (aa, ab, bb) gamma scaled by quad weights, interleaved (3*npts)
+   *  @param[in] basis_eval     Same as `eval_zmat_lda_vxc_uks`
+   *  @param[in] dbasis_x_eval  Same as `eval_zmat_gga_vxc`
+   *  @param[in] dbasis_y_eval  Same as `eval_zmat_gga_vxc`
+   *  @param[in] dbasis_z_eval  Same as `eval_zmat_gga_vxc`
+   *  @param[in] dden_x_eval    Spin density derivatives wrt x, interleaved (2*npts)
+   *  @param[in] dden_y_eval    Spin density derivatives wrt y, interleaved (2*npts)
+   *  @param[in] dden_z_eval    Spin density derivatives wrt z, interleaved (2*npts)
+   *  @param[out] Za            Same as `eval_zmat_lda_vxc_uks`
+   *  @param[in]  ldza          Same as `eval_zmat_lda_vxc_uks`
+   *  @param[out] Zb            Same as `eval_zmat_lda_vxc_uks`
+   *  @param[in]  ldzb          Same as `eval_zmat_lda_vxc_uks`
+   *
+   */
+  void eval_zmat_gga_vxc_uks( size_t npts, size_t nbe, const double* vrho, 
+    const double* vgamma, const double* basis_eval, const double* dbasis_x_eval,
+    const double* dbasis_y_eval, const double* dbasis_z_eval, 
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    double* Za, size_t ldza, double* Zb, size_t ldzb );
+
+  /** Evaluate the FXC contraction Z Matrix for RKS LDA
+   *
+   *  Z(mu,i) = 0.5 * v2rho2(i) * rho1(i) * B(mu, i)
+   *
+   *  @param[in] npts        Same as `eval_zmat_lda_vxc`
+   *  @param[in] nbe         Same as `eval_zmat_lda_vxc`
+   *  @param[in] v2rho2      Second derivative of the XC functional wrt rho scaled by quad weights (npts)
+   *  @param[in] basis_eval  Same as `eval_zmat_lda_vxc`
+   *  @param[in] den1_eval   Trial density evaluated on the grid (npts)
+   *  @param[out] Z          Same as `eval_zmat_lda_vxc`
+   *  @param[in]  ldz        Same as `eval_zmat_lda_vxc`
+   *
+   */
+  void eval_zmat_lda_fxc( size_t npts, size_t nbe, const double* v2rho2, 
+    const double* basis_eval, const double* den1_eval, double* Z, size_t ldz );
+
+  /** Evaluate the FXC contraction Z Matrix for RKS GGA
+   *
+   *  gamma1(i) = 2 * (grad rho(i)) . (grad rho1(i))
+   *  A(i)      = v2rho2(i) * rho1(i) + v2rhogamma(i) * gamma1(i)
+   *  C(i)      = 2 * (v2rhogamma(i) * rho1(i) + v2gamma2(i) * gamma1(i))
+   *
+   *  Z(mu,i) = 0.5 * A(i) * B(mu,i) + 
+   *            (C(i) * grad rho(i) + 2 * vgamma(i) * grad rho1(i)) . (grad B(mu,i))
+   *
+   *  @param[in] npts           Same as `eval_zmat_gga_vxc`
+   *  @param[in] nbe            Same as `eval_zmat_gga_vxc`
+   *  @param[in] vgamma         Same as `eval_zmat_gga_vxc` (ground state)
+   *  @param[in] v2rho2         Same as `eval_zmat_lda_fxc`
+   *  @param[in] v2rhogamma     Mixed second derivative wrt rho/gamma scaled by quad weights (npts)
+   *  @param[in] v2gamma2       Second derivative wrt gamma scaled by quad weights (npts)
+   *  @param[in] basis_eval     Same as `eval_zmat_gga_vxc`
+   *  @param[in] dbasis_x_eval  Same as `eval_zmat_gga_vxc`
+   *  @param[in] dbasis_y_eval  Same as `eval_zmat_gga_vxc`
+   *  @param[in] dbasis_z_eval  Same as `eval_zmat_gga_vxc`
+   *  @param[in] dden_x_eval    Same as `eval_zmat_gga_vxc` (ground state)
+   *  @param[in] dden_y_eval    Same as `eval_zmat_gga_vxc` (ground state)
+   *  @param[in] dden_z_eval    Same as `eval_zmat_gga_vxc` (ground state)
+   *  @param[in] den1_eval      Same as `eval_zmat_lda_fxc`
+   *  @param[in] dden1_x_eval   Derivative of rho1 wrt x (npts)
+   *  @param[in] dden1_y_eval   Derivative of rho1 wrt y (npts)
+   *  @param[in] dden1_z_eval   Derivative of rho1 wrt z (npts)
+   *  @param[out] Z             Same as `eval_zmat_lda_vxc`
+   *  @param[in]  ldz           Same as `eval_zmat_lda_vxc`
+   *
+   */
+  void eval_zmat_gga_fxc( size_t npts, size_t nbe, const double* vgamma,
+    const double* v2rho2, const double* v2rhogamma, const double* v2gamma2,
+    const double* basis_eval, const double* dbasis_x_eval, 
+    const double* dbasis_y_eval, const double* dbasis_z_eval, 
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    const double* den1_eval, const double* dden1_x_eval, 
+    const double* dden1_y_eval, const double* dden1_z_eval, double* Z, size_t ldz );
+
 
   /** Increment VXC integrand given Z / Collocation (RKS LDA+GGA)
    *
@@ -289,10 +593,75 @@ public:
     const submat_map_t& submat_map, const double* Z, size_t ldz, double* VXC, 
     size_t ldvxc, double* scr );
 
+  /** Increment a batch of VXC-like integrands given stacked Z / Collocation
+   *
+   *  VXC_k += Z_k**H * B + h.c.
+   *
+   *  All Z_k * B**H are formed by a single GEMM. Only updates lower triangle
+   *
+   *  @param[in] ndm         Number of integrands
+   *  @param[in] npts        Same as `inc_vxc`
+   *  @param[in] nbf         Same as `inc_vxc`
+   *  @param[in] nbe         Same as `inc_vxc`
+   *  @paran[in] basis_eval  Same as `inc_vxc`
+   *  @param[in] submat_map  Same as `inc_vxc`
+   *  @param[in] Z           Stacked Z Matrices ((ndm*nbe,npts), col major), Z_k at Z + k*nbe
+   *  @param[in] ldz         Leading dimension of Z (>= ndm*nbe)
+   *  @param[in/out] VXC     ndm pointers to VXC integrands ((nbf,nbf), col major)
+   *  @param[in]  ldvxc      Leading dimension of each VXC
+   *  @param[out] scr        Scratch space at least ndm*nbe*nbe
+   *
+   */
+  void inc_vxc_batched( size_t ndm, size_t npts, size_t nbf, size_t nbe, 
+    const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
+    size_t ldz, double* const* VXC, size_t ldvxc, double* scr );
+
 private: 
 
   pimpl_type pimpl_; ///< Implementation
 
 };
 
+
+/// Sets the mixed precision toggle of a LocalHostWorkDriver for the lifetime
+/// of the guard, the previous value is restored upon destruction
+class MixedPrecisionGuard {
+
+  LocalHostWorkDriver* lwd_;
+  bool                 prev_;
+
+public:
+
+  MixedPrecisionGuard( LocalHostWorkDriver* lwd, bool mp ) :
+    lwd_(lwd), prev_(lwd->mixed_precision()) { lwd_->set_mixed_precision(mp); }
+
+  MixedPrecisionGuard( const MixedPrecisionGuard& )            = delete;
+  MixedPrecisionGuard& operator=( const MixedPrecisionGuard& ) = delete;
+
+  ~MixedPrecisionGuard() noexcept { lwd_->set_mixed_precision(prev_); }
+
+};
+
+/// Registered single precision collocation matrix of a task, released upon
+/// destruction (see LocalHostWorkDriver::register_single_precision_basis)
+class SinglePrecisionBasisScope {
+
+  LocalHostWorkDriver* lwd_;
+
+public:
+
+  SinglePrecisionBasisScope( LocalHostWorkDriver* lwd ) : lwd_(lwd) { }
+
+  SinglePrecisionBasisScope( const SinglePrecisionBasisScope& )            = delete;
+  SinglePrecisionBasisScope& operator=( const SinglePrecisionBasisScope& ) = delete;
+
+  ~SinglePrecisionBasisScope() noexcept { lwd_->release_single_precision_basis(); }
+
+  /// (Re-)register the collocation matrix of the task
+  void set( size_t npts, size_t nbe, const double* basis_eval ) {
+    lwd_->register_single_precision_basis( npts, nbe, basis_eval );
+  }
+
+};
+
 }
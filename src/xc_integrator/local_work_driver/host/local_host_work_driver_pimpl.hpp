@@ -24,11 +24,29 @@ struct LocalHostWorkDriverPIMPL {
   LocalHostWorkDriverPIMPL( const LocalHostWorkDriverPIMPL& )     = delete;
   LocalHostWorkDriverPIMPL( LocalHostWorkDriverPIMPL&& ) noexcept = delete;
 
+  /// Whether mixed precision may be activated by the integrator
+  bool mixed_precision_enabled_ = false;
+  /// Whether X / Z GEMMs are (currently) performed in single precision
+  bool mixed_precision_ = false;
+
+  inline bool mixed_precision_enabled() const { return mixed_precision_enabled_; }
+  inline void enable_mixed_precision( bool mp ) { mixed_precision_enabled_ = mp; }
+
+  inline bool mixed_precision() const { return mixed_precision_; }
+  inline void set_mixed_precision( bool mp ) { mixed_precision_ = mp; }
+
 
   // Public APIs
 
+  virtual void register_single_precision_basis( size_t npts, size_t nbe,
+    const double* basis_eval ) = 0;
+  virtual void release_single_precision_basis() = 0;
+
   virtual void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
     const MolMeta& meta, task_iterator task_begin, task_iterator task_end ) = 0;
+  virtual void eval_weight_gradient( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta, task_iterator task_begin, task_iterator task_end, 
+    const double* f, double* grad ) = 0;
 
   virtual void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
@@ -47,6 +65,9 @@ struct LocalHostWorkDriverPIMPL {
   virtual void eval_xmat( size_t npts, size_t nbf, size_t nbe, 
     const submat_map_t& submat_map, const double* P, size_t ldp, 
     const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) = 0;
+  virtual void eval_xmat_batched( size_t ndm, size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, const double* const* P, size_t ldp, 
+    const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) = 0;
 
   virtual void eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
     size_t nbe_ket, const submat_map_t& submat_map_bra,
@@ -74,6 +95,28 @@ struct LocalHostWorkDriverPIMPL {
     double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, 
     double* gamma ) = 0;
 
+  virtual void eval_uvvar_lda_uks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* Xa, size_t ldxa, const double* Xb, size_t ldxb, 
+    double* den_eval ) = 0;
+  virtual void eval_uvvar_gga_uks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* dbasis_x_eval, const double *dbasis_y_eval, 
+    const double* dbasis_z_eval, const double* Xa, size_t ldxa, 
+    const double* Xb, size_t ldxb, double* den_eval, double* dden_x_eval, 
+    double* dden_y_eval, double* dden_z_eval, double* gamma ) = 0;
+
+  virtual void eval_collocation_uvvar_lda( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    size_t nbf, const submat_map_t& submat_map, const double* P, size_t ldp,
+    double* basis_eval, double* X, size_t ldx, double* den_eval, 
+    double* scr ) = 0;
+  virtual void eval_collocation_uvvar_gga( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    size_t nbf, const submat_map_t& submat_map, const double* P, size_t ldp,
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* X, size_t ldx, double* den_eval, 
+    double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, 
+    double* gamma, double* scr ) = 0;
+
   virtual void eval_zmat_lda_vxc( size_t npts, size_t nbe, const double* vrho, 
     const double* basis_eval, double* Z, size_t ldz ) = 0;
   virtual void eval_zmat_gga_vxc( size_t npts, size_t nbe, const double* vrho, 
@@ -82,11 +125,35 @@ struct LocalHostWorkDriverPIMPL {
     const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
     double* Z, size_t ldz ) = 0;
 
+  virtual void eval_zmat_lda_vxc_uks( size_t npts, size_t nbe, const double* vrho, 
+    const double* basis_eval, double* Za, size_t ldza, double* Zb, 
+    size_t ldzb ) = 0;
+  virtual void eval_zmat_gga_vxc_uks( size_t npts, size_t nbe, const double* vrho, 
+    const double* vgamma, const double* basis_eval, const double* dbasis_x_eval,
+    const double* dbasis_y_eval, const double* dbasis_z_eval, 
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    double* Za, size_t ldza, double* Zb, size_t ldzb ) = 0;
+
+  virtual void eval_zmat_lda_fxc( size_t npts, size_t nbe, const double* v2rho2, 
+    const double* basis_eval, const double* den1_eval, double* Z, size_t ldz ) = 0;
+
+  virtual void eval_zmat_gga_fxc( size_t npts, size_t nbe, const double* vgamma,
+    const double* v2rho2, const double* v2rhogamma, const double* v2gamma2,
+    const double* basis_eval, const double* dbasis_x_eval, 
+    const double* dbasis_y_eval, const double* dbasis_z_eval, 
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    const double* den1_eval, const double* dden1_x_eval, 
+    const double* dden1_y_eval, const double* dden1_z_eval, double* Z, 
+    size_t ldz ) = 0;
 
   virtual void inc_vxc( size_t npts, size_t nbf, size_t nbe, 
     const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
     size_t ldz, double* VXC, size_t ldvxc, double* scr ) = 0;
 
+  virtual void inc_vxc_batched( size_t ndm, size_t npts, size_t nbf, size_t nbe, 
+    const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
+    size_t ldz, double* const* VXC, size_t ldvxc, double* scr ) = 0;
+
 };
 
 
@@ -0,0 +1,69 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/native_local_host_work_driver.hpp"
+#include "host/reference/collocation.hpp"
+#include "host/reference/weights.hpp"
+
+namespace GauXC {
+
+  NativeLocalHostWorkDriver::NativeLocalHostWorkDriver() :
+    ReferenceLocalHostWorkDriver() { }
+
+  NativeLocalHostWorkDriver::~NativeLocalHostWorkDriver() noexcept = default;
+
+  // Partition weights
+  void NativeLocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg, 
+    const Molecule& mol, const MolMeta& meta, task_iterator task_begin, 
+    task_iterator task_end ) {
+    switch( weight_alg ) {
+      case XCWeightAlg::Becke:
+        native_becke_weights_host( mol, meta, task_begin, task_end );
+        break;
+      case XCWeightAlg::SSF:
+        native_ssf_weights_host( mol, meta, task_begin, task_end );
+        break;
+      default:
+        ReferenceLocalHostWorkDriver::partition_weights( weight_alg, mol, 
+          meta, task_begin, task_end );
+    }
+  }
+
+  // Collocation
+  void NativeLocalHostWorkDriver::eval_collocation( size_t npts, 
+    size_t nshells, size_t nbe, const double* pts, 
+    const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval ) {
+    native_collocation( npts, nshells, nbe, pts, basis, shell_list, 
+      basis_eval );
+  }
+
+  // Collocation Gradient
+  void NativeLocalHostWorkDriver::eval_collocation_gradient( size_t npts, 
+    size_t nshells, size_t nbe, const double* pts, 
+    const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval ) {
+    native_collocation_gradient( npts, nshells, nbe, pts, basis, shell_list,
+      basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+  }
+
+  // Collocation Hessian
+  void NativeLocalHostWorkDriver::eval_collocation_hessian( size_t npts, 
+    size_t nshells, size_t nbe, const double* pts, 
+    const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* d2basis_xx_eval, double* d2basis_xy_eval, 
+    double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval, 
+    double* d2basis_zz_eval ) {
+    native_collocation_hessian( npts, nshells, nbe, pts, basis, shell_list,
+      basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
+      d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
+      d2basis_zz_eval );
+  }
+
+}
@@ -0,0 +1,49 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "host/reference_local_host_work_driver.hpp"
+
+namespace GauXC {
+
+/** Host LWD which evaluates collocation and partition weights natively
+ *
+ *  Collocation (+ derivatives) are evaluated with SIMD loops over blocks
+ *  of points and written directly in GauXC's bfn-major layout, bypassing
+ *  gau2grid and its transpose. Becke and SSF partition weights are
+ *  evaluated on SIMD blocks of points. All other kernels are inherited 
+ *  from the reference implementation.
+ */
+struct NativeLocalHostWorkDriver : public ReferenceLocalHostWorkDriver {
+
+  NativeLocalHostWorkDriver();
+
+  virtual ~NativeLocalHostWorkDriver() noexcept;
+
+  NativeLocalHostWorkDriver( const NativeLocalHostWorkDriver& )     = delete;
+  NativeLocalHostWorkDriver( NativeLocalHostWorkDriver&& ) noexcept = delete;
+
+  void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
+    const MolMeta& meta, task_iterator task_begin, task_iterator task_end ) override;
+
+  void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval ) override;
+  void eval_collocation_gradient( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval) override;
+  void eval_collocation_hessian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* d2basis_xx_eval, double* d2basis_xy_eval,
+    double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
+    double* d2basis_zz_eval ) override;
+
+};
+
+}
@@ -0,0 +1,136 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/molecule.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace GauXC {
+
+/** Uniform grid (cell list) over the atomic centers of a Molecule
+ *
+ *  The cell edge is chosen such that there is on average ~one atom per
+ *  cell, atoms are stored contiguously per cell (CSR). Radius queries
+ *  visit the cells overlapping the bounding cube of the query sphere.
+ */
+class AtomCellList {
+
+  using point_t = std::array<double,3>;
+
+  point_t                lo_;       ///< Lower corner of the grid
+  double                 h_;        ///< Cell edge
+  std::array<int64_t,3>  ncell_;    ///< Number of cells per dimension
+  std::vector<int32_t>   cell_st_;  ///< Cell offsets into atoms_ (ncells+1)
+  std::vector<int32_t>   atoms_;    ///< Atom indices, sorted by cell
+  std::vector<point_t>   coords_;   ///< Atomic coordinates
+
+  inline int64_t cell_coord( double x, int d ) const {
+    const double i = std::floor( (x - lo_[d]) / h_ );
+    return std::clamp( i, 0., double(ncell_[d] - 1) );
+  }
+
+  inline int64_t cell_index( int64_t i, int64_t j, int64_t k ) const {
+    return i + ncell_[0] * (j + ncell_[1] * k);
+  }
+
+public:
+
+  /// Minimum cell edge (bohr)
+  static constexpr double min_cell_edge = 1.;
+
+  AtomCellList( const Molecule& mol ) {
+
+    const size_t natoms = mol.natoms();
+    coords_.reserve( natoms );
+    for( const auto& atom : mol ) coords_.push_back({ atom.x, atom.y, atom.z });
+
+    point_t hi;
+    lo_.fill(  std::numeric_limits<double>::infinity() );
+    hi.fill( -std::numeric_limits<double>::infinity() );
+    for( const auto& c : coords_ )
+    for( int d = 0; d < 3; ++d ) {
+      lo_[d] = std::min( lo_[d], c[d] );
+      hi[d]  = std::max( hi[d],  c[d] );
+    }
+    if( not natoms ) { lo_.fill(0.); hi.fill(0.); }
+
+    double volume = 1.;
+    for( int d = 0; d < 3; ++d )
+      volume *= std::max( hi[d] - lo_[d], min_cell_edge );
+    h_ = std::max( std::cbrt( volume / std::max(natoms, 1ul) ), min_cell_edge );
+
+    for( int d = 0; d < 3; ++d )
+      ncell_[d] = std::max<int64_t>( 1, std::ceil( (hi[d] - lo_[d]) / h_ ) );
+
+    // Counting sort of the atoms into their cells
+    const size_t ncells = ncell_[0] * ncell_[1] * ncell_[2];
+    std::vector<int64_t> atom_cell( natoms );
+    cell_st_.assign( ncells + 1, 0 );
+    for( size_t iA = 0; iA < natoms; ++iA ) {
+      const auto& c = coords_[iA];
+      atom_cell[iA] = cell_index( cell_coord(c[0],0), cell_coord(c[1],1),
+        cell_coord(c[2],2) );
+      cell_st_[ atom_cell[iA] + 1 ]++;
+    }
+    for( size_t i = 0; i < ncells; ++i ) cell_st_[i+1] += cell_st_[i];
+
+    atoms_.resize( natoms );
+    std::vector<int32_t> fill( cell_st_.begin(), cell_st_.end() - 1 );
+    for( size_t iA = 0; iA < natoms; ++iA )
+      atoms_[ fill[atom_cell[iA]]++ ] = iA;
+
+  }
+
+  /// Coordinates of atom iA
+  inline const point_t& coords( int32_t iA ) const { return coords_[iA]; }
+
+  /// Distance between a point and atom iA
+  inline double dist( const point_t& p, int32_t iA ) const {
+    const auto& c = coords_[iA];
+    const double dx = p[0] - c[0];
+    const double dy = p[1] - c[1];
+    const double dz = p[2] - c[2];
+    return std::sqrt( dx*dx + dy*dy + dz*dz );
+  }
+
+  /** Visit every atom within a distance r of a point
+   *
+   *  @param[in] p    Query point
+   *  @param[in] r    Query radius
+   *  @param[in] func Callable as func( atom index, distance to p )
+   */
+  template <typename Func>
+  void for_each_within( const point_t& p, double r, Func&& func ) const {
+
+    std::array<int64_t,3> st, en;
+    for( int d = 0; d < 3; ++d ) {
+      st[d] = cell_coord( p[d] - r, d );
+      en[d] = cell_coord( p[d] + r, d );
+    }
+
+    for( int64_t k = st[2]; k <= en[2]; ++k )
+    for( int64_t j = st[1]; j <= en[1]; ++j )
+    for( int64_t i = st[0]; i <= en[0]; ++i ) {
+      const auto ic = cell_index(i,j,k);
+      for( auto ia = cell_st_[ic]; ia < cell_st_[ic+1]; ++ia ) {
+        const auto iA = atoms_[ia];
+        const auto dA = dist( p, iA );
+        if( dA <= r ) func( iA, dA );
+      }
+    }
+
+  }
+
+};
+
+}
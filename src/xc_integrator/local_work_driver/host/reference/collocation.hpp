@@ -47,4 +47,49 @@ void gau2grid_collocation_hessian( size_t                  npts,
                                    double*                 d2basis_yy_eval,
                                    double*                 d2basis_yz_eval,
                                    double*                 d2basis_zz_eval);
+
+/** GauXC-native host collocation
+ *
+ *  Same interface and (nbe, npts) bfn-major output as the gau2grid_*
+ *  variants, but evaluated directly in that layout (no transpose) with
+ *  the value, gradient and Hessian of each shell produced in one pass.
+ *  Points beyond a shell's cutoff_radius() are screened and evaluate to
+ *  exact zeros.
+ */
+void native_collocation( size_t                  npts, 
+                         size_t                  nshells,
+                         size_t                  nbe,
+                         const double*           points, 
+                         const BasisSet<double>& basis,
+                         const int32_t*          shell_mask,
+                         double*                 basis_eval );
+
+void native_collocation_gradient( size_t                  npts, 
+                                  size_t                  nshells,
+                                  size_t                  nbe,
+                                  const double*           points, 
+                                  const BasisSet<double>& basis,
+                                  const int32_t*          shell_mask,
+                                  double*                 basis_eval, 
+                                  double*                 dbasis_x_eval, 
+                                  double*                 dbasis_y_eval,
+                                  double*                 dbasis_z_eval );
+
+void native_collocation_hessian( size_t                  npts, 
+                                 size_t                  nshells,
+                                 size_t                  nbe,
+                                 const double*           points, 
+                                 const BasisSet<double>& basis,
+                                 const int32_t*          shell_mask,
+                                 double*                 basis_eval, 
+                                 double*                 dbasis_x_eval, 
+                                 double*                 dbasis_y_eval,
+                                 double*                 dbasis_z_eval, 
+                                 double*                 d2basis_xx_eval, 
+                                 double*                 d2basis_xy_eval,
+                                 double*                 d2basis_xz_eval,
+                                 double*                 d2basis_yy_eval,
+                                 double*                 d2basis_yz_eval,
+                                 double*                 d2basis_zz_eval);
+
 }
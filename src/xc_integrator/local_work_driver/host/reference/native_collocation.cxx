@@ -0,0 +1,509 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "collocation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gauxc/exceptions.hpp>
+#include <gauxc/util/real_solid_harmonics.hpp>
+
+namespace GauXC {
+
+namespace {
+
+/// Number of points evaluated together for each shell. The inner loops
+/// over a block are SIMD loops, 16 doubles fill two AVX-512 / four AVX2
+/// registers
+constexpr size_t native_block_npts = 16;
+
+/// Max angular momentum handled by the native collocation
+constexpr int native_max_l = 8;
+
+/// Max angular momentum with a compile-time specialized kernel
+constexpr int native_max_template_l = 6;
+
+/// Sentinel for kernels which take l / pure from the shell at runtime
+constexpr int dynamic_am = -1;
+
+constexpr int ncart( int l ) { return (l+1)*(l+2)/2; }
+constexpr int nsph ( int l ) { return 2*l + 1;       }
+
+/// Number of (d, dx, dy, dz, dxx, ...) components for a derivative order
+constexpr int ncomp( int deriv ) { return deriv == 0 ? 1 : (deriv == 1 ? 4 : 10); }
+
+/// Row-major (2l+1, ncart(l)) Cartesian -> real solid harmonic coefficients,
+/// both in CCA order. Same (unnormalized) convention as the device kernels
+/// in collocation_angular_spherical_unnorm.hpp
+const std::vector<double>& sph_coeffs( int l ) {
+
+  static const auto table = [](){
+    std::array< std::vector<double>, native_max_l+1 > t;
+    for( int L = 0; L <= native_max_l; ++L ) {
+      const int nc = ncart(L);
+      t[L].resize( nsph(L) * nc );
+      for( int m = -L, isph = 0; m <= L; ++m, ++isph )
+      for( int ix = L, icart = 0; ix >= 0; --ix )
+      for( int iy = L-ix;         iy >= 0; --iy, ++icart ) {
+        t[L][isph*nc + icart] =
+          util::real_solid_harmonic_coeff( L, m, ix, iy, L-ix-iy );
+      }
+    }
+    return t;
+  }();
+
+  return table[l];
+
+}
+
+template <int Deriv>
+constexpr size_t native_scratch_size( int max_l ) {
+  constexpr size_t B = native_block_npts;
+  return B * ( 3                                         // radial
+             + 3 * (max_l+1)                             // x^n, y^n, z^n
+             + ncomp(Deriv) * (ncart(max_l) + nsph(max_l)) // cart + sph
+             );
+}
+
+/** Shell-centered coordinates and primitive exponentials over a block
+ *  of points
+ *
+ *  Shared by every shell of an exponent group, i.e. consecutive shells
+ *  with the same center and exponents (SP shells, general contractions)
+ */
+struct native_block_geometry {
+  double* x;
+  double* y;
+  double* z;
+  double* rsq;
+  double* prim_exp; ///< (nprim, B) e^{-a_i r^2}
+};
+
+/// Whether two shells share their center and primitive exponents
+inline bool same_exponent_group( const Shell<double>& a, 
+  const Shell<double>& b ) {
+  return a.O() == b.O() and a.nprim() == b.nprim() and
+    std::equal( a.alpha_data(), a.alpha_data() + a.nprim(), b.alpha_data() );
+}
+
+/// Evaluate the coordinates of a block of points relative to the group
+/// center. Returns the number of points within rc2 of the center
+inline size_t native_block_coordinates( size_t nb, const double* pts,
+  const Shell<double>& sh, double rc2, native_block_geometry& g ) {
+
+  const auto* O = sh.O_data();
+  size_t nactive = 0;
+  #pragma omp simd reduction(+:nactive)
+  for( size_t p = 0; p < nb; ++p ) {
+    g.x[p]   = pts[3*p + 0] - O[0];
+    g.y[p]   = pts[3*p + 1] - O[1];
+    g.z[p]   = pts[3*p + 2] - O[2];
+    g.rsq[p] = g.x[p]*g.x[p] + g.y[p]*g.y[p] + g.z[p]*g.z[p];
+    nactive += g.rsq[p] <= rc2;
+  }
+  return nactive;
+
+}
+
+/// Evaluate the primitive exponentials of the group over a block of points
+inline void native_block_exponentials( size_t nb, const Shell<double>& sh,
+  native_block_geometry& g ) {
+
+  const auto* alpha = sh.alpha_data();
+  for( int i = 0; i < sh.nprim(); ++i ) {
+    const double a = alpha[i];
+    double* e = g.prim_exp + i*native_block_npts;
+    #pragma omp simd
+    for( size_t p = 0; p < nb; ++p ) e[p] = std::exp( -a * g.rsq[p] );
+  }
+
+}
+
+/// Write zeros for a shell on a block of points
+template <int Deriv>
+void native_zero_block( size_t nb, size_t nbe, int ns, size_t ioff,
+  double* const* eval ) {
+  for( int d = 0; d < ncomp(Deriv); ++d )
+  for( size_t p = 0; p < nb; ++p ) {
+    double* out = eval[d] + p*nbe + ioff;
+    for( int is = 0; is < ns; ++is ) out[is] = 0.;
+  }
+}
+
+/** Evaluate one shell (and its derivatives) over a block of points
+ *
+ *  Radial part (and its first two alpha-moments, contracted from the
+ *  group's primitive exponentials) and all Cartesian
+ *  angular components are evaluated in SIMD loops over the block,
+ *  transformed to the spherical basis if required and written directly
+ *  into the bfn-major (nbe, npts) output. Points beyond the shell's
+ *  cutoff_radius() are written as exact zeros, and blocks with no point
+ *  within the cutoff skip the evaluation altogether.
+ *
+ *  For L / Pure != dynamic_am, every loop over Cartesian / spherical
+ *  components has a compile-time trip count and is fully unrolled, the
+ *  remaining (runtime) loops are the SIMD loops over points.
+ */
+template <int Deriv, int L, int Pure>
+void native_collocation_block( size_t nb, size_t nbe, 
+  const native_block_geometry& g, const Shell<double>& sh, size_t ioff, 
+  double* const* eval, double* scr ) {
+
+  constexpr size_t B  = native_block_npts;
+  constexpr int    NC = ncomp(Deriv);
+
+  const int  l    = L    == dynamic_am ? sh.l()    : L;
+  const bool pure = Pure == dynamic_am ? sh.pure() : bool(Pure);
+  const int  nc   = ncart(l);
+  const int  ns   = pure ? nsph(l) : nc;
+
+  const double* x   = g.x;
+  const double* y   = g.y;
+  const double* z   = g.z;
+  const double* rsq = g.rsq;
+
+  double* r0  = scr;     // sum_i c_i e^{-a_i r^2}
+  double* r1  = r0 + B;  // -2 sum_i a_i c_i e^{-a_i r^2}
+  double* r2  = r1 + B;  //  4 sum_i a_i^2 c_i e^{-a_i r^2}
+  double* xp  = r2 + B;
+  double* yp  = xp + (l+1)*B;
+  double* zp  = yp + (l+1)*B;
+  double* cart = zp + (l+1)*B;
+  double* sph  = cart + NC*nc*B;
+
+  const double rc2 = sh.cutoff_radius() * sh.cutoff_radius();
+  size_t nactive = 0;
+  #pragma omp simd reduction(+:nactive)
+  for( size_t p = 0; p < nb; ++p ) {
+    r0[p]  = 0.; r1[p] = 0.; r2[p] = 0.;
+    nactive += rsq[p] <= rc2;
+  }
+
+  // Shell is negligible on every point of the block
+  if( not nactive ) {
+    native_zero_block<Deriv>( nb, nbe, ns, ioff, eval );
+    return;
+  }
+
+  // Radial part. Points outside of the shell cutoff radius get an exact
+  // zero radial part, which zeros every value / derivative below
+  const auto* alpha = sh.alpha_data();
+  const auto* coeff = sh.coeff_data();
+  for( int i = 0; i < sh.nprim(); ++i ) {
+    const double  a  = alpha[i];
+    const double  c  = coeff[i];
+    const double* ex = g.prim_exp + i*B;
+    #pragma omp simd
+    for( size_t p = 0; p < nb; ++p ) {
+      const double e = rsq[p] <= rc2 ? c * ex[p] : 0.;
+      r0[p] += e;
+      if constexpr ( Deriv > 0 ) r1[p] += a * e;
+      if constexpr ( Deriv > 1 ) r2[p] += a * a * e;
+    }
+  }
+
+  if constexpr ( Deriv > 0 ) {
+    #pragma omp simd
+    for( size_t p = 0; p < nb; ++p ) {
+      r1[p] *= -2.;
+      if constexpr ( Deriv > 1 ) r2[p] *= 4.;
+    }
+  }
+
+  // Powers of the shell-centered coordinates
+  #pragma omp simd
+  for( size_t p = 0; p < nb; ++p ) { xp[p] = 1.; yp[p] = 1.; zp[p] = 1.; }
+  for( int n = 1; n <= l; ++n ) {
+    #pragma omp simd
+    for( size_t p = 0; p < nb; ++p ) {
+      xp[n*B + p] = xp[(n-1)*B + p] * x[p];
+      yp[n*B + p] = yp[(n-1)*B + p] * y[p];
+      zp[n*B + p] = zp[(n-1)*B + p] * z[p];
+    }
+  }
+
+  // Cartesian components (CCA order). For A = x^i y^j z^k and radial R,
+  //   d_a (A R)    = d_a A R + A R1 r_a
+  //   d_ab (A R)   = d_ab A R + (d_a A r_b + d_b A r_a) R1
+  //                + A (delta_ab R1 + R2 r_a r_b)
+  for( int i = l, ic = 0; i >= 0; --i )
+  for( int j = l-i;       j >= 0; --j, ++ic ) {
+
+    const int k = l - i - j;
+    const double* X  = xp + i*B;
+    const double* Y  = yp + j*B;
+    const double* Z  = zp + k*B;
+
+    double* c0 = cart + ic*B;
+    #pragma omp simd
+    for( size_t p = 0; p < nb; ++p ) c0[p] = X[p]*Y[p]*Z[p] * r0[p];
+
+    if constexpr ( Deriv > 0 ) {
+
+      // Lower powers (the prefactor vanishes if the power would be negative)
+      const double  fi = i, fj = j, fk = k;
+      const double* X1 = xp + std::max(i-1,0)*B;
+      const double* Y1 = yp + std::max(j-1,0)*B;
+      const double* Z1 = zp + std::max(k-1,0)*B;
+
+      double* cx = cart + (1*nc + ic)*B;
+      double* cy = cart + (2*nc + ic)*B;
+      double* cz = cart + (3*nc + ic)*B;
+
+      #pragma omp simd
+      for( size_t p = 0; p < nb; ++p ) {
+        const double A  = X[p]*Y[p]*Z[p];
+        const double Ax = fi * X1[p]*Y[p]*Z[p];
+        const double Ay = fj * X[p]*Y1[p]*Z[p];
+        const double Az = fk * X[p]*Y[p]*Z1[p];
+        cx[p] = Ax * r0[p] + A * r1[p] * x[p];
+        cy[p] = Ay * r0[p] + A * r1[p] * y[p];
+        cz[p] = Az * r0[p] + A * r1[p] * z[p];
+      }
+
+      if constexpr ( Deriv > 1 ) {
+
+        const double* X2 = xp + std::max(i-2,0)*B;
+        const double* Y2 = yp + std::max(j-2,0)*B;
+        const double* Z2 = zp + std::max(k-2,0)*B;
+        const double fii = fi*(fi-1.), fjj = fj*(fj-1.), fkk = fk*(fk-1.);
+
+        double* cxx = cart + (4*nc + ic)*B;
+        double* cxy = cart + (5*nc + ic)*B;
+        double* cxz = cart + (6*nc + ic)*B;
+        double* cyy = cart + (7*nc + ic)*B;
+        double* cyz = cart + (8*nc + ic)*B;
+        double* czz = cart + (9*nc + ic)*B;
+
+        #pragma omp simd
+        for( size_t p = 0; p < nb; ++p ) {
+          const double A   = X[p]*Y[p]*Z[p];
+          const double Ax  = fi * X1[p]*Y[p]*Z[p];
+          const double Ay  = fj * X[p]*Y1[p]*Z[p];
+          const double Az  = fk * X[p]*Y[p]*Z1[p];
+          const double Axx = fii   * X2[p]*Y[p]*Z[p];
+          const double Ayy = fjj   * X[p]*Y2[p]*Z[p];
+          const double Azz = fkk   * X[p]*Y[p]*Z2[p];
+          const double Axy = fi*fj * X1[p]*Y1[p]*Z[p];
+          const double Axz = fi*fk * X1[p]*Y[p]*Z1[p];
+          const double Ayz = fj*fk * X[p]*Y1[p]*Z1[p];
+
+          const double R0 = r0[p], R1 = r1[p], R2 = r2[p];
+          const double xx = x[p], yy = y[p], zz = z[p];
+
+          cxx[p] = Axx*R0 + 2.*Ax*xx*R1 + A*(R1 + R2*xx*xx);
+          cyy[p] = Ayy*R0 + 2.*Ay*yy*R1 + A*(R1 + R2*yy*yy);
+          czz[p] = Azz*R0 + 2.*Az*zz*R1 + A*(R1 + R2*zz*zz);
+          cxy[p] = Axy*R0 + (Ax*yy + Ay*xx)*R1 + A*R2*xx*yy;
+          cxz[p] = Axz*R0 + (Ax*zz + Az*xx)*R1 + A*R2*xx*zz;
+          cyz[p] = Ayz*R0 + (Ay*zz + Az*yy)*R1 + A*R2*yy*zz;
+        }
+
+      }
+    }
+  }
+
+  // Spherical transformation (linear, so applies to every derivative)
+  const double* res = cart;
+  if( pure ) {
+    const double* T = sph_coeffs(l).data();
+    for( int d = 0; d < NC; ++d )
+    for( int is = 0; is < ns; ++is ) {
+      double* s = sph + (d*ns + is)*B;
+      #pragma omp simd
+      for( size_t p = 0; p < nb; ++p ) s[p] = 0.;
+      for( int ic = 0; ic < nc; ++ic ) {
+        const double t = T[is*nc + ic];
+        if( t == 0. ) continue;
+        const double* c = cart + (d*nc + ic)*B;
+        #pragma omp simd
+        for( size_t p = 0; p < nb; ++p ) s[p] += t * c[p];
+      }
+    }
+    res = sph;
+  }
+
+  // Write directly in the bfn-major layout
+  for( int d = 0; d < NC; ++d ) {
+    const double* r = res + d*ns*B;
+    for( size_t p = 0; p < nb; ++p ) {
+      double* out = eval[d] + p*nbe + ioff;
+      for( int is = 0; is < ns; ++is ) out[is] = r[is*B + p];
+    }
+  }
+
+}
+
+using native_block_fn = void(*)( size_t, size_t, 
+  const native_block_geometry&, const Shell<double>&, size_t, double* const*,
+  double* );
+
+template <int Deriv, int... Ls>
+constexpr auto make_native_block_table( std::integer_sequence<int, Ls...> ) {
+  return std::array< std::array<native_block_fn,2>, sizeof...(Ls) >{{
+    {{ &native_collocation_block<Deriv,Ls,0>, 
+       &native_collocation_block<Deriv,Ls,1> }}...
+  }};
+}
+
+/// Jump table of block kernels keyed by (Deriv, l, pure). Shells with
+/// l > native_max_template_l use the generic (runtime l) kernel
+template <int Deriv>
+native_block_fn native_block_kernel( int l, bool pure ) {
+  static constexpr auto table = make_native_block_table<Deriv>(
+    std::make_integer_sequence<int, native_max_template_l+1>{} );
+  if( l <= native_max_template_l ) return table[l][pure];
+  return &native_collocation_block<Deriv, dynamic_am, dynamic_am>;
+}
+
+template <int Deriv>
+void native_collocation_impl( size_t npts, size_t nshells, size_t nbe,
+  const double* points, const BasisSet<double>& basis,
+  const int32_t* shell_mask, double* const* eval ) {
+
+  int max_l = 0;
+  for( size_t i = 0; i < nshells; ++i )
+    max_l = std::max( max_l, basis.at(shell_mask[i]).l() );
+  if( max_l > native_max_l )
+    GAUXC_GENERIC_EXCEPTION("Native Collocation: L > " +
+      std::to_string(native_max_l) + " NYI");
+
+  // Resolve the kernels and exponent groups once, outside of the loop over
+  // point blocks. Group g spans shells [group_st[g], group_st[g+1]), and 
+  // is screened with the largest cutoff radius of its shells
+  std::vector<native_block_fn> kernels( nshells );
+  std::vector<size_t> group_st;
+  std::vector<double> group_rc2;
+  int max_nprim = 0;
+  for( size_t i = 0; i < nshells; ++i ) {
+    const auto& sh = basis.at(shell_mask[i]);
+    kernels[i] = native_block_kernel<Deriv>( sh.l(), sh.pure() );
+    max_nprim  = std::max( max_nprim, sh.nprim() );
+
+    const double rc2 = sh.cutoff_radius() * sh.cutoff_radius();
+    if( not i or not same_exponent_group( basis.at(shell_mask[group_st.back()]),
+      sh ) ) {
+      group_st.emplace_back( i );
+      group_rc2.emplace_back( rc2 );
+    } else {
+      group_rc2.back() = std::max( group_rc2.back(), rc2 );
+    }
+  }
+  const size_t ngroups = group_st.size();
+  group_st.emplace_back( nshells );
+
+  constexpr size_t B = native_block_npts;
+  std::vector<double> scr( native_scratch_size<Deriv>(max_l) + 
+    (4 + max_nprim) * B );
+
+  native_block_geometry geom;
+  geom.x        = scr.data() + native_scratch_size<Deriv>(max_l);
+  geom.y        = geom.x   + B;
+  geom.z        = geom.y   + B;
+  geom.rsq      = geom.z   + B;
+  geom.prim_exp = geom.rsq + B;
+
+  double* block_eval[ ncomp(Deriv) ];
+
+  // Blocks of points outermost: the (nbe, nb) output block stays in
+  // cache while every shell writes its rows
+  for( size_t ist = 0; ist < npts; ist += native_block_npts ) {
+
+    const size_t nb = std::min( native_block_npts, npts - ist );
+    for( int d = 0; d < ncomp(Deriv); ++d ) block_eval[d] = eval[d] + ist*nbe;
+
+    size_t ioff = 0;
+    for( size_t ig = 0; ig < ngroups; ++ig ) {
+
+      const auto& leader  = basis.at(shell_mask[group_st[ig]]);
+      const auto  nactive = native_block_coordinates( nb, points + 3*ist, 
+        leader, group_rc2[ig], geom );
+
+      // Exponentials are evaluated once and reused by every shell of the 
+      // group, unless all of them are negligible on this block
+      if( nactive ) native_block_exponentials( nb, leader, geom );
+
+      for( size_t i = group_st[ig]; i < group_st[ig+1]; ++i ) {
+        const auto& sh = basis.at(shell_mask[i]);
+        if( nactive )
+          kernels[i]( nb, nbe, geom, sh, ioff, block_eval, scr.data() );
+        else
+          native_zero_block<Deriv>( nb, nbe, sh.size(), ioff, block_eval );
+        ioff += sh.size();
+      }
+
+    }
+
+  }
+
+}
+
+}
+
+void native_collocation( size_t                  npts,
+                         size_t                  nshells,
+                         size_t                  nbe,
+                         const double*           points,
+                         const BasisSet<double>& basis,
+                         const int32_t*          shell_mask,
+                         double*                 basis_eval ) {
+
+  double* eval[] = { basis_eval };
+  native_collocation_impl<0>( npts, nshells, nbe, points, basis, shell_mask,
+    eval );
+
+}
+
+void native_collocation_gradient( size_t                  npts,
+                                  size_t                  nshells,
+                                  size_t                  nbe,
+                                  const double*           points,
+                                  const BasisSet<double>& basis,
+                                  const int32_t*          shell_mask,
+                                  double*                 basis_eval,
+                                  double*                 dbasis_x_eval,
+                                  double*                 dbasis_y_eval,
+                                  double*                 dbasis_z_eval ) {
+
+  double* eval[] = { basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval };
+  native_collocation_impl<1>( npts, nshells, nbe, points, basis, shell_mask,
+    eval );
+
+}
+
+void native_collocation_hessian( size_t                  npts,
+                                 size_t                  nshells,
+                                 size_t                  nbe,
+                                 const double*           points,
+                                 const BasisSet<double>& basis,
+                                 const int32_t*          shell_mask,
+                                 double*                 basis_eval,
+                                 double*                 dbasis_x_eval,
+                                 double*                 dbasis_y_eval,
+                                 double*                 dbasis_z_eval,
+                                 double*                 d2basis_xx_eval,
+                                 double*                 d2basis_xy_eval,
+                                 double*                 d2basis_xz_eval,
+                                 double*                 d2basis_yy_eval,
+                                 double*                 d2basis_yz_eval,
+                                 double*                 d2basis_zz_eval ) {
+
+  double* eval[] = { basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+    d2basis_xx_eval, d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval,
+    d2basis_yz_eval, d2basis_zz_eval };
+  native_collocation_impl<2>( npts, nshells, nbe, points, basis, shell_mask,
+    eval );
+
+}
+
+}
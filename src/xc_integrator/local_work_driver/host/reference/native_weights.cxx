@@ -0,0 +1,269 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/reference/weights.hpp"
+#include "host/reference/ssf_task_screening.hpp"
+#include "common/integrator_constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace GauXC {
+
+namespace {
+
+/// Number of points processed simultaneously (SIMD lanes x unroll)
+constexpr size_t native_weights_block_npts = 16;
+
+/// Per-thread SoA scratch for a block of points
+struct NativeWeightsBlock {
+
+  static constexpr size_t B = native_weights_block_npts;
+
+  alignas(64) double x[B];
+  alignas(64) double y[B];
+  alignas(64) double z[B];
+  alignas(64) double w[B]; ///< P_parent / sum_A P_A
+  alignas(64) bool   active[B]; ///< Point not within the weight-1 radius
+
+  std::vector<double> dist;      ///< (natoms,B) point - atom distances
+  std::vector<double> partition; ///< (natoms,B) cell functions
+
+  inline void resize( size_t natoms ) {
+    if( dist.size() < natoms * B ) {
+      dist.resize( natoms * B );
+      partition.resize( natoms * B );
+    }
+  }
+
+  /// Load a block of points into SoA form (padding replicates point 0)
+  inline void load( size_t nb, const XCTask& task, size_t ipt ) {
+    for( size_t p = 0; p < B; ++p ) {
+      const auto& point = task.points[ ipt + (p < nb ? p : 0) ];
+      x[p] = point[0]; y[p] = point[1]; z[p] = point[2];
+    }
+  }
+
+  /// Distances of the block points to a list of atoms
+  template <typename AtomIndex>
+  inline void distances( const Molecule& mol, size_t natoms,
+    AtomIndex&& atom ) {
+    for( size_t iA = 0; iA < natoms; ++iA ) {
+      const auto& A = mol[ atom(iA) ];
+      double* d = dist.data() + iA*B;
+      #pragma omp simd
+      for( size_t p = 0; p < B; ++p ) {
+        const double dx = x[p] - A.x;
+        const double dy = y[p] - A.y;
+        const double dz = z[p] - A.z;
+        d[p] = std::sqrt( dx*dx + dy*dy + dz*dz );
+      }
+    }
+  }
+
+  /// w = P_parent / sum_A P_A
+  inline void normalize( size_t natoms, size_t parent_idx ) {
+    double sum[B] = {0.};
+    for( size_t iA = 0; iA < natoms; ++iA ) {
+      const double* P = partition.data() + iA*B;
+      #pragma omp simd
+      for( size_t p = 0; p < B; ++p ) sum[p] += P[p];
+    }
+    const double* P = partition.data() + parent_idx*B;
+    #pragma omp simd
+    for( size_t p = 0; p < B; ++p ) w[p] = P[p] / sum[p];
+  }
+
+};
+
+/// SSF polynomial, Eq. 14 of Stratmann et al. (+-1 for |mu| >= a)
+inline double ssf_g( double mu ) {
+  constexpr double a = integrator::magic_ssf_factor<>;
+  mu = mu < -a ? -a : mu;
+  mu = mu >  a ?  a : mu;
+
+  const double s_x  = mu / a;
+  const double s_x2 = s_x  * s_x;
+  const double s_x3 = s_x  * s_x2;
+  const double s_x5 = s_x3 * s_x2;
+  const double s_x7 = s_x5 * s_x2;
+
+  return (35.*(s_x - s_x3) + 21.*s_x5 - 5.*s_x7) / 16.;
+}
+
+/// Becke polynomial, f_3 of Eq. 20
+inline double becke_g( double mu ) {
+  auto h = []( double x ) { return 1.5 * x - 0.5 * x * x * x; };
+  return h(h(h(mu)));
+}
+
+}
+
+
+void native_ssf_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  constexpr size_t B = native_weights_block_npts;
+  constexpr double a = integrator::magic_ssf_factor<>;
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const size_t natoms = mol.natoms();
+
+  const auto&  RAB    = meta.rab();
+
+  const AtomCellList cell_list( mol );
+
+  #pragma omp parallel
+  {
+
+  NativeWeightsBlock   blk;
+  SSFTaskScreening     screen_task( cell_list, meta );
+  std::vector<int32_t> task_atoms;
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto& task = *(task_begin+iT);
+    if( not screen_task( task, task_atoms ) ) continue;
+
+    const size_t npts        = task.points.size();
+    const size_t natoms_task = task_atoms.size();
+    const size_t parent_idx  = std::distance( task_atoms.begin(),
+      std::find( task_atoms.begin(), task_atoms.end(), task.iParent ) );
+    const auto dist_cutoff = 0.5 * (1-a) * task.dist_nearest;
+
+    blk.resize( natoms_task );
+
+  for( size_t ipt = 0; ipt < npts; ipt += B ) {
+
+    const size_t nb = std::min( B, npts - ipt );
+    blk.load( nb, task, ipt );
+
+    // Points within dist_cutoff of the parent keep weight 1
+    {
+      const auto& P = mol[task.iParent];
+      size_t nactive = 0;
+      #pragma omp simd reduction(+:nactive)
+      for( size_t p = 0; p < B; ++p ) {
+        const double dx = blk.x[p] - P.x;
+        const double dy = blk.y[p] - P.y;
+        const double dz = blk.z[p] - P.z;
+        const bool act = (p < nb) &
+          (dx*dx + dy*dy + dz*dz >= dist_cutoff * dist_cutoff);
+        blk.active[p] = act;
+        nactive += act;
+      }
+      if( not nactive ) continue;
+    }
+
+    blk.distances( mol, natoms_task,
+      [&]( size_t iA ){ return task_atoms[iA]; } );
+    std::fill_n( blk.partition.begin(), natoms_task * B, 1. );
+
+    // Unnormalized partition functions. As in the scalar reference, a
+    // pair is skipped (per point) when both cell functions are already
+    // below ssf_weight_tol
+    for( size_t iA = 0; iA < natoms_task; iA++ )
+    for( size_t jA = 0; jA < iA;          jA++ ) {
+
+      double* __restrict__       Pi = blk.partition.data() + iA*B;
+      double* __restrict__       Pj = blk.partition.data() + jA*B;
+      const double* __restrict__ di = blk.dist.data() + iA*B;
+      const double* __restrict__ dj = blk.dist.data() + jA*B;
+      const double rab = RAB[task_atoms[jA] + task_atoms[iA]*natoms];
+
+      #pragma omp simd
+      for( size_t p = 0; p < B; ++p ) {
+        const bool   upd = (Pi[p] > integrator::ssf_weight_tol) |
+                           (Pj[p] > integrator::ssf_weight_tol);
+        const double g   = 0.5 * ( 1. - ssf_g( (di[p] - dj[p]) / rab ) );
+        Pi[p] = upd ? Pi[p] * g        : Pi[p];
+        Pj[p] = upd ? Pj[p] * (1. - g) : Pj[p];
+      }
+
+    }
+
+    blk.normalize( natoms_task, parent_idx );
+    for( size_t p = 0; p < nb; ++p )
+    if( blk.active[p] ) task.weights[ipt+p] *= blk.w[p];
+
+  } // Loop over point blocks
+  } // Loop over tasks
+
+  } // OMP context
+
+}
+
+void native_becke_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  constexpr size_t B = native_weights_block_npts;
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const size_t natoms = mol.natoms();
+
+  const auto&  RAB    = meta.rab();
+
+  #pragma omp parallel
+  {
+
+  NativeWeightsBlock blk;
+  blk.resize( natoms );
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto& task = *(task_begin+iT);
+    const size_t npts = task.points.size();
+
+  for( size_t ipt = 0; ipt < npts; ipt += B ) {
+
+    const size_t nb = std::min( B, npts - ipt );
+    blk.load( nb, task, ipt );
+
+    blk.distances( mol, natoms, []( size_t iA ){ return iA; } );
+    std::fill_n( blk.partition.begin(), natoms * B, 1. );
+
+    // Unnormalized partition functions
+    for( size_t iA = 0; iA < natoms; iA++ )
+    for( size_t jA = 0; jA < iA;     jA++ ) {
+
+      double* __restrict__       Pi = blk.partition.data() + iA*B;
+      double* __restrict__       Pj = blk.partition.data() + jA*B;
+      const double* __restrict__ di = blk.dist.data() + iA*B;
+      const double* __restrict__ dj = blk.dist.data() + jA*B;
+      const double rab = RAB[jA + iA*natoms];
+
+      #pragma omp simd
+      for( size_t p = 0; p < B; ++p ) {
+        const double g = becke_g( (di[p] - dj[p]) / rab );
+        Pi[p] *= 0.5 * (1. - g);
+        Pj[p] *= 0.5 * (1. + g);
+      }
+
+    }
+
+    blk.normalize( natoms, task.iParent );
+    for( size_t p = 0; p < nb; ++p ) task.weights[ipt+p] *= blk.w[p];
+
+  } // Loop over point blocks
+  } // Loop over tasks
+
+  } // OMP context
+
+}
+
+}
@@ -0,0 +1,161 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/molmeta.hpp>
+#include <gauxc/xc_task.hpp>
+
+#include "host/reference/atom_cell_list.hpp"
+#include "common/integrator_constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace GauXC {
+
+/** Per-task atom screening for SSF partition weights
+ *
+ *  Since R_AB <= r_A + r_B, the SSF cell function of atom A vanishes
+ *  exactly (mu_AN >= a) on points where r_A >= kappa * r_N, N being the
+ *  nearest atom to the point. Atoms satisfying this on every point of a
+ *  task are dropped, as are the remaining atoms B for which
+ *  r_B - r_A >= a * R_AB holds on every point for every kept atom A, i.e.
+ *  which only contribute factors of exactly one.
+ *
+ *  Screening inequalities are relaxed by `slack` to be safe w.r.t.
+ *  roundoff. Instances hold scratch space and are meant to be used by a
+ *  single thread.
+ */
+class SSFTaskScreening {
+
+  static constexpr double a     = integrator::magic_ssf_factor<>;
+  static constexpr double kappa = (1. + a) / (1. - a);
+  static constexpr double slack = 1e-10;
+
+  const AtomCellList& cell_list_;
+  const MolMeta&      meta_;
+
+  std::vector<char>                      is_near_;
+  std::vector<int32_t>                   candidates_;
+  std::vector<std::pair<int32_t,double>> near_atoms_;
+  std::vector<double>                    nearest_dist_;
+
+public:
+
+  SSFTaskScreening( const AtomCellList& cell_list, const MolMeta& meta ) :
+    cell_list_(cell_list), meta_(meta), is_near_( meta.natoms(), 0 ) { }
+
+  /** Determine the atoms contributing to the SSF weights of a task
+   *
+   *  @param[in]  task       Task to screen
+   *  @param[out] task_atoms Contributing atoms (sorted, contains iParent)
+   *
+   *  @returns false if the partition weight is 1 on every point of the
+   *           task (task_atoms is left unmodified), true otherwise.
+   */
+  bool operator()( const XCTask& task, std::vector<int32_t>& task_atoms ) {
+
+    const size_t npts   = task.points.size();
+    const size_t natoms = meta_.natoms();
+    const auto&  RAB    = meta_.rab();
+    if( not npts ) return false;
+
+    // Bounding sphere of the task
+    std::array<double,3> center, box_lo = task.points[0], box_hi = box_lo;
+    for( const auto& point : task.points )
+    for( int d = 0; d < 3; ++d ) {
+      box_lo[d] = std::min( box_lo[d], point[d] );
+      box_hi[d] = std::max( box_hi[d], point[d] );
+    }
+    for( int d = 0; d < 3; ++d ) center[d] = 0.5 * (box_lo[d] + box_hi[d]);
+
+    double rho = 0.;
+    for( const auto& point : task.points ) {
+      const double dx = point[0] - center[0];
+      const double dy = point[1] - center[1];
+      const double dz = point[2] - center[2];
+      rho = std::max( rho, std::sqrt(dx*dx + dy*dy + dz*dz) );
+    }
+
+    // Partition weight = 1 for every point of the task
+    const auto dist_cutoff = 0.5 * (1-a) * task.dist_nearest;
+    const double d_parent = cell_list_.dist( center, task.iParent );
+    if( d_parent + rho < dist_cutoff ) return false;
+
+    // Candidate atoms: any point's nearest atom is within rn_max of it
+    const double rn_max = d_parent + rho;
+    candidates_.clear();
+    cell_list_.for_each_within( center, kappa * rn_max + rho,
+      [&]( int32_t iA, double ) { candidates_.push_back( iA ); });
+
+    // Distance of each point to its nearest atom
+    nearest_dist_.assign( npts, std::numeric_limits<double>::infinity() );
+    for( auto iA : candidates_ )
+    for( size_t i = 0; i < npts; ++i ) {
+      nearest_dist_[i] = std::min( nearest_dist_[i],
+        cell_list_.dist( task.points[i], iA ) );
+    }
+
+    // Near atoms: cell function may be nonzero on some point of the task.
+    // Keep track of their max distance to any point of the task
+    near_atoms_.clear();
+    double r_far = 0.;
+    for( auto iA : candidates_ ) {
+      bool   near  = false;
+      double r_max = 0.;
+      for( size_t i = 0; i < npts; ++i ) {
+        const double r = cell_list_.dist( task.points[i], iA );
+        near  = near or r < kappa * nearest_dist_[i] * (1. + slack);
+        r_max = std::max( r_max, r );
+      }
+      if( near ) {
+        near_atoms_.push_back({ iA, r_max });
+        r_far = std::max( r_far, r_max +
+          a * cell_list_.dist( center, iA ) );
+      }
+    }
+
+    task_atoms.clear();
+    for( const auto& n : near_atoms_ ) {
+      task_atoms.push_back( n.first );
+      is_near_[n.first] = 1;
+    }
+
+    // Remaining atoms (B) only contribute factors of exactly one to the
+    // cell functions of the near atoms (A) on every point (mu_AB <= -a),
+    // unless r_B - r_A < a * R_AB can hold somewhere in the task. Using
+    // R_AB <= d_A + d_B (distances to the center) this is excluded beyond
+    // r_far
+    r_far = (r_far + rho) / (1. - a);
+    cell_list_.for_each_within( center, r_far * (1. + slack),
+      [&]( int32_t iB, double dB ) {
+        if( is_near_[iB] ) return;
+        const auto* RAB_B = RAB.data() + iB*natoms;
+        for( const auto& [iA, rA_max] : near_atoms_ )
+        if( dB - rho - rA_max <= a * RAB_B[iA] * (1. + slack) ) {
+          task_atoms.push_back( iB );
+          break;
+        }
+      });
+
+    for( const auto& n : near_atoms_ ) is_near_[n.first] = 0;
+
+    // Preserve the atom ordering of the unscreened pair loop
+    if( std::find( task_atoms.begin(), task_atoms.end(), task.iParent ) ==
+        task_atoms.end() ) task_atoms.push_back( task.iParent );
+    std::sort( task_atoms.begin(), task_atoms.end() );
+
+    return true;
+
+  }
+
+};
+
+}
@@ -6,12 +6,48 @@
  * See LICENSE.txt for details
  */
 #include "host/reference/weights.hpp"
+#include "host/reference/ssf_task_screening.hpp"
 #include "common/integrator_constants.hpp"
 
 #include <gauxc/molgrid/defaults.hpp>
+#include <gauxc/exceptions.hpp>
+
+#include <numeric>
 
 namespace GauXC {
 
+namespace {
+
+// Becke partition functions
+inline double hBecke( double x ) { return 1.5 * x - 0.5 * x * x * x; } // Eq. 19
+inline double gBecke( double x ) { return hBecke(hBecke(hBecke(x))); } // Eq. 20 f_3
+
+inline double dhBecke( double x ) { return 1.5 * (1. - x * x); }
+inline double dgBecke( double x ) {
+  const double h1 = hBecke(x);
+  const double h2 = hBecke(h1);
+  return dhBecke(h2) * dhBecke(h1) * dhBecke(x);
+}
+
+// SSF partition functions (|x| < a)
+inline double gFrisch( double x ) {
+  const double s_x  = x / integrator::magic_ssf_factor<>;
+  const double s_x2 = s_x  * s_x;
+  const double s_x3 = s_x  * s_x2;
+  const double s_x5 = s_x3 * s_x2;
+  const double s_x7 = s_x5 * s_x2;
+
+  return (35.*(s_x - s_x3) + 21.*s_x5 - 5.*s_x7) / 16.;
+}
+
+inline double dgFrisch( double x ) {
+  const double s_x = x / integrator::magic_ssf_factor<>;
+  const double t   = 1. - s_x * s_x;
+  return 35. * t * t * t / (16. * integrator::magic_ssf_factor<>);
+}
+
+}
+
 // Reference Becke weights impl
 void reference_becke_weights_host(
   const Molecule&        mol,
@@ -20,9 +56,6 @@ void reference_becke_weights_host(
   task_iterator          task_end
 ) {
 
-  // Becke partition functions
-  auto hBecke = [](double x) {return 1.5 * x - 0.5 * x * x * x;}; // Eq. 19
-  auto gBecke = [&](double x) {return hBecke(hBecke(hBecke(x)));}; // Eq. 20 f_3
 
   const size_t ntasks = std::distance(task_begin,task_end);
   const size_t natoms = mol.natoms();
@@ -115,69 +148,75 @@ void reference_ssf_weights_host(
   task_iterator          task_end
 ) {
 
-  auto gFrisch = [&](double x) {
-    const double s_x  = x / integrator::magic_ssf_factor<>;
-    const double s_x2 = s_x  * s_x;
-    const double s_x3 = s_x  * s_x2;
-    const double s_x5 = s_x3 * s_x2;
-    const double s_x7 = s_x5 * s_x2;
-
-    return (35.*(s_x - s_x3) + 21.*s_x5 - 5.*s_x7) / 16.;
-  };
-
   const size_t ntasks = std::distance(task_begin,task_end);
   const size_t natoms = mol.natoms();
 
   const auto&  RAB    = meta.rab();
 
+  const AtomCellList cell_list( mol );
+
   #pragma omp parallel 
   {
 
   std::vector<double> partitionScratch( natoms );
   std::vector<double> atomDist( natoms );
 
-  #pragma omp for
-  for( size_t iT = 0; iT < ntasks;                  ++iT )
-  for( size_t i  = 0; i  < (task_begin+iT)->points.size(); ++i  ) {
+  SSFTaskScreening     screen_task( cell_list, meta );
+  std::vector<int32_t> task_atoms;
 
-    auto&       task   = *(task_begin+iT);
-    auto&       weight = task.weights[i];
-    const auto& point  = task.points[i];
+  // Tasks are screened as a whole, their cost varies considerably
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
 
+    auto& task = *(task_begin+iT);
+    if( not screen_task( task, task_atoms ) ) continue;
+
+    const size_t npts = task.points.size();
     const auto dist_cutoff = 0.5 * (1-integrator::magic_ssf_factor<>) * task.dist_nearest;
 
+    const size_t natoms_task = task_atoms.size();
+    const size_t parent_idx  = std::distance( task_atoms.begin(),
+      std::find( task_atoms.begin(), task_atoms.end(), task.iParent ) );
+
+  for( size_t i = 0; i < npts; ++i ) {
+
+    auto&       weight = task.weights[i];
+    const auto& point  = task.points[i];
+
     // Compute dist to parent atom
     {
       const double da_x = point[0] - mol[task.iParent].x;
       const double da_y = point[1] - mol[task.iParent].y;
       const double da_z = point[2] - mol[task.iParent].z;
 
-      atomDist[task.iParent] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
+      atomDist[parent_idx] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
     }
 
-    if( atomDist[task.iParent] < dist_cutoff ) continue; // Partition weight = 1
+    if( atomDist[parent_idx] < dist_cutoff ) continue; // Partition weight = 1
 
     // Compute distances of each center to point
-    for(size_t iA = 0; iA < natoms; iA++) {
+    for(size_t iA = 0; iA < natoms_task; iA++) {
 
-      if( iA == (size_t)task.iParent ) continue;
+      if( iA == parent_idx ) continue;
 
-      const double da_x = point[0] - mol[iA].x;
-      const double da_y = point[1] - mol[iA].y;
-      const double da_z = point[2] - mol[iA].z;
+      const auto& atom = mol[task_atoms[iA]];
+      const double da_x = point[0] - atom.x;
+      const double da_y = point[1] - atom.y;
+      const double da_z = point[2] - atom.z;
 
       atomDist[iA] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
 
     }
 
     // Evaluate unnormalized partition functions 
-    std::fill(partitionScratch.begin(),partitionScratch.end(),1.);
-    for( size_t iA = 0; iA < natoms; iA++ ) 
-    for( size_t jA = 0; jA < iA;     jA++ )
+    std::fill_n(partitionScratch.begin(),natoms_task,1.);
+    for( size_t iA = 0; iA < natoms_task; iA++ ) 
+    for( size_t jA = 0; jA < iA;          jA++ )
     if( partitionScratch[iA] > integrator::ssf_weight_tol or 
         partitionScratch[jA] > integrator::ssf_weight_tol ) {
 
-      const double mu = (atomDist[iA] - atomDist[jA]) / RAB[jA + iA*natoms];
+      const double mu = (atomDist[iA] - atomDist[jA]) / 
+        RAB[task_atoms[jA] + task_atoms[iA]*natoms];
 
       if( mu <= -integrator::magic_ssf_factor<> ) {
 
@@ -199,12 +238,13 @@ void reference_ssf_weights_host(
 
     // Normalization
     double sum = 0.;
-    for( size_t iA = 0; iA < natoms; iA++ )  sum += partitionScratch[iA];
+    for( size_t iA = 0; iA < natoms_task; iA++ )  sum += partitionScratch[iA];
 
     // Update Weights
-    weight *= partitionScratch[task.iParent] / sum;
+    weight *= partitionScratch[parent_idx] / sum;
 
-  } // Collapsed loop over tasks and points
+  } // Loop over points
+  } // Loop over tasks
 
   } // OMP context
 
@@ -223,9 +263,6 @@ void reference_lko_weights_host(
   std::stable_sort( task_begin, task_end, 
     [](const auto& a, const auto&b ) { return a.iParent < b.iParent; } );
 
-  // Becke partition functions
-  auto hBecke = [](double x) {return 1.5 * x - 0.5 * x * x * x;}; // Eq. 19
-  auto gBecke = [&](double x) {return hBecke(hBecke(hBecke(x)));}; // Eq. 20 f_3
   constexpr double R_cutoff = 5;
 
   const size_t natoms = mol.natoms();
@@ -360,4 +397,195 @@ void reference_lko_weights_host(
 
 }
 
+
+namespace {
+
+/// Weight gradient contribution of a single task with screened atoms
+void weights_gradient_task(
+  XCWeightAlg                 weight_alg,
+  const Molecule&             mol,
+  const MolMeta&              meta,
+  const std::vector<int32_t>& task_atoms,
+  const XCTask&               task,
+  const double*               f,
+  double*                     grad
+) {
+
+  constexpr double a = integrator::magic_ssf_factor<>;
+
+  const size_t natoms = mol.natoms();
+  const size_t npts   = task.points.size();
+  const auto&  RAB    = meta.rab();
+
+  const size_t natoms_task = task_atoms.size();
+  const size_t parent_idx  = std::distance( task_atoms.begin(),
+    std::find( task_atoms.begin(), task_atoms.end(), task.iParent ) );
+
+  // Cell function s(mu) = (1 - g(mu)) / 2 and its derivative
+  auto cell_fn = [&]( double mu, double& s, double& ds ) {
+    if( weight_alg == XCWeightAlg::Becke ) {
+      s  =  0.5 * (1. - gBecke(mu));
+      ds = -0.5 * dgBecke(mu);
+    } else if( mu <= -a ) { s = 1.; ds = 0.; }
+      else if( mu >=  a ) { s = 0.; ds = 0.; }
+      else {
+      s  =  0.5 * (1. - gFrisch(mu));
+      ds = -0.5 * dgFrisch(mu);
+    }
+  };
+
+  // Unit vectors between atom pairs, e_AB = (R_A - R_B) / R_AB
+  std::vector<std::array<double,3>> e_AB( natoms_task * natoms_task );
+  for( size_t iA = 0; iA < natoms_task; ++iA )
+  for( size_t iB = 0; iB < natoms_task; ++iB ) 
+  if( iA != iB ) {
+    const auto& A = mol[task_atoms[iA]];
+    const auto& B = mol[task_atoms[iB]];
+    const double rab = RAB[task_atoms[iB] + task_atoms[iA]*natoms];
+    e_AB[iB + iA*natoms_task] = 
+      { (A.x - B.x) / rab, (A.y - B.y) / rab, (A.z - B.z) / rab };
+  }
+
+  std::vector<double> dist( natoms_task ), P( natoms_task );
+  std::vector<double> mu( natoms_task * natoms_task ); 
+  std::vector<double> t ( natoms_task * natoms_task ); // s'(mu_AB) / s(mu_AB)
+  std::vector<std::array<double,3>> u( natoms_task );  // (r - R_A) / r_A
+  std::vector<std::array<double,3>> dZ( natoms_task ); // d Z / d R_A
+  std::vector<std::array<double,3>> dP( natoms_task ); // d P_parent / d R_A
+
+  for( size_t i = 0; i < npts; ++i ) {
+
+    const double fw = f[i] * task.weights[i];
+    if( fw == 0. ) continue; // P_parent = 0 -> dw = 0
+
+    const auto& point = task.points[i];
+    for( size_t iA = 0; iA < natoms_task; ++iA ) {
+      const auto& A = mol[task_atoms[iA]];
+      const double dx = point[0] - A.x;
+      const double dy = point[1] - A.y;
+      const double dz = point[2] - A.z;
+      dist[iA] = std::sqrt( dx*dx + dy*dy + dz*dz );
+      u[iA] = { dx / dist[iA], dy / dist[iA], dz / dist[iA] };
+    }
+
+    // Unnormalized partition functions
+    std::fill( P.begin(), P.end(), 1. );
+    for( size_t iA = 0; iA < natoms_task; ++iA ) 
+    for( size_t iB = 0; iB < iA;          ++iB ) {
+      const double rab = RAB[task_atoms[iB] + task_atoms[iA]*natoms];
+      const double mu_AB = (dist[iA] - dist[iB]) / rab;
+
+      double s, ds;
+      cell_fn( mu_AB, s, ds );
+      P[iA] *= s;
+      P[iB] *= 1. - s;
+
+      // s(mu_BA) = 1 - s(mu_AB) and s'(mu_BA) = s'(mu_AB)
+      mu[iB + iA*natoms_task] =  mu_AB;
+      mu[iA + iB*natoms_task] = -mu_AB;
+      t [iB + iA*natoms_task] = s      > 0. ? ds / s        : 0.;
+      t [iA + iB*natoms_task] = 1. - s > 0. ? ds / (1. - s) : 0.;
+    }
+
+    const double Z = std::accumulate( P.begin(), P.end(), 0. );
+
+    // d P_A / d R_C = P_A sum_{B != A} t_AB d mu_AB / d R_C with
+    //   d mu_AB / d R_A = -(u_A + mu_AB e_AB) / R_AB
+    //   d mu_AB / d R_B =  (u_B + mu_AB e_AB) / R_AB
+    std::fill( dZ.begin(), dZ.end(), std::array<double,3>{0., 0., 0.} );
+    std::fill( dP.begin(), dP.end(), std::array<double,3>{0., 0., 0.} );
+    for( size_t iA = 0; iA < natoms_task; ++iA ) 
+    if( P[iA] > 0. ) {
+      for( size_t iB = 0; iB < natoms_task; ++iB ) 
+      if( iB != iA ) {
+        const double rab = RAB[task_atoms[iB] + task_atoms[iA]*natoms];
+        const double q   = t[iB + iA*natoms_task] / rab;
+        if( q == 0. ) continue;
+
+        const double  m = mu[iB + iA*natoms_task];
+        const auto&   e = e_AB[iB + iA*natoms_task];
+        for( int d = 0; d < 3; ++d ) {
+          const double dA = -q * (u[iA][d] + m * e[d]);
+          const double dB =  q * (u[iB][d] + m * e[d]);
+          dZ[iA][d] += P[iA] * dA;
+          dZ[iB][d] += P[iA] * dB;
+          if( iA == parent_idx ) dP[iB][d] += dB; // / P_parent
+        }
+      }
+    }
+
+    // d w / d R_A = w * ( (d P_parent / d R_A) / P_parent - (d Z / d R_A) / Z )
+    // for A != parent, the parent term follows from translational invariance
+    std::array<double,3> g_parent = {0., 0., 0.};
+    for( size_t iA = 0; iA < natoms_task; ++iA ) 
+    if( iA != parent_idx ) {
+      auto* g_A = grad + 3*task_atoms[iA];
+      for( int d = 0; d < 3; ++d ) {
+        const double g = fw * (dP[iA][d] - dZ[iA][d] / Z);
+        g_A[d]      += g;
+        g_parent[d] -= g;
+      }
+    }
+    for( int d = 0; d < 3; ++d ) grad[3*task.iParent + d] += g_parent[d];
+
+  } // Loop over points
+
+}
+
+}
+
+void reference_weights_gradient_host(
+  XCWeightAlg            weight_alg,
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end,
+  const double*          f,
+  double*                grad
+) {
+
+  if( weight_alg != XCWeightAlg::Becke and weight_alg != XCWeightAlg::SSF )
+    GAUXC_GENERIC_EXCEPTION("Weight Gradient Not Implemented For Weight Alg");
+
+  const size_t natoms = mol.natoms();
+  const size_t ntasks = std::distance( task_begin, task_end );
+
+  // Offsets of the task integrands
+  std::vector<size_t> f_offset( ntasks + 1, 0 );
+  for( size_t iT = 0; iT < ntasks; ++iT ) 
+    f_offset[iT+1] = f_offset[iT] + (task_begin + iT)->points.size();
+
+  // Shared by all tasks
+  const AtomCellList cell_list( mol );
+
+  #pragma omp parallel
+  {
+
+  // Atoms with nonvanishing cell functions (or derivatives thereof). 
+  // SSF screened atoms only contribute constant factors of 0 or 1
+  SSFTaskScreening screen_task( cell_list, meta );
+  std::vector<int32_t> task_atoms;
+  if( weight_alg == XCWeightAlg::Becke ) {
+    task_atoms.resize( natoms );
+    std::iota( task_atoms.begin(), task_atoms.end(), 0 );
+  }
+
+  std::vector<double> grad_local( 3*natoms, 0. );
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+    const auto& task = *(task_begin + iT);
+    if( weight_alg == XCWeightAlg::SSF and 
+        not screen_task( task, task_atoms ) ) continue;
+    weights_gradient_task( weight_alg, mol, meta, task_atoms, task, 
+      f + f_offset[iT], grad_local.data() );
+  }
+
+  #pragma omp critical
+  for( size_t i = 0; i < 3*natoms; ++i ) grad[i] += grad_local[i];
+
+  } // OMP context
+
+}
+
 }
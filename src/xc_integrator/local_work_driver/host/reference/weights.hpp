@@ -32,4 +32,44 @@ void reference_lko_weights_host(
   task_iterator          task_end
 );
 
+/** Partition weights evaluated on SIMD blocks of points
+ *
+ *  Points are processed in structure-of-arrays blocks, cell functions are
+ *  updated branch-free across the block. SSF weights share the per-task
+ *  atom screening of reference_ssf_weights_host, points within the weight-1
+ *  radius of the parent are masked out and blocks without remaining
+ *  points are skipped. Results agree with the reference kernels to
+ *  roundoff.
+ */
+void native_ssf_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
+void native_becke_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
+/** Partition weight contribution to the nuclear gradient of sum_i f_i w_i
+ *
+ *  Grid points move with their parent atom. Derivatives are evaluated
+ *  from the cell functions of the (SSF screened) atoms of each task, the
+ *  atom screening is set up once for all tasks. f is concatenated in task
+ *  order. Increments grad (3*natoms).
+ */
+void reference_weights_gradient_host(
+  XCWeightAlg            weight_alg,
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end,
+  const double*          f,
+  double*                grad
+);
+
 }
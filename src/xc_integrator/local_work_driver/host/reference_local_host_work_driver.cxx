@@ -13,6 +13,8 @@
 #include "host/util.hpp"
 #include "host/blas.hpp"
 #include <stdexcept>
+#include <algorithm>
+#include <vector>
 
 #include <gauxc/basisset_map.hpp>
 #include <gauxc/shell_pair.hpp>
@@ -25,6 +27,79 @@
 
 namespace GauXC {
 
+namespace {
+
+  // Single precision operand / result buffers for mixed precision GEMMs
+  thread_local std::vector<float> sp_a_scr, sp_b_scr, sp_c_scr;
+
+  // Single precision copy of the collocation matrix of the task in flight
+  struct sp_basis_type {
+    const double*      ptr  = nullptr;
+    size_t             npts = 0;
+    size_t             nbe  = 0;
+    std::vector<float> data;
+  };
+  thread_local sp_basis_type sp_basis;
+
+  // Copy a (M,N) double matrix into a packed single precision buffer, the
+  // registered collocation matrix is returned without conversion
+  const float* to_single( int M, int N, const double* A, int LDA, 
+    std::vector<float>& scr ) {
+    if( A == sp_basis.ptr and size_t(M) == sp_basis.nbe and 
+        size_t(N) == sp_basis.npts and LDA == M ) 
+      return sp_basis.data.data();
+
+    scr.resize( size_t(M) * N );
+    for( int j = 0; j < N; ++j )
+    for( int i = 0; i < M; ++i )
+      scr[ i + size_t(j)*M ] = A[ i + size_t(j)*LDA ];
+    return scr.data();
+  }
+
+  // C = ALPHA * op(A) * op(B) with single precision operands, C in double
+  void gemm_mixed( char TA, char TB, int M, int N, int K, double ALPHA,
+    const double* A, int LDA, const double* B, int LDB, double* C, int LDC ) {
+
+    const int MA = TA == 'N' ? M : K;
+    const int NA = TA == 'N' ? K : M;
+    const int MB = TB == 'N' ? K : N;
+    const int NB = TB == 'N' ? N : K;
+
+    const auto* A_sp = to_single( MA, NA, A, LDA, sp_a_scr );
+    const auto* B_sp = to_single( MB, NB, B, LDB, sp_b_scr );
+    sp_c_scr.resize( size_t(M) * N );
+
+    blas::gemm( TA, TB, M, N, K, float(ALPHA), A_sp, MA, B_sp, MB, 0.f, 
+      sp_c_scr.data(), M );
+
+    for( int j = 0; j < N; ++j )
+    for( int i = 0; i < M; ++i )
+      C[ i + size_t(j)*LDC ] = sp_c_scr[ i + size_t(j)*M ];
+
+  }
+
+  // LT of C (+)= A * B**T + B * A**T with single precision operands, C in double
+  void syr2k_mixed( int N, int K, const double* A, int LDA, const double* B, 
+    int LDB, double* C, int LDC, bool accumulate ) {
+
+    const auto* A_sp = to_single( N, K, A, LDA, sp_a_scr );
+    const auto* B_sp = to_single( N, K, B, LDB, sp_b_scr );
+    sp_c_scr.resize( size_t(N) * N );
+
+    blas::syr2k( 'L', 'N', N, K, 1.f, A_sp, N, B_sp, N, 0.f, sp_c_scr.data(),
+      N );
+
+    for( int j = 0; j < N; ++j )
+    for( int i = j; i < N; ++i ) {
+      const double c = sp_c_scr[ i + size_t(j)*N ];
+      if( accumulate ) C[ i + size_t(j)*LDC ] += c;
+      else             C[ i + size_t(j)*LDC ]  = c;
+    }
+
+  }
+
+}
+
   ReferenceLocalHostWorkDriver::ReferenceLocalHostWorkDriver() {
     this->boys_table = XCPU::boys_init();
   }
@@ -33,6 +108,27 @@ namespace GauXC {
     XCPU::boys_finalize(this->boys_table);
   }
 
+  // Single precision collocation matrix
+  void ReferenceLocalHostWorkDriver::register_single_precision_basis( 
+    size_t npts, size_t nbe, const double* basis_eval ) {
+
+    release_single_precision_basis();
+    if( not mixed_precision_ ) return;
+
+    sp_basis.data.resize( npts * nbe );
+    std::copy( basis_eval, basis_eval + npts*nbe, sp_basis.data.begin() );
+    sp_basis.ptr  = basis_eval;
+    sp_basis.npts = npts;
+    sp_basis.nbe  = nbe;
+
+  }
+
+  void ReferenceLocalHostWorkDriver::release_single_precision_basis() {
+    sp_basis.ptr  = nullptr;
+    sp_basis.npts = 0;
+    sp_basis.nbe  = 0;
+  }
+
   // Partition weights
   void ReferenceLocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg, 
 							const Molecule& mol, const MolMeta& meta, task_iterator task_begin, 
@@ -52,6 +148,14 @@ namespace GauXC {
     }
   }
 
+  void ReferenceLocalHostWorkDriver::eval_weight_gradient( 
+    XCWeightAlg weight_alg, const Molecule& mol, const MolMeta& meta, 
+    task_iterator task_begin, task_iterator task_end, const double* f, 
+    double* grad ) {
+    reference_weights_gradient_host( weight_alg, mol, meta, task_begin, 
+      task_end, f, grad );
+  }
+
 
   // Collocation
   void ReferenceLocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, 
@@ -98,8 +202,39 @@ namespace GauXC {
       P_use = P + submat_map[0][0]*(ldp+1);
     }
 
-    blas::gemm( 'N', 'N', nbe, npts, nbe, 2., P_use, ldp_use, basis_eval, ldb, 
-		0., X, ldx );
+    if( mixed_precision_ )
+      gemm_mixed( 'N', 'N', nbe, npts, nbe, 2., P_use, ldp_use, basis_eval, ldb,
+        X, ldx );
+    else
+      blas::gemm( 'N', 'N', nbe, npts, nbe, 2., P_use, ldp_use, basis_eval, ldb, 
+		  0., X, ldx );
+
+  }
+
+  // Batched X matrices (P_k * B)
+  void ReferenceLocalHostWorkDriver::eval_xmat_batched( size_t ndm, size_t npts, 
+    size_t nbf, size_t nbe, const submat_map_t& submat_map, 
+    const double* const* P, size_t ldp, const double* basis_eval, size_t ldb, 
+    double* X, size_t ldx, double* scr ) {
+
+    // Stack the density submatrices: scr = [P_0; P_1; ...] (ndm*nbe, nbe)
+    const size_t ldscr = ndm * nbe;
+    for( size_t k = 0; k < ndm; ++k ) {
+      if( submat_map.size() > 1 ) {
+        detail::submat_set( nbf, nbf, nbe, nbe, P[k], ldp, scr + k*nbe, ldscr, 
+          submat_map );
+      } else {
+        blas::lacpy( 'A', nbe, nbe, P[k] + submat_map[0][0]*(ldp+1), ldp, 
+          scr + k*nbe, ldscr );
+      }
+    }
+
+    if( mixed_precision_ )
+      gemm_mixed( 'N', 'N', ldscr, npts, nbe, 2., scr, ldscr, basis_eval, ldb,
+        X, ldx );
+    else
+      blas::gemm( 'N', 'N', ldscr, npts, nbe, 2., scr, ldscr, basis_eval, ldb, 
+        0., X, ldx );
 
   }
 
@@ -108,8 +243,8 @@ namespace GauXC {
 						     const double* basis_eval, const double* X, size_t ldx, double* den_eval) {
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
-      const size_t ioff = size_t(i) * ldx;
-      const auto*   X_i = X + ioff;
+      const size_t ioff = size_t(i) * nbe;
+      const auto*   X_i = X + size_t(i) * ldx;
       den_eval[i] = blas::dot( nbe, basis_eval + ioff, 1, X_i, 1 );
       
     }
@@ -125,8 +260,8 @@ namespace GauXC {
 
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
-      const size_t ioff = size_t(i) * ldx;
-      const auto*   X_i = X + ioff;
+      const size_t ioff = size_t(i) * nbe;
+      const auto*   X_i = X + size_t(i) * ldx;
 
       den_eval[i] = blas::dot( nbe, basis_eval + ioff, 1, X_i, 1 );
 
@@ -143,6 +278,89 @@ namespace GauXC {
     }
   }
 
+  // Collocation + X + U/V variables LDA (unfused)
+  void ReferenceLocalHostWorkDriver::eval_collocation_uvvar_lda( size_t npts, 
+						     size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+						     const int32_t* shell_list, size_t nbf, const submat_map_t& submat_map, 
+						     const double* P, size_t ldp, double* basis_eval, double* X, size_t ldx, 
+						     double* den_eval, double* scr ) {
+
+    eval_collocation( npts, nshells, nbe, pts, basis, shell_list, basis_eval );
+    eval_xmat( npts, nbf, nbe, submat_map, P, ldp, basis_eval, nbe, X, ldx, scr );
+    eval_uvvar_lda( npts, nbe, basis_eval, X, ldx, den_eval );
+
+  }
+
+  // Collocation Gradient + X + U/V variables GGA (unfused)
+  void ReferenceLocalHostWorkDriver::eval_collocation_uvvar_gga( size_t npts, 
+						     size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+						     const int32_t* shell_list, size_t nbf, const submat_map_t& submat_map, 
+						     const double* P, size_t ldp, double* basis_eval, double* dbasis_x_eval, 
+						     double* dbasis_y_eval, double* dbasis_z_eval, double* X, size_t ldx, 
+						     double* den_eval, double* dden_x_eval, double* dden_y_eval, 
+						     double* dden_z_eval, double* gamma, double* scr ) {
+
+    eval_collocation_gradient( npts, nshells, nbe, pts, basis, shell_list, 
+      basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+    eval_xmat( npts, nbf, nbe, submat_map, P, ldp, basis_eval, nbe, X, ldx, scr );
+    eval_uvvar_gga( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval, 
+      dbasis_z_eval, X, ldx, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
+      gamma );
+
+  }
+
+  // U/VVar LDA UKS (spin densities)
+  void ReferenceLocalHostWorkDriver::eval_uvvar_lda_uks( size_t npts, size_t nbe, 
+    const double* basis_eval, const double* Xa, size_t ldxa, const double* Xb, 
+    size_t ldxb, double* den_eval ) {
+
+    // X_s = 2 * P_s * B -> rho_s = 0.5 * B**T * X_s
+    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
+
+      const auto* B_i = basis_eval + size_t(i) * nbe;
+      den_eval[2*i]   = 0.5 * blas::dot( nbe, B_i, 1, Xa + size_t(i)*ldxa, 1 );
+      den_eval[2*i+1] = 0.5 * blas::dot( nbe, B_i, 1, Xb + size_t(i)*ldxb, 1 );
+
+    }
+
+  }
+
+  // U/VVar GGA UKS (spin densities + grad, gamma)
+  void ReferenceLocalHostWorkDriver::eval_uvvar_gga_uks( size_t npts, size_t nbe, 
+    const double* basis_eval, const double* dbasis_x_eval, 
+    const double *dbasis_y_eval, const double* dbasis_z_eval, const double* Xa, 
+    size_t ldxa, const double* Xb, size_t ldxb, double* den_eval, 
+    double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, 
+    double* gamma ) {
+
+    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
+
+      const size_t ioff = size_t(i) * nbe;
+      const auto* Xa_i = Xa + size_t(i) * ldxa;
+      const auto* Xb_i = Xb + size_t(i) * ldxb;
+
+      den_eval[2*i]   = 0.5 * blas::dot( nbe, basis_eval + ioff, 1, Xa_i, 1 );
+      den_eval[2*i+1] = 0.5 * blas::dot( nbe, basis_eval + ioff, 1, Xb_i, 1 );
+
+      const auto dax = blas::dot( nbe, dbasis_x_eval + ioff, 1, Xa_i, 1 );
+      const auto day = blas::dot( nbe, dbasis_y_eval + ioff, 1, Xa_i, 1 );
+      const auto daz = blas::dot( nbe, dbasis_z_eval + ioff, 1, Xa_i, 1 );
+      const auto dbx = blas::dot( nbe, dbasis_x_eval + ioff, 1, Xb_i, 1 );
+      const auto dby = blas::dot( nbe, dbasis_y_eval + ioff, 1, Xb_i, 1 );
+      const auto dbz = blas::dot( nbe, dbasis_z_eval + ioff, 1, Xb_i, 1 );
+
+      dden_x_eval[2*i] = dax; dden_x_eval[2*i+1] = dbx;
+      dden_y_eval[2*i] = day; dden_y_eval[2*i+1] = dby;
+      dden_z_eval[2*i] = daz; dden_z_eval[2*i+1] = dbz;
+
+      gamma[3*i]   = dax*dax + day*day + daz*daz;
+      gamma[3*i+1] = dax*dbx + day*dby + daz*dbz;
+      gamma[3*i+2] = dbx*dbx + dby*dby + dbz*dbz;
+
+    }
+
+  }
+
   // Eval Z Matrix LDA VXC
   void ReferenceLocalHostWorkDriver::eval_zmat_lda_vxc( size_t npts, size_t nbf, 
 							const double* vrho, const double* basis_eval, double* Z, size_t ldz ) {
@@ -196,12 +414,137 @@ namespace GauXC {
 
   }
 
+  // Eval Z Matrices LDA VXC UKS
+  void ReferenceLocalHostWorkDriver::eval_zmat_lda_vxc_uks( size_t npts, size_t nbf, 
+    const double* vrho, const double* basis_eval, double* Za, size_t ldza, 
+    double* Zb, size_t ldzb ) {
+
+    blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Za, ldza );
+    blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Zb, ldzb );
+
+    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
+      blas::scal( nbf, 0.5 * vrho[2*i],   Za + i*ldza, 1 );
+      blas::scal( nbf, 0.5 * vrho[2*i+1], Zb + i*ldzb, 1 );
+    }
+
+  }
+
+  // Eval Z Matrices GGA VXC UKS
+  void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_uks( size_t npts, size_t nbf, 
+    const double* vrho, const double* vgamma, const double* basis_eval, 
+    const double* dbasis_x_eval, const double* dbasis_y_eval, 
+    const double* dbasis_z_eval, const double* dden_x_eval, 
+    const double* dden_y_eval, const double* dden_z_eval, double* Za, 
+    size_t ldza, double* Zb, size_t ldzb ) {
+
+    eval_zmat_lda_vxc_uks( npts, nbf, vrho, basis_eval, Za, ldza, Zb, ldzb );
+
+    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
+
+      const int32_t ioff = i * nbf;
+
+      auto* za_col   = Za + i*ldza;
+      auto* zb_col   = Zb + i*ldzb;
+      auto* bf_x_col = dbasis_x_eval + ioff; 
+      auto* bf_y_col = dbasis_y_eval + ioff; 
+      auto* bf_z_col = dbasis_z_eval + ioff; 
+
+      const auto vaa = vgamma[3*i];
+      const auto vab = vgamma[3*i+1];
+      const auto vbb = vgamma[3*i+2];
+
+      const auto dax = dden_x_eval[2*i], dbx = dden_x_eval[2*i+1];
+      const auto day = dden_y_eval[2*i], dby = dden_y_eval[2*i+1];
+      const auto daz = dden_z_eval[2*i], dbz = dden_z_eval[2*i+1];
+
+      blas::axpy( nbf, 2.*vaa*dax + vab*dbx, bf_x_col, 1, za_col, 1 );
+      blas::axpy( nbf, 2.*vaa*day + vab*dby, bf_y_col, 1, za_col, 1 );
+      blas::axpy( nbf, 2.*vaa*daz + vab*dbz, bf_z_col, 1, za_col, 1 );
+
+      blas::axpy( nbf, 2.*vbb*dbx + vab*dax, bf_x_col, 1, zb_col, 1 );
+      blas::axpy( nbf, 2.*vbb*dby + vab*day, bf_y_col, 1, zb_col, 1 );
+      blas::axpy( nbf, 2.*vbb*dbz + vab*daz, bf_z_col, 1, zb_col, 1 );
+
+    }
+
+  }
+
+  // Eval Z Matrix LDA FXC
+  void ReferenceLocalHostWorkDriver::eval_zmat_lda_fxc( size_t npts, size_t nbf, 
+    const double* v2rho2, const double* basis_eval, const double* den1_eval, 
+    double* Z, size_t ldz ) {
+
+    blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Z, ldz );
+
+    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
+
+      auto* z_col = Z + i*ldz;
+
+      const double fact = 0.5 * v2rho2[i] * den1_eval[i];
+      GauXC::blas::scal( nbf, fact, z_col, 1 );
+
+    }
+
+  }
+
+  // Eval Z Matrix GGA FXC
+  void ReferenceLocalHostWorkDriver::eval_zmat_gga_fxc( size_t npts, size_t nbf, 
+    const double* vgamma, const double* v2rho2, const double* v2rhogamma, 
+    const double* v2gamma2, const double* basis_eval, const double* dbasis_x_eval,
+    const double* dbasis_y_eval, const double* dbasis_z_eval, 
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    const double* den1_eval, const double* dden1_x_eval, const double* dden1_y_eval,
+    const double* dden1_z_eval, double* Z, size_t ldz ) {
+
+    blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Z, ldz );
+
+    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
+
+      const int32_t ioff = i * nbf;
+
+      auto* z_col    = Z + i*ldz;
+      auto* bf_x_col = dbasis_x_eval + ioff; 
+      auto* bf_y_col = dbasis_y_eval + ioff; 
+      auto* bf_z_col = dbasis_z_eval + ioff; 
+
+      // Perturbed gamma
+      const auto gamma1 = 2. * ( dden_x_eval[i] * dden1_x_eval[i] + 
+                                 dden_y_eval[i] * dden1_y_eval[i] +
+                                 dden_z_eval[i] * dden1_z_eval[i] );
+
+      const auto lda_fact = 0.5 * ( v2rho2[i] * den1_eval[i] + 
+                                    v2rhogamma[i] * gamma1 );
+      blas::scal( nbf, lda_fact, z_col, 1 );
+
+      const auto gga_fact  = 2. * ( v2rhogamma[i] * den1_eval[i] + 
+                                    v2gamma2[i] * gamma1 );
+      const auto gga1_fact = 2. * vgamma[i];
+      const auto x_fact = gga_fact * dden_x_eval[i] + gga1_fact * dden1_x_eval[i];
+      const auto y_fact = gga_fact * dden_y_eval[i] + gga1_fact * dden1_y_eval[i];
+      const auto z_fact = gga_fact * dden_z_eval[i] + gga1_fact * dden1_z_eval[i];
+
+      blas::axpy( nbf, x_fact, bf_x_col, 1, z_col, 1 );
+      blas::axpy( nbf, y_fact, bf_y_col, 1, z_col, 1 );
+      blas::axpy( nbf, z_fact, bf_z_col, 1, z_col, 1 );
+
+    }
+
+  }
+
   // Increment VXC by Z
   void ReferenceLocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe, 
 					      const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
 					      size_t ldz, double* VXC, size_t ldvxc, double* scr ) {
 
-    if( submat_map.size() > 1 ) {
+    if( mixed_precision_ ) {
+      if( submat_map.size() > 1 ) {
+        syr2k_mixed( nbe, npts, basis_eval, nbe, Z, ldz, scr, nbe, false );
+        detail::inc_by_submat( nbf, nbf, nbe, nbe, VXC, ldvxc, scr, nbe, submat_map );
+      } else {
+        syr2k_mixed( nbe, npts, basis_eval, nbe, Z, ldz, 
+          VXC + submat_map[0][0]*(ldvxc+1), ldvxc, true );
+      }
+    } else if( submat_map.size() > 1 ) {
       blas::syr2k('L', 'N', nbe, npts, 1., basis_eval, nbe, Z, ldz, 0., scr, nbe );
       detail::inc_by_submat( nbf, nbf, nbe, nbe, VXC, ldvxc, scr, nbe, submat_map );
     } else {
@@ -211,6 +554,38 @@ namespace GauXC {
 
   }
 
+  // Increment a batch of VXC by stacked Z
+  void ReferenceLocalHostWorkDriver::inc_vxc_batched( size_t ndm, size_t npts, 
+    size_t nbf, size_t nbe, const double* basis_eval, 
+    const submat_map_t& submat_map, const double* Z, size_t ldz, 
+    double* const* VXC, size_t ldvxc, double* scr ) {
+
+    // [Z_0; Z_1; ...] * B**H in a single GEMM
+    const size_t ldscr = ndm * nbe;
+    if( mixed_precision_ )
+      gemm_mixed( 'N', 'T', ldscr, nbe, npts, 1., Z, ldz, basis_eval, nbe, 
+        scr, ldscr );
+    else
+      blas::gemm( 'N', 'T', ldscr, nbe, npts, 1., Z, ldz, basis_eval, nbe, 0.,
+        scr, ldscr );
+
+    for( size_t k = 0; k < ndm; ++k ) {
+
+      // Form the LT of Z_k * B**H + h.c. in place
+      auto* scr_k = scr + k*nbe;
+      for( size_t j = 0; j < nbe; ++j ) {
+        scr_k[ j + j*ldscr ] *= 2.;
+        for( size_t i = j+1; i < nbe; ++i )
+          scr_k[ i + j*ldscr ] += scr_k[ j + i*ldscr ];
+      }
+
+      detail::inc_by_submat( nbf, nbf, nbe, nbe, VXC[k], ldvxc, scr_k, ldscr,
+        submat_map );
+
+    }
+
+  }
+
   // Increment K by G
   void ReferenceLocalHostWorkDriver::inc_exx_k( size_t npts, size_t nbf, 
 						size_t nbe_bra, size_t nbe_ket, const double* basis_eval, 
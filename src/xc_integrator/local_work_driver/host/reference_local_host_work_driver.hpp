@@ -27,8 +27,15 @@ struct ReferenceLocalHostWorkDriver : public detail::LocalHostWorkDriverPIMPL {
 
   // Public APIs
 
+  void register_single_precision_basis( size_t npts, size_t nbe,
+    const double* basis_eval ) override;
+  void release_single_precision_basis() override;
+
   void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
     const MolMeta& meta, task_iterator task_begin, task_iterator task_end ) override;
+  void eval_weight_gradient( XCWeightAlg weight_alg, const Molecule& mol,
+    const MolMeta& meta, task_iterator task_begin, task_iterator task_end, 
+    const double* f, double* grad ) override;
 
   void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
@@ -48,6 +55,10 @@ struct ReferenceLocalHostWorkDriver : public detail::LocalHostWorkDriverPIMPL {
     const submat_map_t& submat_map, const double* P, size_t ldp, 
     const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) 
     override;
+  void eval_xmat_batched( size_t ndm, size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, const double* const* P, size_t ldp, 
+    const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) 
+    override;
 
   void eval_exx_gmat( size_t npts, size_t nshells, size_t nshell_pairs,
     size_t nbe, const double* points, const double* weights, 
@@ -75,6 +86,28 @@ struct ReferenceLocalHostWorkDriver : public detail::LocalHostWorkDriverPIMPL {
     double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, 
     double* gamma ) override;
 
+  void eval_uvvar_lda_uks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* Xa, size_t ldxa, const double* Xb, size_t ldxb, 
+    double* den_eval ) override;
+  void eval_uvvar_gga_uks( size_t npts, size_t nbe, const double* basis_eval,
+    const double* dbasis_x_eval, const double *dbasis_y_eval, 
+    const double* dbasis_z_eval, const double* Xa, size_t ldxa, 
+    const double* Xb, size_t ldxb, double* den_eval, double* dden_x_eval, 
+    double* dden_y_eval, double* dden_z_eval, double* gamma ) override;
+
+  void eval_collocation_uvvar_lda( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    size_t nbf, const submat_map_t& submat_map, const double* P, size_t ldp,
+    double* basis_eval, double* X, size_t ldx, double* den_eval, 
+    double* scr ) override;
+  void eval_collocation_uvvar_gga( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list,
+    size_t nbf, const submat_map_t& submat_map, const double* P, size_t ldp,
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* X, size_t ldx, double* den_eval, 
+    double* dden_x_eval, double* dden_y_eval, double* dden_z_eval, 
+    double* gamma, double* scr ) override;
+
   void eval_zmat_lda_vxc( size_t npts, size_t nbe, const double* vrho, 
     const double* basis_eval, double* Z, size_t ldz ) override;
   void eval_zmat_gga_vxc( size_t npts, size_t nbe, const double* vrho, 
@@ -83,11 +116,35 @@ struct ReferenceLocalHostWorkDriver : public detail::LocalHostWorkDriverPIMPL {
     const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
     double* Z, size_t ldz ) override;
 
+  void eval_zmat_lda_vxc_uks( size_t npts, size_t nbe, const double* vrho, 
+    const double* basis_eval, double* Za, size_t ldza, double* Zb, 
+    size_t ldzb ) override;
+  void eval_zmat_gga_vxc_uks( size_t npts, size_t nbe, const double* vrho, 
+    const double* vgamma, const double* basis_eval, const double* dbasis_x_eval,
+    const double* dbasis_y_eval, const double* dbasis_z_eval, 
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    double* Za, size_t ldza, double* Zb, size_t ldzb ) override;
+
+  void eval_zmat_lda_fxc( size_t npts, size_t nbe, const double* v2rho2, 
+    const double* basis_eval, const double* den1_eval, double* Z, size_t ldz ) override;
+
+  void eval_zmat_gga_fxc( size_t npts, size_t nbe, const double* vgamma,
+    const double* v2rho2, const double* v2rhogamma, const double* v2gamma2,
+    const double* basis_eval, const double* dbasis_x_eval, 
+    const double* dbasis_y_eval, const double* dbasis_z_eval, 
+    const double* dden_x_eval, const double* dden_y_eval, const double* dden_z_eval,
+    const double* den1_eval, const double* dden1_x_eval, 
+    const double* dden1_y_eval, const double* dden1_z_eval, double* Z, 
+    size_t ldz ) override;
 
   void inc_vxc( size_t npts, size_t nbf, size_t nbe, 
     const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
     size_t ldz, double* VXC, size_t ldvxc, double* scr ) override;
 
+  void inc_vxc_batched( size_t ndm, size_t npts, size_t nbf, size_t nbe, 
+    const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
+    size_t ldz, double* const* VXC, size_t ldvxc, double* scr ) override;
+
 };
 
 }
@@ -17,10 +17,16 @@ namespace detail {
 template <typename ValueType>
 void IncoreReplicatedXCDeviceIntegrator<ValueType>::
   eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
-                 int64_t ldp, value_type* EXC_GRAD ) { 
+                 int64_t ldp, value_type* EXC_GRAD, 
+                 const IntegratorSettingsXC& settings ) { 
                  
   const auto& basis = this->load_balancer_->basis();
 
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsEXCGrad*>(&settings) ) {
+    if( tmp->weight_derivatives )
+      GAUXC_GENERIC_EXCEPTION("Device EXC Grad + Weight Derivatives NYI");
+  }
+
   // Check that P is sane
   const int64_t nbf = basis.nbf();
   if( m != n ) 
@@ -187,7 +187,8 @@ void IncoreReplicatedXCDeviceIntegrator<ValueType>::
   );
   exx_ek_screening( basis, basis_map, P_abs.data(), basis.nbf(),
     V_max.data(), nshells, sn_link_settings.energy_tol, 
-    sn_link_settings.k_tol, &host_lwd, task_begin, task_end );
+    sn_link_settings.k_tol, &host_lwd, host_data_maxima( *this->load_balancer_ ),
+    task_begin, task_end );
 #endif
 
   //this->load_balancer_->rebalance_exx();
@@ -44,10 +44,17 @@ protected:
 
   void eval_exc_vxc_( int64_t m, int64_t n, const value_type* P,
                       int64_t ldp, value_type* VXC, int64_t ldvxc,
-                      value_type* EXC ) override;
+                      value_type* EXC, const IntegratorSettingsXC& settings ) override;
+
+  void eval_exc_vxc_( int64_t m, int64_t n, const value_type* Pa,
+                      int64_t ldpa, const value_type* Pb, int64_t ldpb,
+                      value_type* VXCa, int64_t ldvxca, value_type* VXCb,
+                      int64_t ldvxcb, value_type* EXC, 
+                      const IntegratorSettingsXC& settings ) override;
 
   void eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
-                       int64_t ldp, value_type* EXC_GRAD ) override;
+                       int64_t ldp, value_type* EXC_GRAD, 
+                       const IntegratorSettingsXC& settings ) override;
 
   void eval_exx_( int64_t m, int64_t n, const value_type* P,
                   int64_t ldp, value_type* K, int64_t ldk,
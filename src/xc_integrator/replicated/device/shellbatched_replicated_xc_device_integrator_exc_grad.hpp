@@ -26,10 +26,11 @@ namespace detail {
 template <typename ValueType>
 void ShellBatchedReplicatedXCDeviceIntegrator<ValueType>::
   eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
-                 int64_t ldp, value_type* EXC_GRAD ) { 
+                 int64_t ldp, value_type* EXC_GRAD, 
+                 const IntegratorSettingsXC& settings ) { 
                  
   GAUXC_GENERIC_EXCEPTION("NYI" );                 
-  util::unused(m,n,P,ldp,EXC_GRAD);
+  util::unused(m,n,P,ldp,EXC_GRAD,settings);
 }
 
 }
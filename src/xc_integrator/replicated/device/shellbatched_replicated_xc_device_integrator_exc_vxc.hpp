@@ -23,11 +23,24 @@ namespace GauXC  {
 namespace detail {
 
 
+template <typename ValueType>
+void ShellBatchedReplicatedXCDeviceIntegrator<ValueType>::
+  eval_exc_vxc_( int64_t, int64_t, const value_type*, int64_t, 
+                 const value_type*, int64_t, value_type*, int64_t, 
+                 value_type*, int64_t, value_type*, 
+                 const IntegratorSettingsXC& ) {
+
+  GAUXC_GENERIC_EXCEPTION("UKS EXC/VXC NYI for Device Integration");
+
+}
+
 template <typename ValueType>
 void ShellBatchedReplicatedXCDeviceIntegrator<ValueType>::
   eval_exc_vxc_( int64_t m, int64_t n, const value_type* P,
                  int64_t ldp, value_type* VXC, int64_t ldvxc,
-                 value_type* EXC ) {
+                 value_type* EXC, const IntegratorSettingsXC& settings ) {
+
+  (void)(settings); // Host accumulation settings do not apply here
 
 
   const auto& basis = this->load_balancer_->basis();
@@ -0,0 +1,192 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/xc_task.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace GauXC  {
+namespace detail {
+
+/**
+ *  @brief Cache of task collocation matrices (and gradients) which persists
+ *  across integrator invocations.
+ *
+ *  Entries are keyed on the task identifier assigned by the LoadBalancer
+ *  (with the extent of the task as a safeguard) and stored either in double
+ *  or single precision. Identifiers are only valid for a given task
+ *  generation of the LoadBalancer, the cache is cleared whenever the
+ *  generation changes (rebalance, compaction, geometry updates). Entries
+ *  are only admitted while the total storage remains within the byte
+ *  budget, tasks which do not fit are recomputed by the caller.
+ *
+ *  Concurrent load/store from multiple threads is supported.
+ */
+class CollocationCache {
+
+  struct key_type {
+    int64_t task_id;
+    int32_t npts;
+    int32_t nbe;
+
+    key_type( const XCTask& task ) :
+      task_id( task.task_id ), npts( task.points.size() ),
+      nbe( task.bfn_screening.nbe ) { }
+
+    bool operator==( const key_type& other ) const {
+      return task_id == other.task_id and npts == other.npts and 
+        nbe == other.nbe;
+    }
+  };
+
+  struct key_hash {
+    size_t operator()( const key_type& k ) const {
+      size_t seed = 0;
+      auto combine = [&]( size_t h ) {
+        seed ^= h + 0x9e3779b97f4a7c15ul + (seed << 6) + (seed >> 2);
+      };
+      combine( std::hash<int64_t>()(k.task_id) );
+      combine( std::hash<int32_t>()(k.npts)    );
+      combine( std::hash<int32_t>()(k.nbe)     );
+      return seed;
+    }
+  };
+
+  struct entry_type {
+    int32_t             ncomp; ///< 1 = B, 4 = B + grad B
+    std::vector<double> data_dp;
+    std::vector<float>  data_sp;
+  };
+
+  size_t max_bytes_;
+  bool   single_precision_;
+  size_t generation_ = 0;
+
+  std::atomic<size_t> bytes_  {0};
+  std::atomic<size_t> hits_   {0};
+  std::atomic<size_t> misses_ {0};
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map< key_type, std::unique_ptr<entry_type>, key_hash > entries_;
+
+public:
+
+  CollocationCache( size_t max_bytes, bool single_precision ) :
+    max_bytes_( max_bytes ), single_precision_( single_precision ) { }
+
+  inline size_t max_bytes()        const { return max_bytes_;        }
+  inline bool   single_precision() const { return single_precision_; }
+  inline size_t bytes()            const { return bytes_;            }
+  inline size_t hits()             const { return hits_;             }
+  inline size_t misses()           const { return misses_;           }
+
+  inline void reset_stats() { hits_ = 0; misses_ = 0; }
+
+  /**
+   *  @brief Drop all entries if the tasks have changed since they were stored
+   *
+   *  Not thread safe, to be called outside of concurrent load/store.
+   *
+   *  @param[in] generation Task generation of the LoadBalancer
+   */
+  void sync_generation( size_t generation ) {
+    if( generation == generation_ ) return;
+    entries_.clear();
+    bytes_      = 0;
+    generation_ = generation;
+  }
+
+  /**
+   *  @brief Retrieve a cached collocation for a task
+   *
+   *  @param[in]  task   Task for which to retrieve the collocation
+   *  @param[in]  ncomp  Number of components required (1 = B, 4 = B + grad B)
+   *  @param[out] basis_eval Contiguous (ncomp,nbe,npts) collocation buffer
+   *
+   *  @returns true if the entry was found, false otherwise
+   */
+  bool load( const XCTask& task, int32_t ncomp, double* basis_eval ) {
+
+    // Tasks without an identifier are never cached
+    if( task.task_id < 0 ) { misses_++; return false; }
+
+    const size_t sz = size_t(ncomp) * task.points.size() * task.bfn_screening.nbe;
+
+    // Copy under the (shared) lock as a concurrent store may replace the entry
+    {
+      std::shared_lock<std::shared_mutex> lock( mutex_ );
+      auto it = entries_.find( key_type(task) );
+      if( it == entries_.end() or it->second->ncomp < ncomp ) { 
+        misses_++; 
+        return false; 
+      }
+
+      const auto& entry = *it->second;
+      if( single_precision_ )
+        std::copy_n( entry.data_sp.data(), sz, basis_eval );
+      else
+        std::copy_n( entry.data_dp.data(), sz, basis_eval );
+    }
+
+    hits_++;
+    return true;
+
+  }
+
+  /**
+   *  @brief Admit the collocation for a task if it fits in the byte budget
+   *
+   *  @param[in] task   Task for which to store the collocation
+   *  @param[in] ncomp  Number of components (1 = B, 4 = B + grad B)
+   *  @param[in] basis_eval Contiguous (ncomp,nbe,npts) collocation buffer
+   *
+   *  @returns true if the entry was admitted, false otherwise
+   */
+  bool store( const XCTask& task, int32_t ncomp, const double* basis_eval ) {
+
+    if( task.task_id < 0 ) return false;
+
+    const size_t sz = size_t(ncomp) * task.points.size() * task.bfn_screening.nbe;
+    const size_t entry_bytes = sz * (single_precision_ ? sizeof(float) : sizeof(double));
+
+    // Reserve space in the budget
+    if( bytes_.fetch_add( entry_bytes ) + entry_bytes > max_bytes_ ) {
+      bytes_.fetch_sub( entry_bytes );
+      return false;
+    }
+
+    auto entry = std::make_unique<entry_type>();
+    entry->ncomp = ncomp;
+    if( single_precision_ ) entry->data_sp.assign( basis_eval, basis_eval + sz );
+    else                    entry->data_dp.assign( basis_eval, basis_eval + sz );
+
+    std::unique_lock<std::shared_mutex> lock( mutex_ );
+    auto [it, inserted] = entries_.try_emplace( key_type(task), nullptr );
+    if( not inserted and it->second->ncomp >= ncomp ) {
+      bytes_.fetch_sub( entry_bytes );
+      return false;
+    }
+
+    // Upgrade an entry which holds fewer components
+    if( not inserted ) {
+      bytes_.fetch_sub( (entry_bytes / ncomp) * it->second->ncomp );
+    }
+    it->second = std::move(entry);
+    return true;
+
+  }
+
+};
+
+}
+}
@@ -0,0 +1,60 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace GauXC  {
+namespace detail {
+
+/**
+ *  @brief Determine which points of a task survive density / weight screening
+ *
+ *  @param[in]  npts       Number of points in the task
+ *  @param[in]  weights    Quadrature weights
+ *  @param[in]  den        Density on the points
+ *  @param[in]  den_tol    Points with den <= den_tol are dropped
+ *  @param[in]  weight_tol Points with |weight| <= weight_tol are dropped
+ *  @param[out] keep       Indices of the surviving points (increasing, length >= npts)
+ *
+ *  @returns Number of surviving points
+ */
+template <typename F>
+int32_t screen_points( int32_t npts, const F* weights, const F* den,
+  F den_tol, F weight_tol, int32_t* keep ) {
+
+  int32_t nkeep = 0;
+  for( int32_t i = 0; i < npts; ++i )
+  if( std::abs(weights[i]) > weight_tol and den[i] > den_tol ) {
+    keep[nkeep++] = i;
+  }
+
+  return nkeep;
+
+}
+
+/**
+ *  @brief Compact the columns of A in place onto a list of surviving columns
+ *
+ *  Column keep[k] of A is moved to column k. As keep is increasing,
+ *  the copies never overwrite a column which has yet to be moved.
+ */
+template <typename F>
+void compact_columns( int32_t nrow, int32_t nkeep, const int32_t* keep,
+  F* A, int64_t lda ) {
+
+  for( int32_t k = 0; k < nkeep; ++k )
+  if( keep[k] != k ) {
+    std::copy_n( A + keep[k]*lda, nrow, A + k*lda );
+  }
+
+}
+
+}
+}
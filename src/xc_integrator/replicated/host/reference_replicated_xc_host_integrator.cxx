@@ -7,12 +7,197 @@
  */
 #include "reference_replicated_xc_host_integrator_integrate_den.hpp"
 #include "reference_replicated_xc_host_integrator_exc_vxc.hpp"
+#include "reference_replicated_xc_host_integrator_exc_vxc_uks.hpp"
+#include "reference_replicated_xc_host_integrator_batched.hpp"
+#include "reference_replicated_xc_host_integrator_fxc_contraction.hpp"
 #include "reference_replicated_xc_host_integrator_exc_grad.hpp"
 #include "reference_replicated_xc_host_integrator_exx.hpp"
+#include <cmath>
  
 namespace GauXC  {
 namespace detail {
 
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  setup_collocation_cache_( const IntegratorSettingsKS& settings ) {
+
+  // The cache persists across calls as long as its configuration is unchanged
+  if( not settings.collocation_cache_bytes ) {
+    collocation_cache_.reset();
+  } else if( not collocation_cache_ or 
+    collocation_cache_->max_bytes() != settings.collocation_cache_bytes or
+    collocation_cache_->single_precision() != 
+      settings.collocation_cache_single_precision ) {
+    collocation_cache_ = std::make_unique<CollocationCache>( 
+      settings.collocation_cache_bytes, 
+      settings.collocation_cache_single_precision );
+  }
+
+  if( collocation_cache_ ) {
+    collocation_cache_->sync_generation( 
+      this->load_balancer_->state().task_generation );
+    collocation_cache_->reset_stats();
+  }
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  report_collocation_cache_() {
+
+  if( not collocation_cache_ ) return;
+
+  const double hits   = collocation_cache_->hits();
+  const double misses = collocation_cache_->misses();
+  this->timer_.add_counter( "XCIntegrator.CollocationCache.Hits",   hits   );
+  this->timer_.add_counter( "XCIntegrator.CollocationCache.Misses", misses );
+  this->timer_.add_counter( "XCIntegrator.CollocationCache.HitRate", 
+    (hits + misses) > 0. ? hits / (hits + misses) : 0. );
+  this->timer_.add_counter( "XCIntegrator.CollocationCache.Bytes",  
+    collocation_cache_->bytes() );
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_collocation_( LocalHostWorkDriver* lwd, const XCTask& task, 
+    bool gradient, value_type* basis_eval ) {
+
+  const int32_t ncomp = gradient ? 4 : 1;
+  if( collocation_cache_ and 
+      collocation_cache_->load( task, ncomp, basis_eval ) ) return;
+
+  const int32_t npts    = task.points.size();
+  const int32_t nbe     = task.bfn_screening.nbe;
+  const int32_t nshells = task.bfn_screening.shell_list.size();
+
+  const auto* points        = task.points.data()->data();
+  const int32_t* shell_list = task.bfn_screening.shell_list.data();
+  const auto& basis = this->load_balancer_->basis();
+
+  if( gradient ) {
+    auto* dbasis_x_eval = basis_eval    + npts * nbe;
+    auto* dbasis_y_eval = dbasis_x_eval + npts * nbe;
+    auto* dbasis_z_eval = dbasis_y_eval + npts * nbe;
+    lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, 
+      shell_list, basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+  } else {
+    lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list, 
+      basis_eval );
+  }
+
+  if( collocation_cache_ ) collocation_cache_->store( task, ncomp, basis_eval );
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  report_mixed_precision_deviation_( LocalHostWorkDriver* lwd, 
+    const value_type* P, int64_t ldp, int32_t sample_stride ) {
+
+  if( sample_stride <= 0 ) return;
+
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+  const int32_t nbf = basis.nbf();
+
+  const auto& tasks   = this->load_balancer_->get_tasks();
+  const size_t ntasks   = tasks.size();
+  const size_t nsamples = (ntasks + sample_stride - 1) / sample_stride;
+  if( not nsamples ) return;
+
+  // EXC / N_EL of every sampled task, evaluated in mixed (0) and double (1)
+  // precision. Each pass runs with a fixed LWD precision, so the toggle is
+  // never changed while kernels are in flight
+  std::vector<value_type> EXC_sample( 2 * nsamples ), N_EL_sample( 2 * nsamples );
+
+  for( int ip = 0; ip < 2; ++ip ) {
+
+    MixedPrecisionGuard mixed_precision_guard( lwd, ip == 0 );
+
+    const auto host_max = host_data_maxima( *this->load_balancer_ );
+    #pragma omp parallel
+    {
+
+    XCHostData<value_type> host_data( host_max, func.is_gga() ? 4 : 1 ); // Thread local host data
+
+    #pragma omp for schedule(dynamic)
+    for( size_t iS = 0; iS < nsamples; ++iS ) {
+
+      const auto& task = tasks[ iS * sample_stride ];
+
+      const int32_t npts = task.points.size();
+      const int32_t nbe  = task.bfn_screening.nbe;
+      const auto* weights = task.weights.data();
+
+      host_data.nbe_scr    .resize( nbe * nbe );
+      host_data.zmat       .resize( npts * nbe );
+      host_data.eps        .resize( npts );
+      host_data.vrho       .resize( npts );
+      host_data.basis_eval .resize( (func.is_gga() ? 4 : 1) * npts * nbe );
+      host_data.den_scr    .resize( (func.is_gga() ? 4 : 1) * npts );
+      if( func.is_gga() ) {
+        host_data.gamma  .resize( npts );
+        host_data.vgamma .resize( npts );
+      }
+
+      auto* basis_eval = host_data.basis_eval.data();
+      auto* den_eval   = host_data.den_scr.data();
+      auto* xmat       = host_data.zmat.data();
+      auto* eps        = host_data.eps.data();
+
+      eval_collocation_( lwd, task, func.is_gga(), basis_eval );
+      SinglePrecisionBasisScope sp_basis( lwd );
+      sp_basis.set( npts, nbe, basis_eval );
+      lwd->eval_xmat( npts, nbf, nbe, task.bfn_screening.submat_map, P, ldp,
+        basis_eval, nbe, xmat, nbe, host_data.nbe_scr.data() );
+
+      if( func.is_gga() ) {
+        auto* dbasis_x_eval = basis_eval    + npts * nbe;
+        auto* dbasis_y_eval = dbasis_x_eval + npts * nbe;
+        auto* dbasis_z_eval = dbasis_y_eval + npts * nbe;
+        auto* dden_x_eval   = den_eval    + npts;
+        auto* dden_y_eval   = dden_x_eval + npts;
+        auto* dden_z_eval   = dden_y_eval + npts;
+        lwd->eval_uvvar_gga( npts, nbe, basis_eval, dbasis_x_eval, 
+          dbasis_y_eval, dbasis_z_eval, xmat, nbe, den_eval, dden_x_eval, 
+          dden_y_eval, dden_z_eval, host_data.gamma.data() );
+        func.eval_exc_vxc( npts, den_eval, host_data.gamma.data(), eps, 
+          host_data.vrho.data(), host_data.vgamma.data() );
+      } else {
+        lwd->eval_uvvar_lda( npts, nbe, basis_eval, xmat, nbe, den_eval );
+        func.eval_exc_vxc( npts, den_eval, eps, host_data.vrho.data() );
+      }
+
+      value_type EXC_task = 0., N_EL_task = 0.;
+      for( int32_t i = 0; i < npts; ++i ) {
+        N_EL_task += weights[i] * den_eval[i];
+        EXC_task  += weights[i] * eps[i] * den_eval[i];
+      }
+      EXC_sample [ ip * nsamples + iS ] = EXC_task;
+      N_EL_sample[ ip * nsamples + iS ] = N_EL_task;
+
+    } // Loop over sampled tasks
+
+    } // End OpenMP region
+
+  }
+
+  // Extrapolate the sampled absolute deviations to all local tasks
+  value_type EXC_dev = 0., N_EL_dev = 0.;
+  for( size_t iS = 0; iS < nsamples; ++iS ) {
+    EXC_dev  += std::abs( EXC_sample [iS] - EXC_sample [nsamples + iS] );
+    N_EL_dev += std::abs( N_EL_sample[iS] - N_EL_sample[nsamples + iS] );
+  }
+  const double scale = double(ntasks) / nsamples;
+
+  this->timer_.add_counter( "XCIntegrator.MixedPrecision.EXCDeviation",  
+    scale * EXC_dev  );
+  this->timer_.add_counter( "XCIntegrator.MixedPrecision.N_ELDeviation", 
+    scale * N_EL_dev );
+
+}
+
 template <typename ValueType>
 ReferenceReplicatedXCHostIntegrator<ValueType>::~ReferenceReplicatedXCHostIntegrator() noexcept = default;
 
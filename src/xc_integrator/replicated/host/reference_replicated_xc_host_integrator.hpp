@@ -8,8 +8,12 @@
 #pragma once
 #include <gauxc/xc_integrator/replicated/replicated_xc_host_integrator.hpp>
 #include "xc_host_data.hpp"
+#include "collocation_cache.hpp"
 
 namespace GauXC {
+
+class LocalHostWorkDriver;
+
 namespace detail {
 
 template <typename ValueType>
@@ -18,6 +22,8 @@ class ReferenceReplicatedXCHostIntegrator :
 
   using base_type  = ReplicatedXCHostIntegrator<ValueType>;
 
+  std::unique_ptr<CollocationCache> collocation_cache_; ///< Persistent collocation cache (opt-in)
+
 public:
 
   using value_type = typename base_type::value_type;
@@ -30,22 +36,73 @@ protected:
 
   void eval_exc_vxc_( int64_t m, int64_t n, const value_type* P,
                       int64_t ldp, value_type* VXC, int64_t ldvxc,
-                      value_type* EXC ) override;
+                      value_type* EXC, const IntegratorSettingsXC& settings ) override;
+
+  void eval_exc_vxc_( int64_t m, int64_t n, const value_type* Pa,
+                      int64_t ldpa, const value_type* Pb, int64_t ldpb,
+                      value_type* VXCa, int64_t ldvxca, value_type* VXCb,
+                      int64_t ldvxcb, value_type* EXC, 
+                      const IntegratorSettingsXC& settings ) override;
 
   void eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
-                       int64_t ldp, value_type* EXC_GRAD ) override;
+                       int64_t ldp, value_type* EXC_GRAD, 
+                       const IntegratorSettingsXC& settings ) override;
+
+  void integrate_den_batched_( int64_t ndm, int64_t m, int64_t n, 
+                               const value_type* const* P, int64_t ldp, 
+                               value_type* N_EL ) override;
+
+  void eval_exc_vxc_batched_( int64_t ndm, int64_t m, int64_t n, 
+                              const value_type* const* P, int64_t ldp, 
+                              value_type* const* VXC, int64_t ldvxc,
+                              value_type* EXC, 
+                              const IntegratorSettingsXC& settings ) override;
+
+  void eval_fxc_contraction_( int64_t ndm, int64_t m, int64_t n, 
+                              const value_type* P0, int64_t ldp0,
+                              const value_type* const* dP, int64_t lddp,
+                              value_type* const* FXC, int64_t ldfxc,
+                              const IntegratorSettingsXC& settings ) override;
 
   void eval_exx_( int64_t m, int64_t n, const value_type* P,
                   int64_t ldp, value_type* K, int64_t ldk,
                   const IntegratorSettingsEXX& settings ) override;
 
+  void setup_collocation_cache_( const IntegratorSettingsKS& settings );
+  void report_collocation_cache_();
+
+  void eval_collocation_( LocalHostWorkDriver* lwd, const XCTask& task, 
+                          bool gradient, value_type* basis_eval );
+
+  void report_mixed_precision_deviation_( LocalHostWorkDriver* lwd, 
+    const value_type* P, int64_t ldp, int32_t sample_stride );
+
   void integrate_den_local_work_( const value_type* P, int64_t ldp, 
                                    value_type *N_EL );
 
   void exc_vxc_local_work_( const value_type* P, int64_t ldp, value_type* VXC,
-                            int64_t ldvxc, value_type* EXC, value_type *N_EL );
+                            int64_t ldvxc, value_type* EXC, value_type *N_EL,
+                            const IntegratorSettingsXC& settings );
+
+  void exc_vxc_local_work_( const value_type* Pa, int64_t ldpa, 
+                            const value_type* Pb, int64_t ldpb,
+                            value_type* VXCa, int64_t ldvxca, 
+                            value_type* VXCb, int64_t ldvxcb, value_type* EXC, 
+                            value_type *N_EL, const IntegratorSettingsXC& settings );
+
+  void integrate_den_batched_local_work_( int64_t ndm, 
+    const value_type* const* P, int64_t ldp, value_type* N_EL );
+
+  void exc_vxc_batched_local_work_( int64_t ndm, const value_type* const* P, 
+    int64_t ldp, value_type* const* VXC, int64_t ldvxc, value_type* EXC, 
+    value_type* N_EL, const IntegratorSettingsXC& settings );
+
+  void fxc_contraction_local_work_( int64_t ndm, const value_type* P0, 
+    int64_t ldp0, const value_type* const* dP, int64_t lddp, 
+    value_type* const* FXC, int64_t ldfxc, const IntegratorSettingsXC& settings );
 
-  void exc_grad_local_work_( const value_type* P, int64_t ldp, value_type* EXC_GRAD );
+  void exc_grad_local_work_( const value_type* P, int64_t ldp, value_type* EXC_GRAD,
+                             const IntegratorSettingsXC& settings );
   void exx_local_work_( const value_type* P, int64_t ldp, value_type* K, int64_t ldk,
     const IntegratorSettingsEXX& settings );
 
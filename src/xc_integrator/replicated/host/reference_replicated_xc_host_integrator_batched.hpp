@@ -0,0 +1,491 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "vxc_accumulator.hpp"
+#include <stdexcept>
+
+namespace GauXC  {
+namespace detail {
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  integrate_den_batched_( int64_t ndm, int64_t m, int64_t n,
+                          const value_type* const* P, int64_t ldp,
+                          value_type* N_EL ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P is sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P Must Have Same Dimension as Basis");
+  if( ldp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+
+
+  // Get Tasks
+  this->load_balancer_->get_tasks();
+
+  // Compute Local contributions to N_EL
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    integrate_den_batched_local_work_( ndm, P, ldp, N_EL );
+  });
+
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    this->reduction_driver_->allreduce_inplace( N_EL, ndm, ReductionOp::Sum );
+
+  });
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_exc_vxc_batched_( int64_t ndm, int64_t m, int64_t n,
+                         const value_type* const* P, int64_t ldp,
+                         value_type* const* VXC, int64_t ldvxc,
+                         value_type* EXC, const IntegratorSettingsXC& settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P / VXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Have Same Dimension as Basis");
+  if( ldp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+  if( ldvxc < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDVXC");
+
+
+  // Get Tasks
+  this->load_balancer_->get_tasks();
+
+  // Temporary electron counts to judge integrator accuracy
+  std::vector<value_type> N_EL( ndm );
+
+  // Compute Local contributions to EXC / VXC
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    exc_vxc_batched_local_work_( ndm, P, ldp, VXC, ldvxc, EXC, N_EL.data(),
+      settings );
+  });
+
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    for( int64_t k = 0; k < ndm; ++k )
+      this->reduction_driver_->allreduce_inplace( VXC[k], nbf*nbf, ReductionOp::Sum );
+    this->reduction_driver_->allreduce_inplace( EXC,         ndm, ReductionOp::Sum );
+    this->reduction_driver_->allreduce_inplace( N_EL.data(), ndm, ReductionOp::Sum );
+
+  });
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  integrate_den_batched_local_work_( int64_t ndm, const value_type* const* P,
+    int64_t ldp, value_type* N_EL ) {
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& basis = this->load_balancer_->basis();
+
+  const int32_t nbf = basis.nbf();
+
+  // Sort tasks on size (XXX: maybe doesnt matter?)
+  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
+    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
+  };
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  std::sort( tasks.begin(), tasks.end(), task_comparator );
+
+
+  // Check that Partition Weights have been calculated
+  auto& lb_state = this->load_balancer_->state();
+  if( not lb_state.modified_weights_are_stored ) {
+    GAUXC_GENERIC_EXCEPTION("Weights Have Not Beed Modified");
+  }
+  std::fill_n( N_EL, ndm, 0. );
+
+  // Reuse the collocation cached by previous EXC/VXC evaluations (if any)
+  if( collocation_cache_ ) {
+    collocation_cache_->sync_generation( lb_state.task_generation );
+    collocation_cache_->reset_stats();
+  }
+
+
+  // Loop over tasks
+  const size_t ntasks = tasks.size();
+
+  const auto host_max = host_data_maxima( *this->load_balancer_ );
+  #pragma omp parallel
+  {
+
+  XCHostData<value_type> host_data( host_max, 1, ndm, ndm ); // Thread local host data
+  std::vector<value_type> N_EL_local( ndm, 0. );
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    // Alias current task
+    const auto& task = tasks[iT];
+
+    // Get tasks constants
+    const int32_t  npts    = task.points.size();
+    const int32_t  nbe     = task.bfn_screening.nbe;
+
+    const auto* weights     = task.weights.data();
+
+    // Allocate enough memory for batch
+    host_data.nbe_scr    .resize( ndm * nbe * nbe  );
+    host_data.zmat       .resize( ndm * npts * nbe );
+    host_data.basis_eval .resize( npts * nbe );
+    host_data.den_scr    .resize( npts );
+
+    // Alias/Partition out scratch memory
+    auto* basis_eval = host_data.basis_eval.data();
+    auto* den_eval   = host_data.den_scr.data();
+    auto* nbe_scr    = host_data.nbe_scr.data();
+    auto* xmat       = host_data.zmat.data();
+    const int32_t ldx = ndm * nbe;
+
+    // Get the submatrix map for batch (precomputed by the load balancer)
+    const auto& submat_map = task.bfn_screening.submat_map;
+
+    // Evaluate Collocation once, and all X matrices (P_k * B) in a single GEMM
+    eval_collocation_( lwd, task, false, basis_eval );
+    lwd->eval_xmat_batched( ndm, npts, nbf, nbe, submat_map, P, ldp,
+      basis_eval, nbe, xmat, ldx, nbe_scr );
+
+    for( int64_t k = 0; k < ndm; ++k ) {
+
+      // Evaluate the density on the grid
+      lwd->eval_uvvar_lda( npts, nbe, basis_eval, xmat + k*nbe, ldx, den_eval );
+
+      // Scalar integrations
+      for( int32_t i = 0; i < npts; ++i ) {
+        N_EL_local[k] += weights[i] * den_eval[i];
+      }
+
+    }
+
+  } // Loop over tasks
+
+  #pragma omp critical
+  {
+    for( int64_t k = 0; k < ndm; ++k ) N_EL[k] += N_EL_local[k];
+  }
+
+  } // End OpenMP region
+
+  report_collocation_cache_();
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_vxc_batched_local_work_( int64_t ndm, const value_type* const* P,
+    int64_t ldp, value_type* const* VXC, int64_t ldvxc, value_type* EXC,
+    value_type* N_EL, const IntegratorSettingsXC& settings ) {
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+
+  const int32_t nbf = basis.nbf();
+
+  // Sort tasks on size (XXX: maybe doesnt matter?)
+  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
+    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
+  };
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  std::sort( tasks.begin(), tasks.end(), task_comparator );
+
+
+  // Check that Partition Weights have been calculated
+  auto& lb_state = this->load_balancer_->state();
+  if( not lb_state.modified_weights_are_stored ) {
+    GAUXC_GENERIC_EXCEPTION("Weights Have Not Beed Modified");
+  }
+
+  // Determine how task contributions are accumulated into VXC
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+  if( ks_settings.screen_points )
+    GAUXC_GENERIC_EXCEPTION("Point Screening NYI for Batched EXC/VXC");
+
+  // ndm thread private copies are required per thread
+  auto ks_settings_batch = ks_settings;
+  ks_settings_batch.vxc_private_max_bytes /= ndm;
+  const auto vxc_accumulation =
+    resolve_vxc_accumulation( ks_settings_batch, nbf, sizeof(value_type) );
+  const bool thread_private_vxc =
+    vxc_accumulation == VXCAccumulation::ThreadPrivate;
+  const bool tile_locked_vxc =
+    vxc_accumulation == VXCAccumulation::TileLocked;
+
+  // Mixed precision X / Z GEMMs (if enabled in the LWD), unless the caller
+  // requests full double precision for this evaluation
+  MixedPrecisionGuard mixed_precision_guard( lwd, 
+    lwd->mixed_precision_enabled() and not ks_settings.disable_mixed_precision );
+
+  setup_collocation_cache_( ks_settings );
+
+  std::vector<value_type*> vxc_private( host_max_threads(), nullptr );
+  std::vector<std::unique_ptr<VXCTileLocks>> vxc_locks;
+  if( tile_locked_vxc )
+  for( int64_t k = 0; k < ndm; ++k ) {
+    vxc_locks.emplace_back(
+      std::make_unique<VXCTileLocks>( nbf, ks_settings.vxc_lock_tile_size ) );
+  }
+
+  // Zero out integrands
+  for( int64_t k = 0; k < ndm; ++k ) {
+    for( auto j = 0; j < nbf; ++j )
+    for( auto i = 0; i < nbf; ++i )
+      VXC[k][i + j*ldvxc] = 0.;
+    EXC[k]  = 0.;
+    N_EL[k] = 0.;
+  }
+
+
+  // Loop over tasks
+  const size_t ntasks = tasks.size();
+
+  const auto host_max = host_data_maxima( *this->load_balancer_ );
+  #pragma omp parallel
+  {
+
+  XCHostData<value_type> host_data( host_max, func.is_gga() ? 4 : 1, ndm + 1,
+      std::max<size_t>( ndm, 2 ) ); // Thread local host data
+
+  // Thread local scalar integrands
+  std::vector<value_type> N_EL_local( ndm, 0. );
+  std::vector<value_type> EXC_local ( ndm, 0. );
+
+  // Thread local VXC (first touched by the owning thread)
+  std::vector<value_type> VXC_local;
+  if( thread_private_vxc ) {
+    VXC_local.resize( ndm * nbf * nbf, 0. );
+    vxc_private[ host_thread_num() ] = VXC_local.data();
+  }
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    // Alias current task
+    const auto& task = tasks[iT];
+
+    // Get tasks constants
+    const int32_t  npts    = task.points.size();
+    const int32_t  nbe     = task.bfn_screening.nbe;
+
+    const auto* weights     = task.weights.data();
+
+    // Allocate enough memory for batch
+
+    // Things that every calc needs. zmat holds the stacked X matrices
+    // followed by a single Z matrix which is reused for each density
+    host_data.nbe_scr .resize( std::max<int64_t>(ndm, tile_locked_vxc ? 2 : 1) * nbe * nbe );
+    host_data.zmat    .resize( (ndm + 1) * npts * nbe );
+    host_data.eps     .resize( npts );
+    host_data.vrho    .resize( npts );
+
+    // LDA data requirements
+    if( func.is_lda() ){
+      host_data.basis_eval .resize( npts * nbe );
+      host_data.den_scr    .resize( npts );
+    }
+
+    // GGA data requirements
+    if( func.is_gga() ){
+      host_data.basis_eval .resize( 4 * npts * nbe );
+      host_data.den_scr    .resize( 4 * npts );
+      host_data.gamma      .resize( npts );
+      host_data.vgamma     .resize( npts );
+    }
+
+    // Alias/Partition out scratch memory
+    auto* basis_eval = host_data.basis_eval.data();
+    auto* den_eval   = host_data.den_scr.data();
+    auto* nbe_scr    = host_data.nbe_scr.data();
+    auto* xmat       = host_data.zmat.data();
+    auto* zmat       = xmat + ndm * npts * nbe;
+    const int32_t ldx = ndm * nbe;
+
+    auto* eps        = host_data.eps.data();
+    auto* gamma      = host_data.gamma.data();
+    auto* vrho       = host_data.vrho.data();
+    auto* vgamma     = host_data.vgamma.data();
+
+    value_type* dbasis_x_eval = nullptr;
+    value_type* dbasis_y_eval = nullptr;
+    value_type* dbasis_z_eval = nullptr;
+    value_type* dden_x_eval = nullptr;
+    value_type* dden_y_eval = nullptr;
+    value_type* dden_z_eval = nullptr;
+
+    if( func.is_gga() ) {
+      dbasis_x_eval = basis_eval    + npts * nbe;
+      dbasis_y_eval = dbasis_x_eval + npts * nbe;
+      dbasis_z_eval = dbasis_y_eval + npts * nbe;
+      dden_x_eval   = den_eval    + npts;
+      dden_y_eval   = dden_x_eval + npts;
+      dden_z_eval   = dden_y_eval + npts;
+    }
+
+
+    // Get the submatrix map for batch (precomputed by the load balancer)
+    const auto& submat_map = task.bfn_screening.submat_map;
+
+    // In mixed precision, the collocation matrix is converted to single
+    // precision once per task and shared by the X and VXC GEMMs
+    SinglePrecisionBasisScope sp_basis( lwd );
+
+    // Evaluate Collocation (+ Grad) once for all densities
+    eval_collocation_( lwd, task, func.is_gga(), basis_eval );
+    sp_basis.set( npts, nbe, basis_eval );
+
+    // Evaluate all X matrices (P_k * B) in a single GEMM
+    lwd->eval_xmat_batched( ndm, npts, nbf, nbe, submat_map, P, ldp,
+      basis_eval, nbe, xmat, ldx, nbe_scr );
+
+    for( int64_t k = 0; k < ndm; ++k ) {
+
+      const auto* xmat_k = xmat + k * nbe;
+
+      // Evaluate U and V variables
+      if( func.is_gga() )
+        lwd->eval_uvvar_gga( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+          dbasis_z_eval, xmat_k, ldx, den_eval, dden_x_eval, dden_y_eval,
+          dden_z_eval, gamma );
+      else
+        lwd->eval_uvvar_lda( npts, nbe, basis_eval, xmat_k, ldx, den_eval );
+
+      // Evaluate XC functional
+      if( func.is_gga() )
+        func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
+      else
+        func.eval_exc_vxc( npts, den_eval, eps, vrho );
+
+      // Factor weights into XC results
+      for( int32_t i = 0; i < npts; ++i ) {
+        eps[i]  *= weights[i];
+        vrho[i] *= weights[i];
+      }
+
+      if( func.is_gga() )
+        for( int32_t i = 0; i < npts; ++i ) vgamma[i] *= weights[i];
+
+      // Evaluate Z matrix for VXC
+      if( func.is_gga() )
+        lwd->eval_zmat_gga_vxc( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+                                dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
+                                dden_z_eval, zmat, nbe);
+      else
+        lwd->eval_zmat_lda_vxc( npts, nbe, vrho, basis_eval, zmat, nbe );
+
+      // Scalar integrations
+      for( int32_t i = 0; i < npts; ++i ) {
+        N_EL_local[k] += weights[i] * den_eval[i];
+        EXC_local[k]  += eps[i]     * den_eval[i];
+      }
+
+      // Incremeta LT of VXC
+      if( thread_private_vxc ) {
+
+        lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat, nbe,
+          VXC_local.data() + k*nbf*nbf, nbf, nbe_scr );
+
+      } else if( tile_locked_vxc ) {
+
+        // Form the packed task contribution outside of any lock
+        auto* vxc_packed = nbe_scr + nbe * nbe;
+        std::fill_n( vxc_packed, nbe * nbe, 0. );
+        std::vector< std::array<int32_t,3> > packed_submat_map = { {0, nbe, 0} };
+        lwd->inc_vxc( npts, nbe, nbe, basis_eval, packed_submat_map, zmat, nbe,
+          vxc_packed, nbe, nbe_scr );
+
+        vxc_locks[k]->inc_by_submat( VXC[k], ldvxc, vxc_packed, nbe, submat_map );
+
+      } else {
+
+        #pragma omp critical
+        lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat, nbe, VXC[k],
+          ldvxc, nbe_scr );
+
+      }
+
+    } // Loop over densities
+
+  } // Loop over tasks
+
+  #pragma omp critical
+  {
+    for( int64_t k = 0; k < ndm; ++k ) {
+      N_EL[k] += N_EL_local[k];
+      EXC[k]  += EXC_local[k];
+    }
+  }
+
+  // Reduce thread local VXC copies (LT only), distributed over columns
+  if( thread_private_vxc ) {
+    #pragma omp barrier
+
+    #pragma omp for schedule(static)
+    for( int32_t j = 0; j < nbf; ++j )
+    for( auto* VXC_t : vxc_private ) if( VXC_t )
+    for( int64_t k = 0; k < ndm; ++k ) {
+      const auto* VXC_tk = VXC_t + k*nbf*nbf;
+      for( int32_t i = j; i < nbf; ++i )
+        VXC[k][ i + j*ldvxc ] += VXC_tk[ i + j*nbf ];
+    }
+  }
+
+  } // End OpenMP region
+
+  report_collocation_cache_();
+  this->timer_.add_counter( "XCIntegrator.MixedPrecision", lwd->mixed_precision() );
+
+  // Symmetrize VXC
+  for( int64_t k = 0; k < ndm; ++k )
+  for( int32_t j = 0;   j < nbf; ++j )
+  for( int32_t i = j+1; i < nbf; ++i )
+    VXC[k][ j + i*ldvxc ] = VXC[k][ i + j*ldvxc ];
+
+}
+
+}
+}
@@ -18,7 +18,8 @@ namespace detail {
 template <typename ValueType>
 void ReferenceReplicatedXCHostIntegrator<ValueType>::
   eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
-                 int64_t ldp, value_type* EXC_GRAD ) { 
+                 int64_t ldp, value_type* EXC_GRAD, 
+                 const IntegratorSettingsXC& settings ) { 
                  
                  
   const auto& basis = this->load_balancer_->basis();
@@ -38,7 +39,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
                  
   // Compute Local contributions to EXC / VXC
   this->timer_.time_op("XCIntegrator.LocalWork", [&](){
-    exc_grad_local_work_( P, ldp, EXC_GRAD );
+    exc_grad_local_work_( P, ldp, EXC_GRAD, settings );
   });
 
 
@@ -56,7 +57,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
 template <typename ValueType>
 void ReferenceReplicatedXCHostIntegrator<ValueType>::
-  exc_grad_local_work_( const value_type* P, int64_t ldp, value_type* EXC_GRAD ) {
+  exc_grad_local_work_( const value_type* P, int64_t ldp, value_type* EXC_GRAD,
+                        const IntegratorSettingsXC& settings ) {
 
   // Cast LWD to LocalHostWorkDriver
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
@@ -65,9 +67,10 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   const auto& func  = *this->func_;
   const auto& basis = this->load_balancer_->basis();
   const auto& mol   = this->load_balancer_->molecule();
+  const auto& meta  = this->load_balancer_->molmeta();
 
   // Get basis map
-  BasisSetMap basis_map(basis,mol);
+  const auto& basis_map = this->load_balancer_->basis_map();
 
   const int32_t nbf = basis.nbf();
   const int32_t natoms = mol.natoms();
@@ -87,6 +90,15 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     GAUXC_GENERIC_EXCEPTION("Weights Have Not Beed Modified"); 
   }
 
+  // Whether to include partition weight derivatives. If so, grid points
+  // move with their parent atom and the parent contribution follows from
+  // translational invariance
+  IntegratorSettingsEXCGrad grad_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsEXCGrad*>(&settings) ) {
+    grad_settings = *tmp;
+  }
+  const bool weight_derivatives = grad_settings.weight_derivatives;
+
   // Zero out integrands
   for( auto i = 0; i < 3*natoms; ++i ) {
     EXC_GRAD[i] = 0.;
@@ -94,10 +106,24 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   // Loop over tasks
   const size_t ntasks = tasks.size();
+  const auto host_max = host_data_maxima( *this->load_balancer_ );
+
+  // Weight derivative integrands, concatenated in task order
+  std::vector<size_t> f_offset;
+  std::vector<value_type> weight_integrand;
+  if( weight_derivatives ) {
+    f_offset.resize( ntasks + 1, 0 );
+    for( size_t iT = 0; iT < ntasks; ++iT ) 
+      f_offset[iT+1] = f_offset[iT] + tasks[iT].points.size();
+    weight_integrand.resize( f_offset.back() );
+  }
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  XCHostData<value_type> host_data( host_max, func.is_gga() ? 10 : 4,
+      func.is_gga() ? 4 : 1 ); // Thread local host data
+  std::vector<value_type> EXC_GRAD_local( 3*natoms, 0. );
 
   #pragma omp for schedule(dynamic)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
@@ -173,9 +199,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     }
 
 
-    // Get the submatrix map for batch
-    auto [submat_map, foo] = 
-      gen_compressed_submat_map( basis_map, task.bfn_screening.shell_list, nbf, nbf );
+    // Get the submatrix map for batch (precomputed by the load balancer)
+    const auto& submat_map = task.bfn_screening.submat_map;
 
     // Evaluate Collocation Gradient (+ Hessian)
     if( func.is_gga() )
@@ -222,6 +247,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       const int sh_sz  = basis[sh_idx].size();
       const int iAt    = basis_map.shell_to_center( sh_idx );
 
+      if( weight_derivatives and iAt == task.iParent ) {
+        bf_off += sh_sz;
+        continue;
+      }
+
       double g_acc_x(0), g_acc_y(0), g_acc_z(0);
       for( int ibf = 0, mu = bf_off; ibf < sh_sz; ++ibf, ++mu )
       for( int ipt = 0; ipt < npts; ++ipt ) {
@@ -275,21 +305,39 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
       } // loop over bfns + grid points
 
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 0] += -2 * g_acc_x;
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 1] += -2 * g_acc_y;
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 2] += -2 * g_acc_z;
+      EXC_GRAD_local[3*iAt + 0] += -2 * g_acc_x;
+      EXC_GRAD_local[3*iAt + 1] += -2 * g_acc_y;
+      EXC_GRAD_local[3*iAt + 2] += -2 * g_acc_z;
+
+      if( weight_derivatives ) {
+        EXC_GRAD_local[3*task.iParent + 0] -= -2 * g_acc_x;
+        EXC_GRAD_local[3*task.iParent + 1] -= -2 * g_acc_y;
+        EXC_GRAD_local[3*task.iParent + 2] -= -2 * g_acc_z;
+      }
 
       bf_off += sh_sz; // Increment basis offset
 
     } // End loop over shells 
+
+    // Partition weight derivatives, the integrand is den * eps
+    if( weight_derivatives ) {
+      auto* f = weight_integrand.data() + f_offset[iT];
+      for( int32_t i = 0; i < npts; ++i ) f[i] = eps[i] * den_eval[i];
+    }
         
   } // End loop over tasks
 
+  #pragma omp critical
+  for( auto i = 0; i < 3*natoms; ++i ) EXC_GRAD[i] += EXC_GRAD_local[i];
+
   } // OpenMP Region
 
+  // Partition weight derivatives for all tasks at once, which shares the
+  // atom screening setup
+  if( weight_derivatives )
+    lwd->eval_weight_gradient( lb_state.weight_alg, mol, meta, 
+      tasks.begin(), tasks.end(), weight_integrand.data(), EXC_GRAD );
+
   
 }
 
@@ -9,7 +9,10 @@
 
 #include "reference_replicated_xc_host_integrator.hpp"
 #include "integrator_util/integrator_common.hpp"
+#include "integrator_util/task_cost.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "vxc_accumulator.hpp"
+#include "point_screening.hpp"
 #include <stdexcept>
 
 namespace GauXC  {
@@ -19,7 +22,7 @@ template <typename ValueType>
 void ReferenceReplicatedXCHostIntegrator<ValueType>::
   eval_exc_vxc_( int64_t m, int64_t n, const value_type* P,
                  int64_t ldp, value_type* VXC, int64_t ldvxc,
-                 value_type* EXC ) {
+                 value_type* EXC, const IntegratorSettingsXC& settings ) {
 
   const auto& basis = this->load_balancer_->basis();
 
@@ -43,7 +46,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   // Compute Local contributions to EXC / VXC
   this->timer_.time_op("XCIntegrator.LocalWork", [&](){
-    exc_vxc_local_work_( P, ldp, VXC, ldvxc, EXC, &N_EL );
+    exc_vxc_local_work_( P, ldp, VXC, ldvxc, EXC, &N_EL, settings );
   });
 
 
@@ -65,7 +68,7 @@ template <typename ValueType>
 void ReferenceReplicatedXCHostIntegrator<ValueType>::
   exc_vxc_local_work_( const value_type* P, int64_t ldp, 
     value_type* VXC, int64_t ldvxc, value_type* EXC, 
-    value_type* N_EL ) {
+    value_type* N_EL, const IntegratorSettingsXC& settings ) {
 
   // Cast LWD to LocalHostWorkDriver
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
@@ -73,10 +76,6 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   // Setup Aliases
   const auto& func  = *this->func_;
   const auto& basis = this->load_balancer_->basis();
-  const auto& mol   = this->load_balancer_->molecule();
-
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
 
   const int32_t nbf = basis.nbf();
 
@@ -95,24 +94,73 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     GAUXC_GENERIC_EXCEPTION("Weights Have Not Beed Modified"); 
   }
 
+  // Determine how task contributions are accumulated into VXC
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+
+  const auto vxc_accumulation = 
+    resolve_vxc_accumulation( ks_settings, nbf, sizeof(value_type) );
+
+  // Mixed precision X / Z GEMMs (if enabled in the LWD), unless the caller
+  // requests full double precision for this evaluation
+  MixedPrecisionGuard mixed_precision_guard( lwd, 
+    lwd->mixed_precision_enabled() and not ks_settings.disable_mixed_precision );
+  const bool mixed_precision = lwd->mixed_precision();
+
+  setup_collocation_cache_( ks_settings );
+  const bool thread_private_vxc = 
+    vxc_accumulation == VXCAccumulation::ThreadPrivate;
+  const bool tile_locked_vxc = 
+    vxc_accumulation == VXCAccumulation::TileLocked;
+
+  std::vector<value_type*> vxc_private( host_max_threads(), nullptr );
+  std::unique_ptr<VXCTileLocks> vxc_locks;
+  if( tile_locked_vxc ) 
+    vxc_locks = std::make_unique<VXCTileLocks>( nbf, ks_settings.vxc_lock_tile_size );
+
   // Zero out integrands
   for( auto j = 0; j < nbf; ++j )
   for( auto i = 0; i < nbf; ++i ) 
     VXC[i + j*ldvxc] = 0.;
   *EXC = 0.;
+  *N_EL = 0.;
+
+  // Point screening statistics
+  const bool screen_low_density = ks_settings.screen_points;
+  size_t npts_total   = 0;
+  size_t npts_dropped = 0;
 
 
   // Loop over tasks
   const size_t ntasks = tasks.size();
 
+  const auto host_max = host_data_maxima( *this->load_balancer_ );
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  XCHostData<value_type> host_data( host_max, func.is_gga() ? 4 : 1 ); // Thread local host data
+
+  // Thread local scalar integrands
+  value_type N_EL_local = 0.;
+  value_type EXC_local  = 0.;
+  size_t npts_total_local   = 0;
+  size_t npts_dropped_local = 0;
+
+  // Thread local VXC (first touched by the owning thread)
+  std::vector<value_type> VXC_local;
+  if( thread_private_vxc ) {
+    VXC_local.resize( nbf * nbf, 0. );
+    vxc_private[ host_thread_num() ] = VXC_local.data();
+  }
 
   #pragma omp for schedule(dynamic)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
 
+    // Measure the task for subsequent load balancing
+    TaskCostRecorder cost_recorder( tasks[iT].measured_cost.exc_vxc );
+
     //std::cout << iT << "/" << ntasks << std::endl;
     // Alias current task
     const auto& task = tasks[iT];
@@ -129,7 +177,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // Allocate enough memory for batch
 
     // Things that every calc needs
-    host_data.nbe_scr .resize( nbe * nbe  );
+    // (TileLocked needs an additional packed nbe x nbe buffer)
+    host_data.nbe_scr .resize( (tile_locked_vxc ? 2 : 1) * nbe * nbe );
     host_data.zmat    .resize( npts * nbe );
     host_data.eps     .resize( npts );
     host_data.vrho    .resize( npts );
@@ -176,78 +225,165 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     }
 
 
-    // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
-
-    // Evaluate Collocation (+ Grad)
-    if( func.is_gga() )
-      lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list, 
-        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+    // Get the submatrix map for batch (precomputed by the load balancer)
+    const auto& submat_map = task.bfn_screening.submat_map;
+
+    // In mixed precision, the collocation matrix is converted to single
+    // precision once per task and shared by the X and VXC GEMMs
+    SinglePrecisionBasisScope sp_basis( lwd );
+
+    // Evaluate Collocation (+ Grad), X matrix (P * B) -> store in Z,
+    // and U and V variables
+    if( collocation_cache_ or mixed_precision ) {
+      eval_collocation_( lwd, task, func.is_gga(), basis_eval );
+      sp_basis.set( npts, nbe, basis_eval );
+      lwd->eval_xmat( npts, nbf, nbe, submat_map, P, ldp, basis_eval, nbe, 
+        zmat, nbe, nbe_scr );
+      if( func.is_gga() )
+        lwd->eval_uvvar_gga( npts, nbe, basis_eval, dbasis_x_eval, 
+          dbasis_y_eval, dbasis_z_eval, zmat, nbe, den_eval, dden_x_eval, 
+          dden_y_eval, dden_z_eval, gamma );
+      else
+        lwd->eval_uvvar_lda( npts, nbe, basis_eval, zmat, nbe, den_eval );
+    } else if( func.is_gga() )
+      lwd->eval_collocation_uvvar_gga( npts, nshells, nbe, points, basis, 
+        shell_list, nbf, submat_map, P, ldp, basis_eval, dbasis_x_eval, 
+        dbasis_y_eval, dbasis_z_eval, zmat, nbe, den_eval, dden_x_eval, 
+        dden_y_eval, dden_z_eval, gamma, nbe_scr );
     else
-      lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list, 
-        basis_eval );
-
+      lwd->eval_collocation_uvvar_lda( npts, nshells, nbe, points, basis, 
+        shell_list, nbf, submat_map, P, ldp, basis_eval, zmat, nbe, den_eval,
+        nbe_scr );
 
-    // Evaluate X matrix (P * B) -> store in Z
-    lwd->eval_xmat( npts, nbf, nbe, submat_map, P, ldp, basis_eval, nbe,
-      zmat, nbe, nbe_scr );
+    // Drop points with negligible density / weight and compact the
+    // survivors to the front of each (column major) buffer
+    int32_t npts_eff = npts;
+    if( screen_low_density ) {
+      host_data.point_scr.resize( npts );
+      auto* keep = host_data.point_scr.data();
+      npts_eff = screen_points( npts, weights, den_eval, 
+        value_type(ks_settings.den_screening_tol), 
+        value_type(ks_settings.weight_screening_tol), keep );
+
+      if( npts_eff != npts ) {
+        host_data.weights_scr.resize( npts );
+        auto* weights_eff = host_data.weights_scr.data();
+        for( int32_t k = 0; k < npts_eff; ++k ) weights_eff[k] = weights[keep[k]];
+        weights = weights_eff;
+
+        compact_columns( nbe, npts_eff, keep, basis_eval, nbe );
+        compact_columns( 1,   npts_eff, keep, den_eval,   1   );
+        if( func.is_gga() ) {
+          compact_columns( nbe, npts_eff, keep, dbasis_x_eval, nbe );
+          compact_columns( nbe, npts_eff, keep, dbasis_y_eval, nbe );
+          compact_columns( nbe, npts_eff, keep, dbasis_z_eval, nbe );
+          compact_columns( 1,   npts_eff, keep, dden_x_eval,   1   );
+          compact_columns( 1,   npts_eff, keep, dden_y_eval,   1   );
+          compact_columns( 1,   npts_eff, keep, dden_z_eval,   1   );
+          compact_columns( 1,   npts_eff, keep, gamma,         1   );
+        }
+        sp_basis.set( npts_eff, nbe, basis_eval );
+      }
+    }
 
+    npts_total_local   += npts;
+    npts_dropped_local += npts - npts_eff;
 
-    // Evaluate U and V variables
-    if( func.is_gga() )
-      lwd->eval_uvvar_gga( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-        dbasis_z_eval, zmat, nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
-        gamma );
-     else
-      lwd->eval_uvvar_lda( npts, nbe, basis_eval, zmat, nbe, den_eval );
+    // Every point was screened, nothing to accumulate
+    if( npts_eff == 0 ) continue;
 
     // Evaluate XC functional
     if( func.is_gga() )
-      func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
+      func.eval_exc_vxc( npts_eff, den_eval, gamma, eps, vrho, vgamma );
     else
-      func.eval_exc_vxc( npts, den_eval, eps, vrho );
+      func.eval_exc_vxc( npts_eff, den_eval, eps, vrho );
 
     // Factor weights into XC results
-    for( int32_t i = 0; i < npts; ++i ) {
+    for( int32_t i = 0; i < npts_eff; ++i ) {
       eps[i]  *= weights[i];
       vrho[i] *= weights[i];
     }
 
     if( func.is_gga() )
-      for( int32_t i = 0; i < npts; ++i ) vgamma[i] *= weights[i];
+      for( int32_t i = 0; i < npts_eff; ++i ) vgamma[i] *= weights[i];
 
 
 
 
     // Evaluate Z matrix for VXC
     if( func.is_gga() )
-      lwd->eval_zmat_gga_vxc( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+      lwd->eval_zmat_gga_vxc( npts_eff, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
                               dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
                               dden_z_eval, zmat, nbe); 
     else
-      lwd->eval_zmat_lda_vxc( npts, nbe, vrho, basis_eval, zmat, nbe ); 
+      lwd->eval_zmat_lda_vxc( npts_eff, nbe, vrho, basis_eval, zmat, nbe ); 
 
 
+    // Scalar integrations
+    for( int32_t i = 0; i < npts_eff; ++i ) {
+      N_EL_local += weights[i] * den_eval[i];
+      EXC_local  += eps[i]     * den_eval[i];
+    }
+
     // Incremeta LT of VXC
-    #pragma omp critical
-    {
-      // Scalar integrations
-      for( int32_t i = 0; i < npts; ++i ) {
-        *N_EL += weights[i] * den_eval[i];
-        *EXC  += eps[i]     * den_eval[i];
-      }
+    if( thread_private_vxc ) {
+
+      lwd->inc_vxc( npts_eff, nbf, nbe, basis_eval, submat_map, zmat, nbe, 
+        VXC_local.data(), nbf, nbe_scr );
+
+    } else if( tile_locked_vxc ) {
+
+      // Form the packed task contribution outside of any lock
+      auto* vxc_packed = nbe_scr + nbe * nbe;
+      std::fill_n( vxc_packed, nbe * nbe, 0. );
+      std::vector< std::array<int32_t,3> > packed_submat_map = { {0, nbe, 0} };
+      lwd->inc_vxc( npts_eff, nbe, nbe, basis_eval, packed_submat_map, zmat, nbe,
+        vxc_packed, nbe, nbe_scr );
 
-      // Increment VXC
-      lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat, nbe, VXC, ldvxc,
+      vxc_locks->inc_by_submat( VXC, ldvxc, vxc_packed, nbe, submat_map );
+
+    } else {
+
+      #pragma omp critical
+      lwd->inc_vxc( npts_eff, nbf, nbe, basis_eval, submat_map, zmat, nbe, VXC, ldvxc,
         nbe_scr );
+
     }
 
   } // Loop over tasks 
 
+  #pragma omp atomic
+  *N_EL += N_EL_local;
+  #pragma omp atomic
+  *EXC  += EXC_local;
+  #pragma omp atomic
+  npts_total   += npts_total_local;
+  #pragma omp atomic
+  npts_dropped += npts_dropped_local;
+
+  // Reduce thread local VXC copies (LT only), distributed over columns
+  if( thread_private_vxc ) {
+    #pragma omp barrier
+
+    #pragma omp for schedule(static)
+    for( int32_t j = 0; j < nbf; ++j )
+    for( auto* VXC_t : vxc_private ) if( VXC_t ) {
+      for( int32_t i = j; i < nbf; ++i )
+        VXC[ i + j*ldvxc ] += VXC_t[ i + j*nbf ];
+    }
+  }
+
   } // End OpenMP region
 
+  this->timer_.add_counter( "XCIntegrator.TotalPoints",    npts_total   );
+  this->timer_.add_counter( "XCIntegrator.ScreenedPoints", npts_dropped );
+  report_collocation_cache_();
+
+  this->timer_.add_counter( "XCIntegrator.MixedPrecision", lwd->mixed_precision() );
+  if( lwd->mixed_precision() ) 
+    report_mixed_precision_deviation_( lwd, P, ldp, 
+      ks_settings.mixed_precision_sample_stride );
+
   //std::cout << "N_EL = " << std::setprecision(12) << std::scientific << *N_EL << std::endl;
 
   // Symmetrize VXC
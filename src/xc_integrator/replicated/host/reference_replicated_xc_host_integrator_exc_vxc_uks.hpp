@@ -0,0 +1,424 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "integrator_util/task_cost.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "vxc_accumulator.hpp"
+#include "point_screening.hpp"
+#include <stdexcept>
+
+namespace GauXC  {
+namespace detail {
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_exc_vxc_( int64_t m, int64_t n, const value_type* Pa,
+                 int64_t ldpa, const value_type* Pb, int64_t ldpb,
+                 value_type* VXCa, int64_t ldvxca, value_type* VXCb,
+                 int64_t ldvxcb, value_type* EXC,
+                 const IntegratorSettingsXC& settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P / VXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Have Same Dimension as Basis");
+  if( ldpa < nbf or ldpb < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+  if( ldvxca < nbf or ldvxcb < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDVXC");
+
+  if( not this->func_->is_polarized() )
+    GAUXC_GENERIC_EXCEPTION("UKS EXC/VXC Requires a Spin Polarized Functional");
+
+
+  // Get Tasks
+  this->load_balancer_->get_tasks();
+
+  // Temporary electron count to judge integrator accuracy
+  value_type N_EL;
+
+  // Compute Local contributions to EXC / VXC
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    exc_vxc_local_work_( Pa, ldpa, Pb, ldpb, VXCa, ldvxca, VXCb, ldvxcb,
+      EXC, &N_EL, settings );
+  });
+
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    this->reduction_driver_->allreduce_inplace( VXCa, nbf*nbf, ReductionOp::Sum );
+    this->reduction_driver_->allreduce_inplace( VXCb, nbf*nbf, ReductionOp::Sum );
+    this->reduction_driver_->allreduce_inplace( EXC,   1    , ReductionOp::Sum );
+    this->reduction_driver_->allreduce_inplace( &N_EL, 1    , ReductionOp::Sum );
+
+  });
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_vxc_local_work_( const value_type* Pa, int64_t ldpa,
+    const value_type* Pb, int64_t ldpb, value_type* VXCa, int64_t ldvxca,
+    value_type* VXCb, int64_t ldvxcb, value_type* EXC, value_type* N_EL,
+    const IntegratorSettingsXC& settings ) {
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+
+  const int32_t nbf = basis.nbf();
+
+  // Sort tasks on size (XXX: maybe doesnt matter?)
+  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
+    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
+  };
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  std::sort( tasks.begin(), tasks.end(), task_comparator );
+
+
+  // Check that Partition Weights have been calculated
+  auto& lb_state = this->load_balancer_->state();
+  if( not lb_state.modified_weights_are_stored ) {
+    GAUXC_GENERIC_EXCEPTION("Weights Have Not Beed Modified");
+  }
+
+  // Determine how task contributions are accumulated into VXCa / VXCb
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+
+  // Two thread private copies (alpha + beta) are required per thread
+  auto ks_settings_uks = ks_settings;
+  ks_settings_uks.vxc_private_max_bytes /= 2;
+  const auto vxc_accumulation =
+    resolve_vxc_accumulation( ks_settings_uks, nbf, sizeof(value_type) );
+  const bool thread_private_vxc =
+    vxc_accumulation == VXCAccumulation::ThreadPrivate;
+  const bool tile_locked_vxc =
+    vxc_accumulation == VXCAccumulation::TileLocked;
+
+  // Mixed precision X / Z GEMMs (if enabled in the LWD), unless the caller
+  // requests full double precision for this evaluation
+  MixedPrecisionGuard mixed_precision_guard( lwd, 
+    lwd->mixed_precision_enabled() and not ks_settings.disable_mixed_precision );
+
+  setup_collocation_cache_( ks_settings );
+
+  std::vector<value_type*> vxc_private( host_max_threads(), nullptr );
+  std::unique_ptr<VXCTileLocks> vxca_locks, vxcb_locks;
+  if( tile_locked_vxc ) {
+    vxca_locks = std::make_unique<VXCTileLocks>( nbf, ks_settings.vxc_lock_tile_size );
+    vxcb_locks = std::make_unique<VXCTileLocks>( nbf, ks_settings.vxc_lock_tile_size );
+  }
+
+  // Zero out integrands
+  for( auto j = 0; j < nbf; ++j )
+  for( auto i = 0; i < nbf; ++i ) {
+    VXCa[i + j*ldvxca] = 0.;
+    VXCb[i + j*ldvxcb] = 0.;
+  }
+  *EXC = 0.;
+  *N_EL = 0.;
+
+  // Point screening statistics
+  const bool screen_low_density = ks_settings.screen_points;
+  size_t npts_total   = 0;
+  size_t npts_dropped = 0;
+
+
+  // Loop over tasks
+  const size_t ntasks = tasks.size();
+
+  const auto host_max = host_data_maxima( *this->load_balancer_ );
+  #pragma omp parallel
+  {
+
+  XCHostData<value_type> host_data( host_max, func.is_gga() ? 4 : 1, 2 ); // Thread local host data
+
+  // Thread local scalar integrands
+  value_type N_EL_local = 0.;
+  value_type EXC_local  = 0.;
+  size_t npts_total_local   = 0;
+  size_t npts_dropped_local = 0;
+
+  // Thread local VXCa / VXCb (first touched by the owning thread)
+  std::vector<value_type> VXC_local;
+  if( thread_private_vxc ) {
+    VXC_local.resize( 2 * nbf * nbf, 0. );
+    vxc_private[ host_thread_num() ] = VXC_local.data();
+  }
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    // Measure the task for subsequent load balancing
+    TaskCostRecorder cost_recorder( tasks[iT].measured_cost.exc_vxc );
+
+    // Alias current task
+    const auto& task = tasks[iT];
+
+    // Get tasks constants
+    const int32_t  npts    = task.points.size();
+    const int32_t  nbe     = task.bfn_screening.nbe;
+
+    const auto* weights     = task.weights.data();
+
+    // Allocate enough memory for batch
+
+    // Things that every calc needs. zmat holds the alpha and beta
+    // X matrices, then the alpha and beta Z matrices
+    // (TileLocked needs an additional packed nbe x nbe buffer)
+    host_data.nbe_scr .resize( (tile_locked_vxc ? 2 : 1) * nbe * nbe );
+    host_data.zmat    .resize( 2 * npts * nbe );
+    host_data.eps     .resize( npts );
+    host_data.vrho    .resize( 2 * npts );
+
+    // LDA data requirements
+    if( func.is_lda() ){
+      host_data.basis_eval .resize( npts * nbe );
+      host_data.den_scr    .resize( 2 * npts );
+    }
+
+    // GGA data requirements
+    if( func.is_gga() ){
+      host_data.basis_eval .resize( 4 * npts * nbe );
+      host_data.den_scr    .resize( 8 * npts );
+      host_data.gamma      .resize( 3 * npts );
+      host_data.vgamma     .resize( 3 * npts );
+    }
+
+    // Alias/Partition out scratch memory
+    auto* basis_eval = host_data.basis_eval.data();
+    auto* den_eval   = host_data.den_scr.data();
+    auto* nbe_scr    = host_data.nbe_scr.data();
+    auto* zmat_a     = host_data.zmat.data();
+    auto* zmat_b     = zmat_a + npts * nbe;
+
+    auto* eps        = host_data.eps.data();
+    auto* gamma      = host_data.gamma.data();
+    auto* vrho       = host_data.vrho.data();
+    auto* vgamma     = host_data.vgamma.data();
+
+    value_type* dbasis_x_eval = nullptr;
+    value_type* dbasis_y_eval = nullptr;
+    value_type* dbasis_z_eval = nullptr;
+    value_type* dden_x_eval = nullptr;
+    value_type* dden_y_eval = nullptr;
+    value_type* dden_z_eval = nullptr;
+
+    if( func.is_gga() ) {
+      dbasis_x_eval = basis_eval    + npts * nbe;
+      dbasis_y_eval = dbasis_x_eval + npts * nbe;
+      dbasis_z_eval = dbasis_y_eval + npts * nbe;
+      dden_x_eval   = den_eval    + 2 * npts;
+      dden_y_eval   = dden_x_eval + 2 * npts;
+      dden_z_eval   = dden_y_eval + 2 * npts;
+    }
+
+
+    // Get the submatrix map for batch (precomputed by the load balancer)
+    const auto& submat_map = task.bfn_screening.submat_map;
+
+    // In mixed precision, the collocation matrix is converted to single
+    // precision once per task and shared by the X and VXC GEMMs of both spins
+    SinglePrecisionBasisScope sp_basis( lwd );
+
+    // Evaluate Collocation (+ Grad) once for both spins
+    eval_collocation_( lwd, task, func.is_gga(), basis_eval );
+    sp_basis.set( npts, nbe, basis_eval );
+
+    // Evaluate X matrices (Ps * B) -> store in Z
+    lwd->eval_xmat( npts, nbf, nbe, submat_map, Pa, ldpa, basis_eval, nbe,
+      zmat_a, nbe, nbe_scr );
+    lwd->eval_xmat( npts, nbf, nbe, submat_map, Pb, ldpb, basis_eval, nbe,
+      zmat_b, nbe, nbe_scr );
+
+    // Evaluate U and V variables
+    if( func.is_gga() )
+      lwd->eval_uvvar_gga_uks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+        dbasis_z_eval, zmat_a, nbe, zmat_b, nbe, den_eval, dden_x_eval,
+        dden_y_eval, dden_z_eval, gamma );
+    else
+      lwd->eval_uvvar_lda_uks( npts, nbe, basis_eval, zmat_a, nbe, zmat_b, nbe,
+        den_eval );
+
+    // Drop points with negligible total density / weight and compact the
+    // survivors to the front of each (column major) buffer. The X matrices
+    // are not referenced past this point
+    int32_t npts_eff = npts;
+    if( screen_low_density ) {
+      for( int32_t i = 0; i < npts; ++i ) eps[i] = den_eval[2*i] + den_eval[2*i+1];
+      host_data.point_scr.resize( npts );
+      auto* keep = host_data.point_scr.data();
+      npts_eff = screen_points( npts, weights, eps, 
+        value_type(ks_settings.den_screening_tol), 
+        value_type(ks_settings.weight_screening_tol), keep );
+
+      if( npts_eff != npts ) {
+        host_data.weights_scr.resize( npts );
+        auto* weights_eff = host_data.weights_scr.data();
+        for( int32_t k = 0; k < npts_eff; ++k ) weights_eff[k] = weights[keep[k]];
+        weights = weights_eff;
+
+        compact_columns( nbe, npts_eff, keep, basis_eval, nbe );
+        compact_columns( 2,   npts_eff, keep, den_eval,   2   );
+        if( func.is_gga() ) {
+          compact_columns( nbe, npts_eff, keep, dbasis_x_eval, nbe );
+          compact_columns( nbe, npts_eff, keep, dbasis_y_eval, nbe );
+          compact_columns( nbe, npts_eff, keep, dbasis_z_eval, nbe );
+          compact_columns( 2,   npts_eff, keep, dden_x_eval,   2   );
+          compact_columns( 2,   npts_eff, keep, dden_y_eval,   2   );
+          compact_columns( 2,   npts_eff, keep, dden_z_eval,   2   );
+          compact_columns( 3,   npts_eff, keep, gamma,         3   );
+        }
+        sp_basis.set( npts_eff, nbe, basis_eval );
+      }
+    }
+
+    npts_total_local   += npts;
+    npts_dropped_local += npts - npts_eff;
+
+    // Every point was screened, nothing to accumulate
+    if( npts_eff == 0 ) continue;
+
+    // Evaluate XC functional
+    if( func.is_gga() )
+      func.eval_exc_vxc( npts_eff, den_eval, gamma, eps, vrho, vgamma );
+    else
+      func.eval_exc_vxc( npts_eff, den_eval, eps, vrho );
+
+    // Factor weights into XC results
+    for( int32_t i = 0; i < npts_eff; ++i ) {
+      eps[i]      *= weights[i];
+      vrho[2*i]   *= weights[i];
+      vrho[2*i+1] *= weights[i];
+    }
+
+    if( func.is_gga() )
+    for( int32_t i = 0; i < npts_eff; ++i ) {
+      vgamma[3*i]   *= weights[i];
+      vgamma[3*i+1] *= weights[i];
+      vgamma[3*i+2] *= weights[i];
+    }
+
+
+
+    // Evaluate Z matrices for VXCa / VXCb
+    if( func.is_gga() )
+      lwd->eval_zmat_gga_vxc_uks( npts_eff, nbe, vrho, vgamma, basis_eval,
+        dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
+        dden_z_eval, zmat_a, nbe, zmat_b, nbe );
+    else
+      lwd->eval_zmat_lda_vxc_uks( npts_eff, nbe, vrho, basis_eval, zmat_a, nbe,
+        zmat_b, nbe );
+
+
+    // Scalar integrations
+    for( int32_t i = 0; i < npts_eff; ++i ) {
+      const auto rho = den_eval[2*i] + den_eval[2*i+1];
+      N_EL_local += weights[i] * rho;
+      EXC_local  += eps[i]     * rho;
+    }
+
+    // Incremeta LT of VXCa / VXCb
+    if( thread_private_vxc ) {
+
+      lwd->inc_vxc( npts_eff, nbf, nbe, basis_eval, submat_map, zmat_a, nbe,
+        VXC_local.data(), nbf, nbe_scr );
+      lwd->inc_vxc( npts_eff, nbf, nbe, basis_eval, submat_map, zmat_b, nbe,
+        VXC_local.data() + nbf*nbf, nbf, nbe_scr );
+
+    } else if( tile_locked_vxc ) {
+
+      // Form the packed task contributions outside of any lock
+      auto* vxc_packed = nbe_scr + nbe * nbe;
+      std::vector< std::array<int32_t,3> > packed_submat_map = { {0, nbe, 0} };
+
+      std::fill_n( vxc_packed, nbe * nbe, 0. );
+      lwd->inc_vxc( npts_eff, nbe, nbe, basis_eval, packed_submat_map, zmat_a, nbe,
+        vxc_packed, nbe, nbe_scr );
+      vxca_locks->inc_by_submat( VXCa, ldvxca, vxc_packed, nbe, submat_map );
+
+      std::fill_n( vxc_packed, nbe * nbe, 0. );
+      lwd->inc_vxc( npts_eff, nbe, nbe, basis_eval, packed_submat_map, zmat_b, nbe,
+        vxc_packed, nbe, nbe_scr );
+      vxcb_locks->inc_by_submat( VXCb, ldvxcb, vxc_packed, nbe, submat_map );
+
+    } else {
+
+      #pragma omp critical
+      {
+        lwd->inc_vxc( npts_eff, nbf, nbe, basis_eval, submat_map, zmat_a, nbe,
+          VXCa, ldvxca, nbe_scr );
+        lwd->inc_vxc( npts_eff, nbf, nbe, basis_eval, submat_map, zmat_b, nbe,
+          VXCb, ldvxcb, nbe_scr );
+      }
+
+    }
+
+  } // Loop over tasks
+
+  #pragma omp atomic
+  *N_EL += N_EL_local;
+  #pragma omp atomic
+  *EXC  += EXC_local;
+  #pragma omp atomic
+  npts_total   += npts_total_local;
+  #pragma omp atomic
+  npts_dropped += npts_dropped_local;
+
+  // Reduce thread local VXC copies (LT only), distributed over columns
+  if( thread_private_vxc ) {
+    #pragma omp barrier
+
+    #pragma omp for schedule(static)
+    for( int32_t j = 0; j < nbf; ++j )
+    for( auto* VXC_t : vxc_private ) if( VXC_t ) {
+      const auto* VXCa_t = VXC_t;
+      const auto* VXCb_t = VXC_t + nbf*nbf;
+      for( int32_t i = j; i < nbf; ++i ) {
+        VXCa[ i + j*ldvxca ] += VXCa_t[ i + j*nbf ];
+        VXCb[ i + j*ldvxcb ] += VXCb_t[ i + j*nbf ];
+      }
+    }
+  }
+
+  } // End OpenMP region
+
+  this->timer_.add_counter( "XCIntegrator.TotalPoints",    npts_total   );
+  this->timer_.add_counter( "XCIntegrator.ScreenedPoints", npts_dropped );
+  report_collocation_cache_();
+  this->timer_.add_counter( "XCIntegrator.MixedPrecision", lwd->mixed_precision() );
+
+  // Symmetrize VXCa / VXCb
+  for( int32_t j = 0;   j < nbf; ++j )
+  for( int32_t i = j+1; i < nbf; ++i ) {
+    VXCa[ j + i*ldvxca ] = VXCa[ i + j*ldvxca ];
+    VXCb[ j + i*ldvxcb ] = VXCb[ i + j*ldvxcb ];
+  }
+
+}
+
+}
+}
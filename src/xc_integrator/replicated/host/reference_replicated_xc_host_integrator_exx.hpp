@@ -9,8 +9,10 @@
 
 #include "reference_replicated_xc_host_integrator.hpp"
 #include "integrator_util/integrator_common.hpp"
+#include "integrator_util/task_cost.hpp"
 #include "integrator_util/integral_bounds.hpp"
 #include "integrator_util/exx_screening.hpp"
+#include "integrator_util/task_merge.hpp"
 #include "host/local_host_work_driver.hpp"
 #include "host/blas.hpp"
 #include <stdexcept>
@@ -276,11 +278,10 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   // Setup Aliases
   const auto& basis = this->load_balancer_->basis();
-  const auto& mol   = this->load_balancer_->molecule();
 
 
   // Get basis map
-  BasisSetMap basis_map(basis,mol);
+  const auto& basis_map = this->load_balancer_->basis_map();
 
   const int32_t nbf = basis.nbf();
 
@@ -289,8 +290,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
   };
 
-  auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( tasks.begin(), tasks.end(), task_comparator );
+  auto& lb_tasks = this->load_balancer_->get_tasks();
+  std::sort( lb_tasks.begin(), lb_tasks.end(), task_comparator );
 
 
   // Check that Partition Weights have been calculated
@@ -358,102 +359,63 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   //}
 
   // Reset the coulomb screening data
-  for(auto& task : tasks) task.cou_screening = XCTask::screening_data();
+  for(auto& task : lb_tasks) task.cou_screening = XCTask::screening_data();
 
   // Precompute EK shell screening
   exx_ek_screening( basis, basis_map, P_abs.data(), nbf, V_max.data(), 
-    nshells_bf, eps_E, eps_K, lwd, tasks.begin(), tasks.end() );
-
-  // Allow for merging of tasks with different iParent
+    nshells_bf, eps_E, eps_K, lwd, host_data_maxima( *this->load_balancer_ ),
+    lb_tasks.begin(), lb_tasks.end() );
+
+  // Merge a copy of the tasks with equivalent bfn and cou screening data, 
+  // allowing for different iParent. The load balancer tasks keep their 
+  // parents for subsequent (e.g. weight derivative) calculations
+  std::vector<size_t> group_ptr, group_members;
+  std::vector<XCTask> tasks( lb_tasks );
   for(auto& task : tasks) task.iParent = 0;
+  tasks = merge_equivalent_tasks( std::move(tasks), true, &group_ptr, 
+    &group_members );
 
-#if 1
-  // Lexicographic ordering of tasks
-  auto task_order = []( const auto& a, const auto& b ) {
-
-    // Sort by iParent first
-    if( a.iParent < b.iParent )      return true;
-    else if( a.iParent > b.iParent ) return false;
-
-    // Equal iParent: lex sort on bfn shell list
-    else if(a.bfn_screening.shell_list < b.bfn_screening.shell_list) return true;
-    else if(a.bfn_screening.shell_list > b.bfn_screening.shell_list) return false;
-    
-    // Equal iParent and bfn shell list: lex sort on cou shell list
-    else return a.cou_screening.shell_list < b.cou_screening.shell_list;
-
-  };
-
-  std::sort( tasks.begin(), tasks.end(), task_order ); 
-  auto task_equiv = []( const auto& a, const auto& b ) {
-    return a.equiv_with(b) and 
-      a.cou_screening.equiv_with(b.cou_screening);
-  };
-  std::vector<XCTask> local_work_unique(tasks.begin(), tasks.end());
-  auto last_unique =
-    std::unique( local_work_unique.begin(),
-                 local_work_unique.end(),
-                 task_equiv );
-  local_work_unique.erase( last_unique, local_work_unique.end() );
-
-  // Merge tasks
-  for( auto&& t : local_work_unique ) {
-    t.points.clear();
-    t.weights.clear();
-    t.npts = 0;
-  }
-
-  auto cur_lw_begin = tasks.begin();
-  auto cur_uniq_it  = local_work_unique.begin();
-
-  for( auto lw_it = tasks.begin(); lw_it != tasks.end(); ++lw_it ) 
-  if( not task_equiv( *lw_it, *cur_uniq_it ) ) {
+  std::vector<size_t> task_order( tasks.size() );
+  std::iota( task_order.begin(), task_order.end(), 0 );
+  std::sort(task_order.begin(),task_order.end(),
+    [&](auto a, auto b){ return tasks[a].cou_screening.shell_pair_list.size() >
+      tasks[b].cou_screening.shell_pair_list.size(); });
 
-    if( cur_uniq_it == local_work_unique.end() )
-      GAUXC_GENERIC_EXCEPTION("Messed up in unique");
-
-    cur_uniq_it->merge_with( cur_lw_begin, lw_it );
-
-    cur_lw_begin = lw_it;
-    cur_uniq_it++;
 
+  if( collocation_cache_ ) {
+    collocation_cache_->sync_generation( lb_state.task_generation );
+    collocation_cache_->reset_stats();
   }
 
-  // Merge the last set of batches
-  for( ; cur_lw_begin != tasks.end(); ++cur_lw_begin )
-    cur_uniq_it->merge_with( *cur_lw_begin );
-  cur_uniq_it++;
-
-  tasks = std::move(local_work_unique);
-#endif
-
-  std::sort(tasks.begin(),tasks.end(),
-    [](auto& a, auto& b){ return a.cou_screening.shell_pair_list.size() >
-      b.cou_screening.shell_pair_list.size(); });
-
-
   // Loop over tasks
   const size_t ntasks = tasks.size();
   //std::cout << "NTASKS = " << ntasks << std::endl;
   //std::cout << "NTASKS NNZ = " << std::count_if(tasks.begin(),tasks.end(),[](const auto& t){ return t.cou_screening.shell_pair_list.size(); }) << std::endl;
+  const auto host_max = host_data_maxima( *this->load_balancer_ );
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  XCHostData<value_type> host_data( host_max, 1 ); // Thread local host data
   std::vector<double> K_local(nbf*nbf,0.0);
 
   #pragma omp for schedule(dynamic)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
 
+    // Measure the task for subsequent load balancing
+    const size_t iG = task_order[iT];
+    TaskCostRecorder cost_recorder( tasks[iG].measured_cost.exx );
+
     //std::cout << iT << "/" << ntasks << std::endl;
     // Alias current task
-    const auto& task = tasks[iT];
+    const auto& task = tasks[iG];
 
     // Early exit
     auto ek_shell_list = task.cou_screening.shell_list;
     if( ek_shell_list.size() == 0 ) {
       continue;
     }
+
+    // EK screening depends on P, so its submatrix map is generated per call
     std::vector< std::array<int32_t,3> > ek_submat_map;
     std::tie( ek_submat_map, std::ignore ) =
       gen_compressed_submat_map( basis_map, ek_shell_list, nbf, nbf );
@@ -471,9 +433,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     size_t nbe_bfn     = 
       basis.nbf_subset( shell_list_bfn_.begin(), shell_list_bfn_.end() );
 
-    std::vector< std::array<int32_t, 3> > submat_map_bfn;
-    std::tie(submat_map_bfn, std::ignore) =
-      gen_compressed_submat_map( basis_map, shell_list_bfn_, nbf, nbf );
+    // Precomputed by the load balancer
+    const auto& submat_map_bfn = task.bfn_screening.submat_map;
     
 
 
@@ -486,9 +447,26 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
 
     // Evaluate collocation B(mu,i)
-    // mu ranges over the bfn shell list and i runs over all points
-    lwd->eval_collocation( npts, nshells_bfn, nbe_bfn, points, basis, 
-      shell_list_bfn, basis_eval );
+    // mu ranges over the bfn shell list and i runs over all points.
+    // The points of the merged task are those of its load balancer tasks 
+    // in order, i.e. B is assembled from their cached collocations
+    bool cached = bool(collocation_cache_);
+    for( size_t m = group_ptr[iG], off = 0; cached and m < group_ptr[iG+1]; ++m ) {
+      const auto& lb_task = lb_tasks[group_members[m]];
+      cached = collocation_cache_->load( lb_task, 1, basis_eval + off*nbe_bfn );
+      off += lb_task.points.size();
+    }
+
+    if( not cached ) {
+      lwd->eval_collocation( npts, nshells_bfn, nbe_bfn, points, basis, 
+        shell_list_bfn, basis_eval );
+      if( collocation_cache_ )
+      for( size_t m = group_ptr[iG], off = 0; m < group_ptr[iG+1]; ++m ) {
+        const auto& lb_task = lb_tasks[group_members[m]];
+        collocation_cache_->store( lb_task, 1, basis_eval + off*nbe_bfn );
+        off += lb_task.points.size();
+      }
+    }
 
     const auto nbe_ek = basis.nbf_subset( ek_shell_list.begin(), ek_shell_list.end() );
     const auto nshells_ek = ek_shell_list.size();
@@ -541,6 +519,18 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   } // End OpenMP region
 
+  report_collocation_cache_();
+
+  // Attribute the measured costs to the load balancer tasks by point count
+  for( size_t iG = 0; iG < tasks.size(); ++iG ) {
+    const double cost_per_point = 
+      tasks[iG].measured_cost.exx / std::max<size_t>( tasks[iG].points.size(), 1 );
+    for( auto m = group_ptr[iG]; m < group_ptr[iG+1]; ++m ) {
+      auto& lb_task = lb_tasks[group_members[m]];
+      lb_task.measured_cost.exx = cost_per_point * lb_task.points.size();
+    }
+  }
+
   // Symmetrize K
   for( auto j = 0; j < nbf; ++j ) 
   for( auto i = 0; i < j;   ++i ) {
@@ -0,0 +1,353 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "vxc_accumulator.hpp"
+#include <stdexcept>
+
+namespace GauXC  {
+namespace detail {
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_fxc_contraction_( int64_t ndm, int64_t m, int64_t n,
+                         const value_type* P0, int64_t ldp0,
+                         const value_type* const* dP, int64_t lddp,
+                         value_type* const* FXC, int64_t ldfxc,
+                         const IntegratorSettingsXC& settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P0 / dP / FXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/FXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/FXC Must Have Same Dimension as Basis");
+  if( ldp0 < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP0");
+  if( lddp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDDP");
+  if( ldfxc < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDFXC");
+
+  if( this->func_->is_polarized() )
+    GAUXC_GENERIC_EXCEPTION("FXC Contraction Requires an Unpolarized Functional");
+
+
+  // Get Tasks
+  this->load_balancer_->get_tasks();
+
+  // Compute Local contributions to FXC
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    fxc_contraction_local_work_( ndm, P0, ldp0, dP, lddp, FXC, ldfxc, settings );
+  });
+
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    for( int64_t k = 0; k < ndm; ++k )
+      this->reduction_driver_->allreduce_inplace( FXC[k], nbf*nbf, ReductionOp::Sum );
+
+  });
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  fxc_contraction_local_work_( int64_t ndm, const value_type* P0, int64_t ldp0,
+    const value_type* const* dP, int64_t lddp, value_type* const* FXC,
+    int64_t ldfxc, const IntegratorSettingsXC& settings ) {
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+
+  const int32_t nbf = basis.nbf();
+
+  // Sort tasks on size (XXX: maybe doesnt matter?)
+  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
+    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
+  };
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  std::sort( tasks.begin(), tasks.end(), task_comparator );
+
+
+  // Check that Partition Weights have been calculated
+  auto& lb_state = this->load_balancer_->state();
+  if( not lb_state.modified_weights_are_stored ) {
+    GAUXC_GENERIC_EXCEPTION("Weights Have Not Beed Modified");
+  }
+
+  // Determine how task contributions are accumulated into FXC
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+  if( ks_settings.screen_points )
+    GAUXC_GENERIC_EXCEPTION("Point Screening NYI for FXC Contraction");
+
+  // ndm thread private copies are required per thread
+  auto ks_settings_batch = ks_settings;
+  ks_settings_batch.vxc_private_max_bytes /= ndm;
+  const auto vxc_accumulation =
+    resolve_vxc_accumulation( ks_settings_batch, nbf, sizeof(value_type) );
+  const bool thread_private_fxc =
+    vxc_accumulation == VXCAccumulation::ThreadPrivate;
+  const bool tile_locked_fxc =
+    vxc_accumulation == VXCAccumulation::TileLocked;
+
+  setup_collocation_cache_( ks_settings );
+
+  std::vector<value_type*> fxc_private( host_max_threads(), nullptr );
+  std::vector<std::unique_ptr<VXCTileLocks>> fxc_locks;
+  if( tile_locked_fxc )
+  for( int64_t k = 0; k < ndm; ++k ) {
+    fxc_locks.emplace_back(
+      std::make_unique<VXCTileLocks>( nbf, ks_settings.vxc_lock_tile_size ) );
+  }
+
+  // Zero out integrands
+  for( int64_t k = 0; k < ndm; ++k )
+  for( auto j = 0; j < nbf; ++j )
+  for( auto i = 0; i < nbf; ++i )
+    FXC[k][i + j*ldfxc] = 0.;
+
+
+  // Loop over tasks
+  const size_t ntasks = tasks.size();
+
+  const auto host_max = host_data_maxima( *this->load_balancer_ );
+  #pragma omp parallel
+  {
+
+  XCHostData<value_type> host_data( host_max, func.is_gga() ? 4 : 1,
+      2*ndm + 1, 2*ndm ); // Thread local host data
+
+  // Thread local FXC (first touched by the owning thread)
+  std::vector<value_type>  FXC_local;
+  std::vector<value_type*> FXC_local_ptr( ndm );
+  if( thread_private_fxc ) {
+    FXC_local.resize( ndm * nbf * nbf, 0. );
+    fxc_private[ host_thread_num() ] = FXC_local.data();
+    for( int64_t k = 0; k < ndm; ++k )
+      FXC_local_ptr[k] = FXC_local.data() + k*nbf*nbf;
+  }
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    // Alias current task
+    const auto& task = tasks[iT];
+
+    // Get tasks constants
+    const int32_t  npts    = task.points.size();
+    const int32_t  nbe     = task.bfn_screening.nbe;
+
+    const auto* weights     = task.weights.data();
+
+    // Allocate enough memory for batch
+
+    // Things that every calc needs. zmat holds the ground state X matrix,
+    // the stacked trial X matrices and the stacked trial Z matrices
+    host_data.nbe_scr .resize( (tile_locked_fxc ? 2 : 1) * ndm * nbe * nbe );
+    host_data.zmat    .resize( (2*ndm + 1) * npts * nbe );
+    host_data.v2rho2  .resize( npts );
+
+    // LDA data requirements
+    if( func.is_lda() ){
+      host_data.basis_eval .resize( npts * nbe );
+      host_data.den_scr    .resize( 2 * npts );
+    }
+
+    // GGA data requirements
+    if( func.is_gga() ){
+      host_data.basis_eval .resize( 4 * npts * nbe );
+      host_data.den_scr    .resize( 8 * npts );
+      host_data.gamma      .resize( 2 * npts );
+      host_data.vrho       .resize( npts );
+      host_data.vgamma     .resize( npts );
+      host_data.v2rhogamma .resize( npts );
+      host_data.v2gamma2   .resize( npts );
+    }
+
+    // Alias/Partition out scratch memory
+    auto* basis_eval = host_data.basis_eval.data();
+    auto* den_eval   = host_data.den_scr.data();
+    auto* nbe_scr    = host_data.nbe_scr.data();
+    auto* xmat       = host_data.zmat.data();
+    auto* xmat1      = xmat  + npts * nbe;
+    auto* zmat       = xmat1 + ndm * npts * nbe;
+    const int32_t ldx1 = ndm * nbe;
+
+    auto* gamma      = host_data.gamma.data();
+    auto* vrho       = host_data.vrho.data();
+    auto* vgamma     = host_data.vgamma.data();
+    auto* v2rho2     = host_data.v2rho2.data();
+    auto* v2rhogamma = host_data.v2rhogamma.data();
+    auto* v2gamma2   = host_data.v2gamma2.data();
+
+    value_type* den1_eval = den_eval + (func.is_gga() ? 4 : 1) * npts;
+    value_type* gamma1    = nullptr;
+
+    value_type* dbasis_x_eval = nullptr;
+    value_type* dbasis_y_eval = nullptr;
+    value_type* dbasis_z_eval = nullptr;
+    value_type* dden_x_eval  = nullptr;
+    value_type* dden_y_eval  = nullptr;
+    value_type* dden_z_eval  = nullptr;
+    value_type* dden1_x_eval = nullptr;
+    value_type* dden1_y_eval = nullptr;
+    value_type* dden1_z_eval = nullptr;
+
+    if( func.is_gga() ) {
+      dbasis_x_eval = basis_eval    + npts * nbe;
+      dbasis_y_eval = dbasis_x_eval + npts * nbe;
+      dbasis_z_eval = dbasis_y_eval + npts * nbe;
+      dden_x_eval   = den_eval     + npts;
+      dden_y_eval   = dden_x_eval  + npts;
+      dden_z_eval   = dden_y_eval  + npts;
+      dden1_x_eval  = den1_eval    + npts;
+      dden1_y_eval  = dden1_x_eval + npts;
+      dden1_z_eval  = dden1_y_eval + npts;
+      gamma1        = gamma        + npts;
+    }
+
+
+    // Get the submatrix map for batch (precomputed by the load balancer)
+    const auto& submat_map = task.bfn_screening.submat_map;
+
+    // Evaluate Collocation (+ Grad) once for the ground state and all
+    // trial densities
+    eval_collocation_( lwd, task, func.is_gga(), basis_eval );
+
+    // Ground state X matrix and all trial X matrices in a single GEMM
+    lwd->eval_xmat( npts, nbf, nbe, submat_map, P0, ldp0, basis_eval, nbe,
+      xmat, nbe, nbe_scr );
+    lwd->eval_xmat_batched( ndm, npts, nbf, nbe, submat_map, dP, lddp,
+      basis_eval, nbe, xmat1, ldx1, nbe_scr );
+
+    // Evaluate ground state U and V variables
+    if( func.is_gga() )
+      lwd->eval_uvvar_gga( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+        dbasis_z_eval, xmat, nbe, den_eval, dden_x_eval, dden_y_eval,
+        dden_z_eval, gamma );
+    else
+      lwd->eval_uvvar_lda( npts, nbe, basis_eval, xmat, nbe, den_eval );
+
+    // Evaluate XC kernel (and the first derivatives wrt gamma for GGA)
+    if( func.is_gga() )
+      func.eval_vxc_fxc( npts, den_eval, gamma, vrho, vgamma, v2rho2,
+        v2rhogamma, v2gamma2 );
+    else
+      func.eval_fxc( npts, den_eval, v2rho2 );
+
+    // Factor weights into XC results
+    for( int32_t i = 0; i < npts; ++i ) v2rho2[i] *= weights[i];
+
+    if( func.is_gga() )
+    for( int32_t i = 0; i < npts; ++i ) {
+      vgamma[i]     *= weights[i];
+      v2rhogamma[i] *= weights[i];
+      v2gamma2[i]   *= weights[i];
+    }
+
+    // Evaluate the stacked Z matrices for each trial density
+    for( int64_t k = 0; k < ndm; ++k ) {
+
+      const auto* xmat1_k = xmat1 + k * nbe;
+      auto*       zmat_k  = zmat  + k * nbe;
+
+      if( func.is_gga() ) {
+        lwd->eval_uvvar_gga( npts, nbe, basis_eval, dbasis_x_eval,
+          dbasis_y_eval, dbasis_z_eval, xmat1_k, ldx1, den1_eval, dden1_x_eval,
+          dden1_y_eval, dden1_z_eval, gamma1 );
+        lwd->eval_zmat_gga_fxc( npts, nbe, vgamma, v2rho2, v2rhogamma, v2gamma2,
+          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, dden_x_eval,
+          dden_y_eval, dden_z_eval, den1_eval, dden1_x_eval, dden1_y_eval,
+          dden1_z_eval, zmat_k, ldx1 );
+      } else {
+        lwd->eval_uvvar_lda( npts, nbe, basis_eval, xmat1_k, ldx1, den1_eval );
+        lwd->eval_zmat_lda_fxc( npts, nbe, v2rho2, basis_eval, den1_eval,
+          zmat_k, ldx1 );
+      }
+
+    } // Loop over trial densities
+
+    // Incremeta LT of FXC for all trial densities
+    if( thread_private_fxc ) {
+
+      lwd->inc_vxc_batched( ndm, npts, nbf, nbe, basis_eval, submat_map, zmat,
+        ldx1, FXC_local_ptr.data(), nbf, nbe_scr );
+
+    } else if( tile_locked_fxc ) {
+
+      // Form the packed task contributions outside of any lock
+      auto* fxc_packed = nbe_scr + ndm * nbe * nbe;
+      std::fill_n( fxc_packed, ndm * nbe * nbe, 0. );
+      std::vector<value_type*> fxc_packed_ptr( ndm );
+      for( int64_t k = 0; k < ndm; ++k )
+        fxc_packed_ptr[k] = fxc_packed + k * nbe * nbe;
+
+      std::vector< std::array<int32_t,3> > packed_submat_map = { {0, nbe, 0} };
+      lwd->inc_vxc_batched( ndm, npts, nbe, nbe, basis_eval, packed_submat_map,
+        zmat, ldx1, fxc_packed_ptr.data(), nbe, nbe_scr );
+
+      for( int64_t k = 0; k < ndm; ++k )
+        fxc_locks[k]->inc_by_submat( FXC[k], ldfxc, fxc_packed_ptr[k], nbe,
+          submat_map );
+
+    } else {
+
+      #pragma omp critical
+      lwd->inc_vxc_batched( ndm, npts, nbf, nbe, basis_eval, submat_map, zmat,
+        ldx1, FXC, ldfxc, nbe_scr );
+
+    }
+
+  } // Loop over tasks
+
+  // Reduce thread local FXC copies (LT only), distributed over columns
+  if( thread_private_fxc ) {
+    #pragma omp barrier
+
+    #pragma omp for schedule(static)
+    for( int32_t j = 0; j < nbf; ++j )
+    for( auto* FXC_t : fxc_private ) if( FXC_t )
+    for( int64_t k = 0; k < ndm; ++k ) {
+      const auto* FXC_tk = FXC_t + k*nbf*nbf;
+      for( int32_t i = j; i < nbf; ++i )
+        FXC[k][ i + j*ldfxc ] += FXC_tk[ i + j*nbf ];
+    }
+  }
+
+  } // End OpenMP region
+
+  report_collocation_cache_();
+
+  // Symmetrize FXC
+  for( int64_t k = 0; k < ndm; ++k )
+  for( int32_t j = 0;   j < nbf; ++j )
+  for( int32_t i = j+1; i < nbf; ++i )
+    FXC[k][ j + i*ldfxc ] = FXC[k][ i + j*ldfxc ];
+
+}
+
+}
+}
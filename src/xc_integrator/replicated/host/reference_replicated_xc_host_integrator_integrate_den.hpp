@@ -64,10 +64,6 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   // Setup Aliases
   const auto& basis = this->load_balancer_->basis();
-  const auto& mol   = this->load_balancer_->molecule();
-
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
 
   const int32_t nbf = basis.nbf();
 
@@ -91,10 +87,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   // Loop over tasks
   const size_t ntasks = tasks.size();
 
+  const auto host_max = host_data_maxima( *this->load_balancer_ );
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  XCHostData<value_type> host_data( host_max, 1 ); // Thread local host data
   double N_EL_LOCAL = 0.;
 
   #pragma omp for schedule(dynamic)
@@ -129,23 +126,14 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     auto* zmat       = host_data.zmat.data();
 
 
-    // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
-
-    // Evaluate Collocation (+ Grad)
-    lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list, 
-      basis_eval );
-
-
-    // Evaluate X matrix (P * B) -> store in Z
-    lwd->eval_xmat( npts, nbf, nbe, submat_map, P, ldp, basis_eval, nbe,
-      zmat, nbe, nbe_scr );
-
+    // Get the submatrix map for batch (precomputed by the load balancer)
+    const auto& submat_map = task.bfn_screening.submat_map;
 
-    // Evaluate density on grid
-    lwd->eval_uvvar_lda( npts, nbe, basis_eval, zmat, nbe, den_eval );
+    // Evaluate Collocation, X matrix (P * B) -> store in Z, and
+    // the density on the grid
+    lwd->eval_collocation_uvvar_lda( npts, nshells, nbe, points, basis, 
+      shell_list, nbf, submat_map, P, ldp, basis_eval, zmat, nbe, den_eval,
+      nbe_scr );
 
     // Scalar integrations
     for( int32_t i = 0; i < npts; ++i ) {
@@ -0,0 +1,134 @@
+/**
+ * GauXC Copyright (c) 2020-2023, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/xc_integrator_settings.hpp>
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace GauXC  {
+namespace detail {
+
+inline int host_max_threads() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+inline int host_thread_num() {
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+/**
+ *  @brief Resolve the requested VXC accumulation scheme into the one
+ *  which will actually be used.
+ *
+ *  Auto selects Critical for a single thread and ThreadPrivate otherwise.
+ *  ThreadPrivate falls back to TileLocked if nthreads copies of VXC
+ *  would exceed the memory cap.
+ */
+inline VXCAccumulation resolve_vxc_accumulation(
+  const IntegratorSettingsKS& settings, int64_t nbf, size_t elem_size ) {
+
+  const int64_t nthreads = host_max_threads();
+  auto scheme = settings.vxc_accumulation;
+
+  if( scheme == VXCAccumulation::Auto and nthreads == 1 )
+    return VXCAccumulation::Critical;
+
+  if( scheme == VXCAccumulation::Auto or
+      scheme == VXCAccumulation::ThreadPrivate ) {
+    const size_t private_bytes = nthreads * nbf * nbf * elem_size;
+    scheme = (private_bytes <= settings.vxc_private_max_bytes) ?
+      VXCAccumulation::ThreadPrivate : VXCAccumulation::TileLocked;
+  }
+
+  return scheme;
+}
+
+/**
+ *  @brief Locks over column tiles of a shared (lower triangular) VXC
+ *
+ *  Increments from different tasks only contend when they touch
+ *  the same column tile. Each increment holds at most one lock at
+ *  a time, so no lock ordering is required.
+ */
+class VXCTileLocks {
+
+  int32_t tile_size_;
+  std::vector<std::mutex> locks_;
+
+public:
+
+  VXCTileLocks( int32_t nbf, int32_t tile_size ) :
+    tile_size_( std::max(tile_size, 1) ),
+    locks_( (nbf + tile_size_ - 1) / tile_size_ ) { }
+
+  /**
+   *  @brief Increment the lower triangle of VXC by a packed
+   *  nbe x nbe task contribution.
+   *
+   *  @param[in/out] VXC        Shared VXC matrix
+   *  @param[in]     ldvxc      Leading dimension of VXC
+   *  @param[in]     ASmall     Packed task contribution (lower triangle referenced)
+   *  @param[in]     ldas       Leading dimension of ASmall
+   *  @param[in]     submat_map Compressed submatrix map for the task
+   */
+  template <typename F>
+  void inc_by_submat( F* VXC, int64_t ldvxc, const F* ASmall, int64_t ldas,
+    const std::vector<std::array<int32_t,3>>& submat_map ) {
+
+    int32_t j(0);
+    for( auto& jCut : submat_map ) {
+      const int32_t j_st = jCut[0];
+      const int32_t j_en = jCut[0] + jCut[1];
+
+      for( int32_t c_st = j_st; c_st < j_en; ) {
+        const int32_t tile = c_st / tile_size_;
+        const int32_t c_en = std::min( j_en, (tile + 1) * tile_size_ );
+
+        std::lock_guard<std::mutex> lock( locks_[tile] );
+
+        int32_t i(0);
+        for( auto& iCut : submat_map ) {
+          const int32_t deltaI = iCut[1];
+
+          // Skip blocks which lie strictly in the upper triangle
+          if( iCut[0] + deltaI > c_st ) {
+            for( int32_t jj = c_st; jj < c_en; ++jj )
+            for( int32_t ii = 0;    ii < deltaI; ++ii )
+              VXC[ iCut[0] + ii + jj*ldvxc ] +=
+                ASmall[ i + ii + (j + jj - j_st)*ldas ];
+          }
+
+          i += deltaI;
+        }
+
+        c_st = c_en;
+      }
+
+      j += jCut[1];
+    }
+
+  }
+
+};
+
+}
+}
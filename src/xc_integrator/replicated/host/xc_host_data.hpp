@@ -6,29 +6,180 @@
  * See LICENSE.txt for details
  */
 #pragma once
-#include <vector>
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
 
 #include <gauxc/gauxc_config.hpp>
 
 namespace GauXC {
 
+namespace detail {
+
+/// Alignment of host scratch buffers (bytes)
+inline constexpr size_t host_scratch_alignment = 64;
+
+inline constexpr size_t align_host_scratch( size_t bytes ) {
+  return (bytes + host_scratch_alignment - 1) / host_scratch_alignment *
+    host_scratch_alignment;
+}
+
+struct aligned_host_free {
+  void operator()( void* ptr ) const noexcept { std::free(ptr); }
+};
+
+using aligned_host_ptr = std::unique_ptr<void, aligned_host_free>;
+
+/// Allocate (uninitialized) host memory aligned to `host_scratch_alignment`
+inline aligned_host_ptr aligned_host_alloc( size_t bytes ) {
+  if( not bytes ) return nullptr;
+  void* ptr = std::aligned_alloc( host_scratch_alignment,
+    align_host_scratch(bytes) );
+  if( not ptr ) throw std::bad_alloc();
+  return aligned_host_ptr( ptr );
+}
+
+/** Scratch buffer carved out of a thread's XCHostData arena
+ *
+ *  Unlike std::vector, resize neither shrinks nor initializes the buffer.
+ *  Requests exceeding the carved capacity move the buffer into its own
+ *  aligned allocation, first touched by the calling thread.
+ */
+template <typename T>
+class HostScratch {
+
+  T*     ptr_      = nullptr;
+  size_t size_     = 0;
+  size_t capacity_ = 0;
+  aligned_host_ptr owned_;
+
+public:
+
+  inline void bind( T* ptr, size_t capacity ) {
+    owned_.reset();
+    ptr_      = ptr;
+    capacity_ = capacity;
+    size_     = 0;
+  }
+
+  inline void resize( size_t n ) {
+    if( n > capacity_ ) {
+      owned_    = aligned_host_alloc( n * sizeof(T) );
+      ptr_      = static_cast<T*>( owned_.get() );
+      capacity_ = n;
+      std::memset( ptr_, 0, n * sizeof(T) ); // First touch
+    }
+    size_ = n;
+  }
+
+  inline T*       data()       { return ptr_; }
+  inline const T* data() const { return ptr_; }
+  inline size_t   size()     const { return size_;     }
+  inline size_t   capacity() const { return capacity_; }
+
+  inline T&       operator[]( size_t i )       { return ptr_[i]; }
+  inline const T& operator[]( size_t i ) const { return ptr_[i]; }
+
+};
+
+}
+
+/// Load balancer maxima used to size XCHostData arenas
+struct XCHostDataMaxima {
+  size_t npts;       ///< Max number of points in a local task
+  size_t nbe;        ///< Max number of non-negligible bfns in a local task
+  size_t npts_x_nbe; ///< Max npts * nbe over local tasks
+};
+
+template <typename LoadBalancerType>
+inline XCHostDataMaxima host_data_maxima( const LoadBalancerType& lb ) {
+  return XCHostDataMaxima{ lb.max_npts(), lb.max_nbe(), lb.max_npts_x_nbe() };
+}
+
 template <typename F>
 struct XCHostData {
 
-  std::vector<F> eps;
-  std::vector<F> gamma;
-  std::vector<F> vrho;
-  std::vector<F> vgamma;
- 
-  std::vector<F> zmat;
-  std::vector<F> gmat;
-  std::vector<F> nbe_scr;
-  std::vector<F> den_scr;
-  std::vector<F> basis_eval;
-   
+  detail::HostScratch<F> eps;
+  detail::HostScratch<F> gamma;
+  detail::HostScratch<F> vrho;
+  detail::HostScratch<F> vgamma;
+  detail::HostScratch<F> v2rho2;
+  detail::HostScratch<F> v2rhogamma;
+  detail::HostScratch<F> v2gamma2;
+
+  detail::HostScratch<F> zmat;
+  detail::HostScratch<F> gmat;
+  detail::HostScratch<F> nbe_scr;
+  detail::HostScratch<F> den_scr;
+  detail::HostScratch<F> basis_eval;
+
+  detail::HostScratch<F>       weights_scr;
+  detail::HostScratch<int32_t> point_scr;
+
+  /// No arena, every buffer is allocated on first use
   inline XCHostData() {}
 
+  /** Carve all scratch buffers out of a single aligned arena
+   *
+   *  Must be constructed on the thread which will use it, such that
+   *  the arena is first touched (and placed) by its owning thread.
+   *  Buffers requested beyond the sizes below fall back to their own
+   *  allocation.
+   *
+   *  @param[in] max         Load balancer maxima
+   *  @param[in] nbasis_comp Number of (npts,nbe) collocation components
+   *                         (1 = B, 4 = B + grad B, 10 = + hessian)
+   *  @param[in] nzmat       Number of (npts,nbe) matrices in zmat
+   *  @param[in] nnbe_scr    Number of (nbe,nbe) matrices in nbe_scr
+   */
+  XCHostData( const XCHostDataMaxima& max, size_t nbasis_comp,
+              size_t nzmat = 1, size_t nnbe_scr = 2 ) {
+
+    const size_t npts = max.npts;
+    const size_t nbe  = max.nbe;
+
+    // Pass 0 computes the (aligned) offsets, pass 1 binds the buffers
+    size_t offset = 0;
+    char*  base   = nullptr;
+    auto carve = [&]( auto& buffer, size_t n ) {
+      using value_type = std::decay_t<decltype(buffer[0])>;
+      if( base )
+        buffer.bind( reinterpret_cast<value_type*>(base + offset), n );
+      offset += detail::align_host_scratch( n * sizeof(value_type) );
+    };
+
+    for( int pass = 0; pass < 2; ++pass ) {
+
+      if( pass ) {
+        arena_ = detail::aligned_host_alloc( offset );
+        base   = static_cast<char*>( arena_.get() );
+        if( base ) std::memset( base, 0, offset ); // First touch
+        offset = 0;
+      }
+
+      carve( basis_eval,  nbasis_comp * max.npts_x_nbe );
+      carve( zmat,        nzmat * max.npts_x_nbe       );
+      carve( nbe_scr,     nnbe_scr * nbe * nbe         );
+      carve( den_scr,     4 * npts                     );
+      carve( eps,         npts                         );
+      carve( vrho,        2 * npts                     );
+      carve( gamma,       3 * npts                     );
+      carve( vgamma,      3 * npts                     );
+      carve( weights_scr, npts                         );
+      carve( point_scr,   npts                         );
+
+    }
+
+  }
+
+private:
+
+  detail::aligned_host_ptr arena_; ///< Backing storage for the carved buffers
+
 };
 
 }
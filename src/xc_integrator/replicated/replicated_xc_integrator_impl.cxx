@@ -6,6 +6,7 @@
  * See LICENSE.txt for details
  */
 #include <gauxc/xc_integrator/replicated/replicated_xc_integrator_impl.hpp>
+#include <gauxc/exceptions.hpp>
 
 namespace GauXC  {
 namespace detail {
@@ -36,18 +37,31 @@ template <typename ValueType>
 void ReplicatedXCIntegratorImpl<ValueType>::
   eval_exc_vxc( int64_t m, int64_t n, const value_type* P,
                 int64_t ldp, value_type* VXC, int64_t ldvxc,
-                value_type* EXC ) {
+                value_type* EXC, const IntegratorSettingsXC& settings ) {
 
-    eval_exc_vxc_(m,n,P,ldp,VXC,ldvxc,EXC);
+    eval_exc_vxc_(m,n,P,ldp,VXC,ldvxc,EXC,settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc( int64_t m, int64_t n, const value_type* Pa,
+                int64_t ldpa, const value_type* Pb, int64_t ldpb,
+                value_type* VXCa, int64_t ldvxca, value_type* VXCb,
+                int64_t ldvxcb, value_type* EXC, 
+                const IntegratorSettingsXC& settings ) {
+
+    eval_exc_vxc_(m,n,Pa,ldpa,Pb,ldpb,VXCa,ldvxca,VXCb,ldvxcb,EXC,settings);
 
 }
 
 template <typename ValueType>
 void ReplicatedXCIntegratorImpl<ValueType>::
   eval_exc_grad( int64_t m, int64_t n, const value_type* P,
-                int64_t ldp, value_type* EXC_GRAD ) {
+                int64_t ldp, value_type* EXC_GRAD, 
+                const IntegratorSettingsXC& settings ) {
 
-    eval_exc_grad_(m,n,P,ldp,EXC_GRAD);
+    eval_exc_grad_(m,n,P,ldp,EXC_GRAD,settings);
 
 }
 
@@ -61,6 +75,72 @@ void ReplicatedXCIntegratorImpl<ValueType>::
 
 }
 
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  integrate_den_batched_( int64_t ndm, int64_t m, int64_t n, 
+                          const value_type* const* P, int64_t ldp, 
+                          value_type* N_EL ) {
+
+    for( int64_t k = 0; k < ndm; ++k )
+      integrate_den_(m,n,P[k],ldp,N_EL+k);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc_batched_( int64_t ndm, int64_t m, int64_t n, 
+                         const value_type* const* P, int64_t ldp, 
+                         value_type* const* VXC, int64_t ldvxc,
+                         value_type* EXC, const IntegratorSettingsXC& settings ) {
+
+    for( int64_t k = 0; k < ndm; ++k )
+      eval_exc_vxc_(m,n,P[k],ldp,VXC[k],ldvxc,EXC+k,settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  integrate_den_batched( int64_t ndm, int64_t m, int64_t n, 
+                         const value_type* const* P, int64_t ldp, 
+                         value_type* N_EL ) {
+
+    integrate_den_batched_(ndm,m,n,P,ldp,N_EL);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc_batched( int64_t ndm, int64_t m, int64_t n, 
+                        const value_type* const* P, int64_t ldp, 
+                        value_type* const* VXC, int64_t ldvxc,
+                        value_type* EXC, const IntegratorSettingsXC& settings ) {
+
+    eval_exc_vxc_batched_(ndm,m,n,P,ldp,VXC,ldvxc,EXC,settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_fxc_contraction_( int64_t, int64_t, int64_t, const value_type*, int64_t,
+                         const value_type* const*, int64_t, value_type* const*,
+                         int64_t, const IntegratorSettingsXC& ) {
+
+    GAUXC_GENERIC_EXCEPTION("FXC Contraction NYI for this Integrator");
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_fxc_contraction( int64_t ndm, int64_t m, int64_t n, 
+                        const value_type* P0, int64_t ldp0,
+                        const value_type* const* dP, int64_t lddp,
+                        value_type* const* FXC, int64_t ldfxc,
+                        const IntegratorSettingsXC& settings ) {
+
+    eval_fxc_contraction_(ndm,m,n,P0,ldp0,dP,lddp,FXC,ldfxc,settings);
+
+}
+
 template class ReplicatedXCIntegratorImpl<double>;
 
 }
@@ -53,6 +53,10 @@ TEST_CASE( "Water / cc-pVDZ", "[collocation]" ) {
   SECTION( "Host Eval Hessian" ) {
     test_host_collocation_deriv2( basis, ref_data );
   }
+
+  SECTION( "Host Native Eval" ) {
+    test_host_native_collocation( basis, ref_data );
+  }
 #endif
 
 #ifdef GAUXC_ENABLE_CUDA
@@ -92,3 +96,9 @@ TEST_CASE( "Water / cc-pVDZ", "[collocation]" ) {
 #endif
 
 }
+
+#ifdef GAUXC_ENABLE_HOST
+TEST_CASE( "High Angular Momentum", "[collocation]" ) {
+  test_host_native_collocation_high_l();
+}
+#endif
@@ -8,6 +8,8 @@
 #ifdef GAUXC_ENABLE_HOST
 #include "collocation_common.hpp"
 #include "host/reference/collocation.hpp"
+#include <gauxc/util/real_solid_harmonics.hpp>
+#include <numeric>
 
 void generate_collocation_data( const Molecule& mol, const BasisSet<double>& basis,
                                 std::ofstream& out_file, size_t ntask_save = 10 ) {
@@ -214,4 +216,287 @@ void test_host_collocation_deriv2( const BasisSet<double>& basis, std::ifstream&
   }
 
 }
+
+void test_host_native_collocation( const BasisSet<double>& basis, std::ifstream& in_file) {
+
+
+
+  std::vector<ref_collocation_data> ref_data;
+
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  for( auto& d : ref_data ) {
+
+    const auto npts = d.pts.size();
+    const auto nbf  = d.eval.size() / npts;
+
+    const auto& mask = d.mask;
+    const auto& pts  = d.pts;
+
+    // Points beyond a shell's cutoff radius must be exact zeros
+    std::vector<bool> screened( nbf * npts, false );
+    for( auto ipt = 0ul; ipt < npts; ++ipt ) {
+      size_t ibf = 0;
+      for( auto ish : mask ) {
+        const auto& sh = basis.at(ish);
+        const auto* O  = sh.O_data();
+        const auto dx = pts[ipt][0] - O[0];
+        const auto dy = pts[ipt][1] - O[1];
+        const auto dz = pts[ipt][2] - O[2];
+        const bool out = 
+          std::sqrt(dx*dx + dy*dy + dz*dz) > sh.cutoff_radius();
+        for( auto i = 0; i < sh.size(); ++i, ++ibf ) 
+          screened[ipt*nbf + ibf] = out;
+      }
+    }
+
+    auto check = [&]( const auto& eval, const auto& ref ) {
+      for( auto i = 0; i < npts * nbf; ++i )
+        if( screened[i] ) CHECK( eval[i] == 0. );
+        else              CHECK( eval[i] == Approx( ref[i] ) );
+    };
+
+    std::vector<double> eval   ( nbf * npts ),
+                        deval_x( nbf * npts ),
+                        deval_y( nbf * npts ),
+                        deval_z( nbf * npts ),
+                        d2eval_xx( nbf * npts ),
+                        d2eval_xy( nbf * npts ),
+                        d2eval_xz( nbf * npts ),
+                        d2eval_yy( nbf * npts ),
+                        d2eval_yz( nbf * npts ),
+                        d2eval_zz( nbf * npts );
+
+    // Value only
+    native_collocation( npts, mask.size(), nbf,
+                        pts.data()->data(), basis,
+                        mask.data(),
+                        eval.data() );
+
+    check( eval, d.eval );
+
+    // Gradient
+    native_collocation_gradient( npts, mask.size(), nbf,
+                                 pts.data()->data(), basis,
+                                 mask.data(),
+                                 eval.data(), deval_x.data(),
+                                 deval_y.data(), deval_z.data() );
+
+    check( eval,    d.eval    );
+    check( deval_x, d.deval_x );
+    check( deval_y, d.deval_y );
+    check( deval_z, d.deval_z );
+
+    // Hessian
+    native_collocation_hessian( npts, mask.size(), nbf,
+      pts.data()->data(), basis, mask.data(), eval.data(), 
+      deval_x.data(), deval_y.data(), deval_z.data(),
+      d2eval_xx.data(), d2eval_xy.data(), d2eval_xz.data(),
+      d2eval_yy.data(), d2eval_yz.data(), d2eval_zz.data() );
+
+    check( eval,      d.eval      );
+    check( deval_x,   d.deval_x   );
+    check( deval_y,   d.deval_y   );
+    check( deval_z,   d.deval_z   );
+    check( d2eval_xx, d.d2eval_xx );
+    check( d2eval_xy, d.d2eval_xy );
+    check( d2eval_xz, d.d2eval_xz );
+    check( d2eval_yy, d.d2eval_yy );
+    check( d2eval_yz, d.d2eval_yz );
+    check( d2eval_zz, d.d2eval_zz );
+  }
+
+}
+
+
+// x^i e^{-a x^2} and its first two derivatives, without the exponential
+inline std::array<double,3> ref_gau_1d( int i, double a, double x ) {
+  auto p = [&]( int k ) { return k < 0 ? 0. : std::pow( x, k ); };
+  return { p(i), i*p(i-1) - 2*a*p(i+1), 
+           i*(i-1)*p(i-2) - 2*a*(2*i+1)*p(i) + 4*a*a*p(i+2) };
+}
+
+// Reference value, gradient and Hessian of every function of a shell at
+// a point, evaluated term by term from the Cartesian monomials (CCA order)
+// and the real solid harmonic coefficients for pure shells.
+// eval[c][ibf] for c = (v, x, y, z, xx, xy, xz, yy, yz, zz)
+void ref_shell_collocation( const Shell<double>& sh, 
+  const std::array<double,3>& pt, std::array<std::vector<double>,10>& eval ) {
+
+  const int l     = sh.l();
+  const int ncart = (l+1)*(l+2)/2;
+  const auto* O   = sh.O_data();
+  const double x = pt[0] - O[0], y = pt[1] - O[1], z = pt[2] - O[2];
+
+  std::array<std::vector<double>,10> cart;
+  for( auto& c : cart ) c.assign( ncart, 0. );
+
+  for( int32_t ip = 0; ip < sh.nprim(); ++ip ) {
+    const double a = sh.alpha_data()[ip];
+    const double e = sh.coeff_data()[ip] * std::exp( -a*(x*x + y*y + z*z) );
+    for( int ix = l, icart = 0; ix >= 0; --ix )
+    for( int iy = l-ix;         iy >= 0; --iy, ++icart ) {
+      const auto gx = ref_gau_1d( ix,       a, x );
+      const auto gy = ref_gau_1d( iy,       a, y );
+      const auto gz = ref_gau_1d( l-ix-iy,  a, z );
+      cart[0][icart] += e * gx[0] * gy[0] * gz[0];
+      cart[1][icart] += e * gx[1] * gy[0] * gz[0];
+      cart[2][icart] += e * gx[0] * gy[1] * gz[0];
+      cart[3][icart] += e * gx[0] * gy[0] * gz[1];
+      cart[4][icart] += e * gx[2] * gy[0] * gz[0];
+      cart[5][icart] += e * gx[1] * gy[1] * gz[0];
+      cart[6][icart] += e * gx[1] * gy[0] * gz[1];
+      cart[7][icart] += e * gx[0] * gy[2] * gz[0];
+      cart[8][icart] += e * gx[0] * gy[1] * gz[1];
+      cart[9][icart] += e * gx[0] * gy[0] * gz[2];
+    }
+  }
+
+  if( not sh.pure() ) { eval = cart; return; }
+
+  for( auto& c : eval ) c.assign( 2*l+1, 0. );
+  for( int m = -l, isph = 0; m <= l; ++m, ++isph )
+  for( int ix = l, icart = 0; ix >= 0; --ix )
+  for( int iy = l-ix;         iy >= 0; --iy, ++icart ) {
+    const double c = util::real_solid_harmonic_coeff( l, m, ix, iy, l-ix-iy );
+    for( int k = 0; k < 10; ++k ) eval[k][isph] += c * cart[k][icart];
+  }
+
+}
+
+// Native collocation of pure and Cartesian shells up to l = 8 (templated
+// kernels for l <= 6, runtime l beyond) on two centers. Shells of a center
+// share their exponents, so every exponent group spans several l
+void test_host_native_collocation_high_l() {
+
+  using prim_array = Shell<double>::prim_array;
+  const std::array<double,3> O1 = {  0.1, -0.2,  0.3 }; 
+  const std::array<double,3> O2 = { -0.8,  0.5, -0.4 };
+
+  BasisSet<double> basis;
+  for( auto pure : { true, false } )
+  for( int l = 0; l <= 8; ++l )
+    basis.emplace_back( PrimSize(2), AngularMomentum(l), SphericalType(pure),
+      prim_array{ 0.9, 0.35 }, prim_array{ 0.6, 0.5 }, O1 );
+  for( int l = 3; l <= 8; ++l )
+    basis.emplace_back( PrimSize(3), AngularMomentum(l), SphericalType(l%2),
+      prim_array{ 1.7, 0.45, 0.12 }, prim_array{ 0.3, 0.5, 0.4 }, O2 );
+  for( auto& sh : basis ) sh.set_shell_tolerance( 1e-8 );
+
+  // Not a multiple of the native point block, some points lie beyond the
+  // cutoff radii of the tighter shells
+  std::mt19937 gen( 1234 );
+  std::uniform_real_distribution<double> dist( -7., 7. );
+  std::vector<std::array<double,3>> pts( 45 );
+  for( auto& pt : pts ) pt = { dist(gen), dist(gen), dist(gen) };
+  pts[0] = O1; pts[1] = O2;
+  const size_t npts = pts.size();
+
+  auto check_mask = [&]( const std::vector<int32_t>& mask ) {
+
+    size_t nbe = 0;
+    for( auto ish : mask ) nbe += basis.at(ish).size();
+
+    std::vector<double> eval( 10 * nbe * npts );
+    std::array<double*,10> e;
+    for( int k = 0; k < 10; ++k ) e[k] = eval.data() + k * nbe * npts;
+    native_collocation_hessian( npts, mask.size(), nbe, pts.data()->data(),
+      basis, mask.data(), e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7],
+      e[8], e[9] );
+
+    std::array<std::vector<double>,10> ref;
+    for( size_t ipt = 0; ipt < npts; ++ipt ) {
+      size_t ibf = 0;
+      for( auto ish : mask ) {
+        const auto& sh = basis.at(ish);
+        const auto* O  = sh.O_data();
+        const auto dx = pts[ipt][0] - O[0];
+        const auto dy = pts[ipt][1] - O[1];
+        const auto dz = pts[ipt][2] - O[2];
+        const bool out = 
+          std::sqrt(dx*dx + dy*dy + dz*dz) > sh.cutoff_radius();
+
+        ref_shell_collocation( sh, pts[ipt], ref );
+        for( int i = 0; i < sh.size(); ++i, ++ibf )
+        for( int k = 0; k < 10; ++k ) {
+          const auto val = e[k][ipt*nbe + ibf];
+          if( out ) CHECK( val == 0. );
+          else      CHECK( val == Approx( ref[k][i] ).margin(1e-12) );
+        }
+      }
+    }
+
+    // Same functions through gau2grid (l <= 6 only)
+#ifdef GAUXC_ENABLE_GAU2GRID
+    std::vector<int32_t> gg_mask;
+    for( auto ish : mask ) if( basis.at(ish).l() <= 6 ) gg_mask.emplace_back(ish);
+
+    size_t gg_nbe = 0;
+    for( auto ish : gg_mask ) gg_nbe += basis.at(ish).size();
+
+    std::vector<double> gg_eval( 10 * gg_nbe * npts ), nt_eval( gg_eval.size() );
+    std::array<double*,10> g, n;
+    for( int k = 0; k < 10; ++k ) {
+      g[k] = gg_eval.data() + k * gg_nbe * npts;
+      n[k] = nt_eval.data() + k * gg_nbe * npts;
+    }
+    gau2grid_collocation_hessian( npts, gg_mask.size(), gg_nbe, 
+      pts.data()->data(), basis, gg_mask.data(), g[0], g[1], g[2], g[3], 
+      g[4], g[5], g[6], g[7], g[8], g[9] );
+    native_collocation_hessian( npts, gg_mask.size(), gg_nbe, 
+      pts.data()->data(), basis, gg_mask.data(), n[0], n[1], n[2], n[3], 
+      n[4], n[5], n[6], n[7], n[8], n[9] );
+
+    for( size_t ipt = 0; ipt < npts; ++ipt ) {
+      size_t ibf = 0;
+      for( auto ish : gg_mask ) {
+        const auto& sh = basis.at(ish);
+        const auto* O  = sh.O_data();
+        const auto dx = pts[ipt][0] - O[0];
+        const auto dy = pts[ipt][1] - O[1];
+        const auto dz = pts[ipt][2] - O[2];
+        const bool out = 
+          std::sqrt(dx*dx + dy*dy + dz*dz) > sh.cutoff_radius();
+        for( int i = 0; i < sh.size(); ++i, ++ibf ) 
+        for( int k = 0; k < 10; ++k ) if( not out ) {
+          const auto idx = ipt*gg_nbe + ibf;
+          CHECK( n[k][idx] == Approx( g[k][idx] ).margin(1e-12) );
+        }
+      }
+    }
+#endif
+
+    // Value / gradient only kernels agree with the Hessian kernel
+    std::vector<double> v( nbe * npts ), vx( nbe * npts ), vy( nbe * npts ),
+      vz( nbe * npts );
+    native_collocation( npts, mask.size(), nbe, pts.data()->data(), basis,
+      mask.data(), v.data() );
+    for( size_t i = 0; i < nbe * npts; ++i ) CHECK( v[i] == e[0][i] );
+
+    native_collocation_gradient( npts, mask.size(), nbe, pts.data()->data(),
+      basis, mask.data(), v.data(), vx.data(), vy.data(), vz.data() );
+    for( size_t i = 0; i < nbe * npts; ++i ) {
+      CHECK( v [i] == e[0][i] );
+      CHECK( vx[i] == e[1][i] );
+      CHECK( vy[i] == e[2][i] );
+      CHECK( vz[i] == e[3][i] );
+    }
+
+  };
+
+  // Every shell (exponent groups of 9 and 6 shells per center / exponent 
+  // set) and every other shell (groups split by the mask)
+  std::vector<int32_t> mask( basis.size() );
+  std::iota( mask.begin(), mask.end(), 0 );
+  check_mask( mask );
+
+  std::vector<int32_t> mask_odd;
+  for( size_t i = 1; i < basis.size(); i += 2 ) mask_odd.emplace_back(i);
+  check_mask( mask_odd );
+
+}
+
 #endif
@@ -8,6 +8,12 @@
 #include "ut_common.hpp"
 #include <gauxc/load_balancer.hpp>
 #include <gauxc/molgrid/defaults.hpp>
+#include <gauxc/util/mpi.hpp>
+#include <gauxc/util/geometry.hpp>
+#include <tuple>
+#ifdef GAUXC_ENABLE_HOST
+#include "host/shell_spatial_index.hpp"
+#endif
 
 using namespace GauXC;
 
@@ -65,6 +71,15 @@ void check_lb_data( const std::vector<XCTask>& tasks, size_t pv ) {
     CHECK( t.bfn_screening.shell_list == rt.bfn_screening.shell_list );
     CHECK( t.bfn_screening.nbe == rt.bfn_screening.nbe );
 
+    // Submatrix maps are populated by the load balancer
+    REQUIRE( t.bfn_screening.submat_map.size() );
+    int32_t submat_nbe = 0;
+    for( const auto& cut : t.bfn_screening.submat_map ) {
+      CHECK( cut[2] == submat_nbe );
+      submat_nbe += cut[1];
+    }
+    CHECK( submat_nbe == t.bfn_screening.nbe );
+
     /* 
     // Points / Weights not stored in reference data to 
     // save space
@@ -128,6 +143,15 @@ TEST_CASE( "DefaultLoadBalancer", "[load_balancer]" ) {
       CHECK(!( task.weights.size() % pv ) );
     }
 
+    // Equivalent tasks are merged, the merged tasks are strictly ordered 
+    // on (iParent, shell list)
+    for( size_t i = 1; i < tasks.size(); ++i ) {
+      const auto& a = tasks[i-1];
+      const auto& b = tasks[i];
+      CHECK( std::tie( a.iParent, a.bfn_screening.shell_list ) < 
+             std::tie( b.iParent, b.bfn_screening.shell_list ) );
+    }
+
   }
 
 #ifdef GAUXC_ENABLE_DEVICE
@@ -178,3 +202,194 @@ TEST_CASE( "DefaultLoadBalancer", "[load_balancer]" ) {
 
 
 }
+
+#ifdef GAUXC_ENABLE_HOST
+TEST_CASE( "Shell Spatial Index", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_benzene();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+  for( auto& sh : basis ) sh.set_shell_tolerance( 1e-10 );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  // Every atom displaced
+  std::mt19937 gen( 5 );
+  std::uniform_real_distribution<double> disp( -0.3, 0.3 );
+  Molecule mol_disp = mol;
+  for( auto& atom : mol_disp ) {
+    atom.x += disp(gen); atom.y += disp(gen); atom.z += disp(gen);
+  }
+
+  using point_t = std::array<double,3>;
+  auto brute_force = []( const BasisSet<double>& bs, const point_t& lo, 
+    const point_t& up ) {
+    std::vector<int32_t> shell_list;
+    for( size_t i = 0; i < bs.size(); ++i )
+    if( geometry::cube_sphere_intersect( lo, up, bs[i].O(), 
+      bs[i].cutoff_radius() ) ) shell_list.push_back( i );
+    return shell_list;
+  };
+  auto point_bbox = []( const XCTask& task ) {
+    point_t lo = task.points.front(), up = lo;
+    for( const auto& point : task.points )
+    for( int d = 0; d < 3; ++d ) {
+      lo[d] = std::min( lo[d], point[d] );
+      up[d] = std::max( up[d], point[d] );
+    }
+    return std::pair( lo, up );
+  };
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+
+  SECTION("Box Queries") {
+    // Original and displaced shells (basis of an updated LoadBalancer)
+    auto lb = lb_factory.get_instance( world, mol, mg, basis );
+    lb.update_geometry( mol_disp );
+
+    std::uniform_real_distribution<double> center( -8., 8. ), width( 0., 2. );
+    const std::array<const BasisSet<double>*,2> bases = { &basis, &lb.basis() };
+    for( const auto* bs : bases ) {
+      detail::ShellSpatialIndex index( *bs );
+      REQUIRE( index.nshells() == bs->size() );
+      for( int i = 0; i < 500; ++i ) {
+        point_t lo, up;
+        for( int d = 0; d < 3; ++d ) {
+          const double c = center(gen), w = width(gen);
+          lo[d] = c - w; up[d] = c + w;
+        }
+        CHECK( index.intersecting_shells( lo, up ) == brute_force( *bs, lo, up ) );
+      }
+    }
+  }
+
+  SECTION("Update Before Task Creation") {
+    // Tasks are screened against the displaced shells, as if the 
+    // LoadBalancer had been created at the displaced geometry
+    auto lb = lb_factory.get_instance( world, mol, mg, basis );
+    lb.update_geometry( mol_disp );
+    const auto& tasks = lb.get_tasks();
+
+    BasisSet<double> basis_disp = make_ccpvdz( mol_disp, SphericalType(true) );
+    for( auto& sh : basis_disp ) sh.set_shell_tolerance( 1e-10 );
+    auto lb_ref = lb_factory.get_instance( world, mol_disp, mg, basis_disp );
+    const auto& tasks_ref = lb_ref.get_tasks();
+
+    REQUIRE( tasks.size() == tasks_ref.size() );
+    for( size_t iT = 0; iT < tasks.size(); ++iT ) {
+      CHECK( tasks[iT].iParent == tasks_ref[iT].iParent );
+      CHECK( tasks[iT].npts    == tasks_ref[iT].npts    );
+      CHECK( tasks[iT].bfn_screening.shell_list == 
+             tasks_ref[iT].bfn_screening.shell_list );
+    }
+  }
+
+  SECTION("Update After Task Creation") {
+    // Existing tasks are rescreened over the bounding box of their points
+    auto lb = lb_factory.get_instance( world, mol, mg, basis );
+    lb.get_tasks();
+    lb.update_geometry( mol_disp );
+    for( const auto& task : lb.get_tasks() ) {
+      auto [lo, up] = point_bbox( task );
+      CHECK( task.bfn_screening.shell_list == brute_force( lb.basis(), lo, up ) );
+    }
+  }
+
+}
+#endif
+
+#ifdef GAUXC_ENABLE_MPI
+TEST_CASE( "Rebalance", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(MPI_COMM_WORLD);
+
+  Molecule mol           = make_benzene();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+  auto lb = lb_factory.get_instance( world, mol, mg, basis );
+
+  auto global_sums = [&]() {
+    std::array<double,2> local_sums = {0., 0.}, sums;
+    for( const auto& task : lb.get_tasks() ) {
+      local_sums[0] += task.npts;
+      local_sums[1] += std::accumulate( task.weights.begin(), 
+        task.weights.end(), 0. );
+    }
+    allreduce( local_sums.data(), sums.data(), 2, MPI_SUM, world.comm() );
+    return sums;
+  };
+
+  const auto sums_ref = global_sums();
+  lb.rebalance_exc_vxc();
+  const auto sums = global_sums();
+
+  // Every point is retained
+  CHECK( sums[0] == sums_ref[0] );
+  CHECK( sums[1] == Approx(sums_ref[1]) );
+
+  // Imbalance is reported
+  const auto& timer = lb.get_timings();
+  CHECK( timer.get_counter("LoadBalancer.RebalanceEXC_VXC.ImbalanceBefore") >= 1. );
+  CHECK( timer.get_counter("LoadBalancer.RebalanceEXC_VXC.ImbalanceAfter")  >= 1. );
+
+}
+
+TEST_CASE( "Calibrated Rebalance", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(MPI_COMM_WORLD);
+  const int world_rank = world.comm_rank();
+  const int world_size = world.comm_size();
+
+  Molecule mol           = make_benzene();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+  auto lb = lb_factory.get_instance( world, mol, mg, basis );
+
+  // Synthetic measured costs: the tasks initially assigned to rank 0 are
+  // 1000x as expensive per point. The static estimate is balanced already,
+  // hence the partition only moves if the measured costs are used
+  const size_t ntasks_before = lb.get_tasks().size();
+  double measured_sum_before = 0.;
+  for( auto& task : lb.get_tasks() ) {
+    task.measured_cost.exc_vxc = (world_rank == 0 ? 1e-3 : 1e-6) * task.npts;
+    measured_sum_before += task.measured_cost.exc_vxc;
+  }
+  measured_sum_before = allreduce( measured_sum_before, MPI_SUM, world.comm() );
+
+  lb.rebalance_exc_vxc();
+
+  double local_cost = 0., max_task_cost = 0.;
+  for( const auto& task : lb.get_tasks() ) {
+    local_cost   += 1e9 * task.measured_cost.exc_vxc;
+    max_task_cost = std::max( max_task_cost, 1e9 * task.measured_cost.exc_vxc );
+  }
+  const double total_cost = allreduce( local_cost,    MPI_SUM, world.comm() );
+  const double max_cost   = allreduce( local_cost,    MPI_MAX, world.comm() );
+  const double max_task   = allreduce( max_task_cost, MPI_MAX, world.comm() );
+  const double avg_cost   = total_cost / world_size;
+
+  // Measured costs travel with the tasks
+  CHECK( total_cost == Approx( 1e9 * measured_sum_before ) );
+
+  // Rank loads in terms of the measured costs are balanced up to a task
+  CHECK( max_cost <= avg_cost + max_task );
+  CHECK( lb.get_timings().get_counter(
+    "LoadBalancer.RebalanceEXC_VXC.ImbalanceAfter") == 
+    Approx( max_cost / avg_cost ).epsilon(1e-6) );
+
+  // Rank 0 has shed most of its (expensive) tasks
+  if( world_size > 1 and world_rank == 0 ) 
+    CHECK( lb.get_tasks().size() < ntasks_before );
+
+}
+#endif
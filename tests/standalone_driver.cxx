@@ -393,6 +393,10 @@ int main(int argc, char** argv) {
         #endif
       }
 
+      for( const auto& [name, val] : integrator.get_timings().all_counters() ) 
+        std::cout << "  " << std::setw(40) << name << ": " 
+                  << std::setw(12) << val << std::endl;
+
       std::cout << std::scientific << std::setprecision(14);
 
       std::cout << "XC Int Duration  = " << xc_int_dur << " s" << std::endl;
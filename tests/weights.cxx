@@ -9,9 +9,12 @@
 #include <gauxc/molgrid.hpp>
 #include <gauxc/basisset.hpp>
 #include <gauxc/load_balancer.hpp>
+#include <gauxc/molecular_weights.hpp>
+#include <gauxc/molgrid/defaults.hpp>
 #include <gauxc/util/div_ceil.hpp>
 #include <fstream>
 #include <string>
+#include <limits>
 
 #include "weights_generate.hpp"
 #include "weights_host.hpp"
@@ -52,7 +55,15 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
   SECTION("Becke") {
   std::ifstream ref_data( GAUXC_REF_DATA_PATH "/benzene_weights_becke.bin", 
                           std::ios::binary );
-  test_host_weights( ref_data, XCWeightAlg::Becke );
+  SECTION( "Host Weights" ) {
+    test_host_weights( ref_data, XCWeightAlg::Becke );
+  }
+  SECTION( "Host Native Weights" ) {
+    test_host_native_weights( ref_data, XCWeightAlg::Becke );
+  }
+  SECTION( "Host Weights Gradient" ) {
+    test_host_weights_gradient( ref_data, XCWeightAlg::Becke );
+  }
   }
   SECTION("LKO") {
   std::ifstream ref_data( GAUXC_REF_DATA_PATH "/benzene_weights_lko.bin", 
@@ -71,6 +82,12 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
   SECTION( "Host Weights" ) {
     test_host_weights( ref_data, XCWeightAlg::SSF );
   }
+  SECTION( "Host Native Weights" ) {
+    test_host_native_weights( ref_data, XCWeightAlg::SSF );
+  }
+  SECTION( "Host Weights Gradient" ) {
+    test_host_weights_gradient( ref_data, XCWeightAlg::SSF );
+  }
 #endif
 
 #ifdef GAUXC_ENABLE_DEVICE
@@ -88,3 +105,154 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
 }
 
 
+#ifdef GAUXC_ENABLE_HOST
+TEST_CASE( "Native Partition Weights", "[weights]" ) {
+
+  // Taxol: 110 atoms of 4 elements, sampled tasks of a FineGrid partition
+  Molecule mol = make_taxol();
+
+  SECTION( "Becke" ) {
+    test_host_native_weights( mol, XCWeightAlg::Becke, 37 );
+  }
+  SECTION( "SSF" ) {
+    test_host_native_weights( mol, XCWeightAlg::SSF, 37 );
+  }
+
+}
+
+TEST_CASE( "Incremental Partition Weights", "[weights]" ) {
+
+  host_weights_setup setup;
+  auto lb = setup.load_balancer();
+
+  MolecularWeightsSettings settings;
+  settings.weight_alg  = XCWeightAlg::SSF;
+  settings.incremental = true;
+  auto mw = setup.molecular_weights( settings );
+  mw.modify_weights(lb);
+  CHECK( lb.state().weight_alg == XCWeightAlg::SSF );
+
+  // Displace a single atom
+  Molecule mol_disp = setup.mol;
+  mol_disp[0].x += 0.05;
+  mol_disp[0].y -= 0.02;
+  lb.update_geometry( mol_disp );
+
+  // Reference: full recompute from the unpartitioned weights
+  LoadBalancer lb_full( lb );
+  for( auto& task : lb_full.get_tasks() ) task.weights = task.unpartitioned_weights;
+  lb_full.state().modified_weights_are_stored = false;
+  mw.modify_weights(lb_full);
+
+  mw.update_weights(lb);
+  check_task_weights( lb.get_tasks(), lb_full.get_tasks() );
+
+  // Weights geometry tracks the displaced atom
+  CHECK( lb.state().weights_geometry[0].x == mol_disp[0].x );
+
+  // Stored weights are not updated with a different partitioning scheme
+  settings.weight_alg = XCWeightAlg::Becke;
+  CHECK_THROWS( setup.molecular_weights( settings ).update_weights(lb) );
+
+}
+
+
+TEST_CASE( "Fused Partition Weights", "[weights]" ) {
+
+  host_weights_setup setup;
+
+  // Reference: separate weight partitioning pass
+  auto lb = setup.load_balancer();
+  auto mw = setup.molecular_weights();
+  mw.modify_weights(lb);
+  const auto& ref_tasks = lb.get_tasks();
+
+  LoadBalancerSettings lb_settings;
+  lb_settings.fuse_partition_weights = true;
+  lb_settings.weight_alg = XCWeightAlg::SSF;
+
+  SECTION("No Screening") {
+    lb_settings.weight_screen_tol = -1.;
+    auto fused_lb = setup.load_balancer( lb_settings );
+    const auto& tasks = fused_lb.get_tasks();
+    CHECK( fused_lb.state().modified_weights_are_stored );
+    CHECK( fused_lb.state().weight_alg == lb_settings.weight_alg );
+    CHECK_THROWS( mw.modify_weights(fused_lb) );
+    check_task_weights( tasks, ref_tasks );
+  }
+
+  SECTION("Modify Weights First") {
+    // Tasks are generated (and partitioned) by modify_weights itself, the
+    // fused weights must not be partitioned a second time
+    lb_settings.weight_screen_tol = -1.;
+    auto fused_lb = setup.load_balancer( lb_settings );
+    CHECK_THROWS( mw.modify_weights(fused_lb) );
+    CHECK( fused_lb.state().modified_weights_are_stored );
+    check_task_weights( fused_lb.get_tasks(), ref_tasks );
+  }
+
+  SECTION("Screening") {
+    lb_settings.weight_screen_tol = 1e-14;
+    auto fused_lb = setup.load_balancer( lb_settings );
+    const auto& tasks = fused_lb.get_tasks();
+    CHECK( fused_lb.state().modified_weights_are_stored );
+    CHECK( tasks.size() <= ref_tasks.size() );
+    CHECK( task_weight_sum(tasks) == Approx(task_weight_sum(ref_tasks)) );
+  }
+
+}
+
+
+TEST_CASE( "Task Compaction", "[weights]" ) {
+
+  host_weights_setup setup;
+
+  size_t pv = 1;
+  SECTION("PV = 1") {}
+  SECTION("PV = 32") { pv = 32; }
+
+  auto lb = setup.load_balancer( LoadBalancerSettings(), pv );
+  auto mw = setup.molecular_weights();
+  mw.modify_weights(lb);
+
+  auto npts_total = []( const std::vector<XCTask>& tasks ) {
+    size_t npts = 0;
+    for( const auto& task : tasks ) npts += task.points.size();
+    return npts;
+  };
+
+  const auto ref_sum  = task_weight_sum( lb.get_tasks() );
+  const auto ref_npts = npts_total( lb.get_tasks() );
+
+  const auto nremoved = lb.compact_tasks();
+  const auto& tasks = lb.get_tasks();
+  CHECK( nremoved > 0 );
+  CHECK( npts_total(tasks) == ref_npts - nremoved );
+  CHECK( task_weight_sum(tasks) == Approx(ref_sum) );
+
+  for( const auto& task : tasks ) {
+    REQUIRE( task.points.size() );
+    CHECK( task.npts == task.points.size() );
+    CHECK( task.weights.size() == task.points.size() );
+    CHECK(!( task.points.size() % pv ) );
+    size_t nsignificant = std::count_if( task.weights.begin(), 
+      task.weights.end(), []( double w ){ return std::abs(w) > 1e-15; } );
+    CHECK( task.points.size() - nsignificant < pv );
+  }
+
+  // Compaction is idempotent
+  CHECK( lb.compact_tasks() == 0 );
+
+  // Removing every task leaves no tasks, they are not regenerated with
+  // unpartitioned weights
+  CHECK( lb.compact_tasks( std::numeric_limits<double>::max() ) == 
+         npts_total(tasks) );
+  CHECK( lb.get_tasks().empty() );
+  CHECK( lb.state().modified_weights_are_stored );
+
+  // Compaction requires partitioned weights
+  auto lb_unm = setup.load_balancer( LoadBalancerSettings(), pv );
+  CHECK_THROWS( lb_unm.compact_tasks() );
+
+}
+#endif
@@ -7,6 +7,9 @@
  */
 #pragma once
 #include "weights_generate.hpp"
+#include <gauxc/molecular_weights.hpp>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <string>
 
@@ -53,5 +56,226 @@ void test_host_weights( std::ifstream& in_file, XCWeightAlg weight_alg ) {
     }
   }
 
+}
+
+void test_host_native_weights( std::ifstream& in_file, XCWeightAlg weight_alg ) {
+
+  ref_weights_data ref_data;
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  auto tasks_native = ref_data.tasks_unm;
+  switch(weight_alg) {
+    case XCWeightAlg::Becke:
+      reference_becke_weights_host( 
+        ref_data.mol, *ref_data.meta, ref_data.tasks_unm.begin(), 
+        ref_data.tasks_unm.end() );
+      native_becke_weights_host( 
+        ref_data.mol, *ref_data.meta, tasks_native.begin(), 
+        tasks_native.end() );
+      break;
+    case XCWeightAlg::SSF:
+      reference_ssf_weights_host( 
+        ref_data.mol, *ref_data.meta, ref_data.tasks_unm.begin(), 
+        ref_data.tasks_unm.end() );
+      native_ssf_weights_host( 
+        ref_data.mol, *ref_data.meta, tasks_native.begin(), 
+        tasks_native.end() );
+      break;
+    default:
+      GAUXC_GENERIC_EXCEPTION("Native Weights Not Implemented");
+  }
+
+
+  size_t ntasks = ref_data.tasks_unm.size();
+  for( size_t itask = 0; itask < ntasks; ++itask ) {
+    auto& task     = tasks_native.at(itask);
+    auto& ref_task = ref_data.tasks_unm.at(itask);
+
+    size_t npts = task.weights.size();
+    for( size_t i = 0; i < npts; ++i ) {
+      CHECK( task.weights.at(i) ==
+             Approx(ref_task.weights.at(i)).epsilon(1e-12) );
+      CHECK( task.weights.at(i) ==
+             Approx(ref_data.tasks_mod.at(itask).weights.at(i)) );
+    }
+  }
+
+}
+
+// Native vs reference weights on a larger, heterogeneous molecule, every
+// stride-th task of a FineGrid partition
+void test_host_native_weights( const Molecule& mol, XCWeightAlg weight_alg,
+  size_t stride ) {
+
+  auto rt = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+  BasisSet<double> basis = make_631Gd( mol, SphericalType(true) );
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory(ExecutionSpace::Host, "Default");
+  auto lb = lb_factory.get_instance(rt, mol, mg, basis);
+  const auto& lb_tasks = lb.get_tasks();
+
+  std::vector<XCTask> tasks;
+  for( size_t itask = 0; itask < lb_tasks.size(); itask += stride )
+    tasks.push_back( lb_tasks[itask] );
+  auto tasks_native = tasks;
+
+  const auto& meta = lb.molmeta();
+  switch(weight_alg) {
+    case XCWeightAlg::Becke:
+      reference_becke_weights_host( mol, meta, tasks.begin(), tasks.end() );
+      native_becke_weights_host( mol, meta, tasks_native.begin(), 
+        tasks_native.end() );
+      break;
+    case XCWeightAlg::SSF:
+      reference_ssf_weights_host( mol, meta, tasks.begin(), tasks.end() );
+      native_ssf_weights_host( mol, meta, tasks_native.begin(), 
+        tasks_native.end() );
+      break;
+    default:
+      GAUXC_GENERIC_EXCEPTION("Native Weights Not Implemented");
+  }
+
+  for( size_t itask = 0; itask < tasks.size(); ++itask ) {
+    const auto& w     = tasks_native[itask].weights;
+    const auto& w_ref = tasks[itask].weights;
+    REQUIRE( w.size() == w_ref.size() );
+    for( size_t i = 0; i < w.size(); ++i )
+      CHECK( w[i] == Approx( w_ref[i] ).epsilon(1e-12) );
+  }
+
+}
+
+void test_host_weights_gradient( std::ifstream& in_file, XCWeightAlg weight_alg ) {
+
+  ref_weights_data ref_data;
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  const auto& mol = ref_data.mol;
+  const size_t natoms = mol.natoms();
+
+  // Subset of the tasks, integrand is fixed on each point
+  std::vector<XCTask> tasks;
+  for( size_t itask = 0; itask < ref_data.tasks_unm.size(); itask += 20 )
+    tasks.push_back( ref_data.tasks_unm[itask] );
+  auto integrand = []( size_t i ) { return 1. + 0.5 * std::sin( double(i) ); };
+
+  // sum_i f_i w_i with coordinate d of atom iA displaced by h, grid 
+  // points move with their parent atom
+  auto integrate = [&]( size_t iA, int d, double h, double* grad ) {
+    Molecule mol_h = mol;
+    auto& atom = mol_h[iA];
+    (d == 0 ? atom.x : (d == 1 ? atom.y : atom.z)) += h;
+    MolMeta meta_h( mol_h );
+
+    auto tasks_h = tasks;
+    for( auto& task : tasks_h ) {
+      task.dist_nearest = meta_h.dist_nearest()[task.iParent];
+      if( task.iParent == (int32_t)iA ) 
+        for( auto& point : task.points ) point[d] += h;
+    }
+
+    if( weight_alg == XCWeightAlg::Becke )
+      reference_becke_weights_host( mol_h, meta_h, tasks_h.begin(), 
+        tasks_h.end() );
+    else
+      reference_ssf_weights_host( mol_h, meta_h, tasks_h.begin(), 
+        tasks_h.end() );
+
+    double val = 0.;
+    std::vector<double> f;
+    for( const auto& task : tasks_h ) {
+      const size_t npts = task.points.size();
+      for( size_t i = 0; i < npts; ++i ) {
+        f.push_back( integrand(i) );
+        val += f.back() * task.weights[i];
+      }
+    }
+    if( grad ) reference_weights_gradient_host( weight_alg, mol_h, meta_h,
+      tasks_h.begin(), tasks_h.end(), f.data(), grad );
+    return val;
+  };
+
+  std::vector<double> grad( 3*natoms, 0. );
+  integrate( 0, 0, 0., grad.data() );
+
+  const double h = 1e-5;
+  for( size_t iA = 0; iA < natoms; ++iA )
+  for( int d = 0; d < 3; ++d ) {
+    const double fd = ( integrate( iA, d, h, nullptr ) - 
+                        integrate( iA, d, -h, nullptr ) ) / (2*h);
+    CHECK( grad[3*iA + d] == Approx(fd).margin(1e-6) );
+  }
+
+}
+
+// Benzene / 6-31G* on a FineGrid, shared by the load balancer level 
+// (incremental, fused, compaction) weight tests
+struct host_weights_setup {
+
+  RuntimeEnvironment rt;
+  Molecule           mol;
+  BasisSet<double>   basis;
+  MolGrid            mg;
+
+  host_weights_setup() :
+    rt( GAUXC_MPI_CODE(MPI_COMM_WORLD) ),
+    mol( make_benzene() ),
+    basis( make_631Gd( mol, SphericalType(true) ) ),
+    mg( MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+      BatchSize(512), RadialQuad::MuraKnowles, 
+      AtomicGridSizeDefault::FineGrid) ) {
+    for( auto& sh : basis ) sh.set_shell_tolerance( 1e-6 );
+  }
+
+  LoadBalancer load_balancer( 
+    const LoadBalancerSettings& settings = LoadBalancerSettings(),
+    size_t pad_val = 1 ) const {
+    LoadBalancerFactory lb_factory(ExecutionSpace::Host, "Default", settings);
+    return lb_factory.get_instance(rt, mol, mg, basis, pad_val);
+  }
+
+  MolecularWeights molecular_weights(
+    const MolecularWeightsSettings& settings = MolecularWeightsSettings() ) const {
+    MolecularWeightsFactory mw_factory( ExecutionSpace::Host, "Default", 
+      settings );
+    return mw_factory.get_instance();
+  }
+
+};
+
+double task_weight_sum( const std::vector<XCTask>& tasks ) {
+  double sum = 0.;
+  for( const auto& task : tasks )
+  for( auto w : task.weights ) sum += w;
+  return sum;
+}
+
+// Compare the weights of two task sets which hold the same tasks in
+// (possibly) different orders
+void check_task_weights( std::vector<XCTask> tasks, 
+  std::vector<XCTask> ref_tasks ) {
+
+  auto task_order = []( const XCTask& a, const XCTask& b ) {
+    if( a.iParent != b.iParent ) return a.iParent < b.iParent;
+    return a.bfn_screening.shell_list < b.bfn_screening.shell_list;
+  };
+  std::sort( tasks.begin(), tasks.end(), task_order );
+  std::sort( ref_tasks.begin(), ref_tasks.end(), task_order );
+
+  REQUIRE( tasks.size() == ref_tasks.size() );
+  for( size_t iT = 0; iT < tasks.size(); ++iT ) {
+    REQUIRE( tasks[iT].weights.size() == ref_tasks[iT].weights.size() );
+    for( size_t i = 0; i < tasks[iT].weights.size(); ++i )
+      CHECK( tasks[iT].weights[i] == Approx(ref_tasks[iT].weights[i]) );
+  }
+
 }
 #endif
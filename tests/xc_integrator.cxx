@@ -83,7 +83,7 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
   auto lb = lb_factory.get_instance(rt, mol, mg, basis, quad_pad_value);
 
   // Construct Weights Module
-  MolecularWeightsFactory mw_factory( ex, "Default", MolecularWeightsSettings{} );
+  MolecularWeightsFactory mw_factory( ex, lwd_kernel, MolecularWeightsSettings{} );
   auto mw = mw_factory.get_instance();
 
   // Apply partition weights
@@ -118,7 +118,286 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto [ EXC1, VXC1 ] = integrator.eval_exc_vxc( P );
     CHECK( EXC1 == Approx( EXC_ref ) );
     auto VXC1_diff_nrm = ( VXC1 - VXC_ref ).norm();
-    CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 ); 
+    CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 );
+  }
+
+  // Check that the host integrator measures the cost of every task
+  if( ex == ExecutionSpace::Host ) {
+    const auto& tasks = integrator.load_balancer().get_tasks();
+    CHECK( std::all_of( tasks.begin(), tasks.end(),
+      []( const auto& t ){ return t.measured_cost.exc_vxc > 0.; } ) );
+  }
+
+  // Check that the host VXC accumulation schemes agree
+  if( ex == ExecutionSpace::Host ) {
+    for( auto scheme : { VXCAccumulation::Critical,
+                         VXCAccumulation::ThreadPrivate,
+                         VXCAccumulation::TileLocked } ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.vxc_accumulation   = scheme;
+      ks_settings.vxc_lock_tile_size = 7; // Tiles straddle submatrix blocks
+      auto [ EXC2, VXC2 ] = integrator.eval_exc_vxc( P, ks_settings );
+      CHECK( EXC2 == Approx( EXC_ref ) );
+      auto VXC2_diff_nrm = ( VXC2 - VXC_ref ).norm();
+      CHECK( VXC2_diff_nrm / basis.nbf() < 1e-10 );
+    }
+
+    // Density / weight point screening
+    IntegratorSettingsKS ks_settings;
+    ks_settings.screen_points = true;
+    auto [ EXC3, VXC3 ] = integrator.eval_exc_vxc( P, ks_settings );
+    CHECK( EXC3 == Approx( EXC_ref ) );
+    auto VXC3_diff_nrm = ( VXC3 - VXC_ref ).norm();
+    CHECK( VXC3_diff_nrm / basis.nbf() < 1e-10 );
+
+    const auto& counters = integrator.get_timings().all_counters();
+    REQUIRE( counters.count("XCIntegrator.ScreenedPoints") );
+    CHECK( counters.at("XCIntegrator.ScreenedPoints") <=
+           counters.at("XCIntegrator.TotalPoints") );
+
+    // A looser density tolerance must actually drop points while staying
+    // within tolerance of the unscreened result
+    ks_settings.den_screening_tol = 1e-10;
+    auto [ EXC4, VXC4 ] = integrator.eval_exc_vxc( P, ks_settings );
+    CHECK( integrator.get_timings().get_counter("XCIntegrator.ScreenedPoints") > 0. );
+    CHECK( EXC4 == Approx( EXC ).epsilon(1e-6) );
+    CHECK( ( VXC4 - VXC ).norm() / basis.nbf() < 1e-6 );
+
+    // The batched and FXC paths do not screen, they must reject the setting
+    CHECK_THROWS( integrator.eval_exc_vxc_batched( { P }, ks_settings ) );
+    CHECK_THROWS( integrator.eval_fxc_contraction( P, { P }, ks_settings ) );
+  }
+
+  // Check the persistent collocation cache
+  if( ex == ExecutionSpace::Host ) {
+    for( size_t budget : { size_t(1ul << 30), size_t(1ul << 16) } ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.collocation_cache_bytes = budget;
+      for( int iter = 0; iter < 2; ++iter ) {
+        auto [ EXC2, VXC2 ] = integrator.eval_exc_vxc( P, ks_settings );
+        CHECK( EXC2 == Approx( EXC_ref ) );
+        CHECK( ( VXC2 - VXC_ref ).norm() / basis.nbf() < 1e-10 );
+      }
+      const auto& counters = integrator.get_timings().all_counters();
+      CHECK( counters.at("XCIntegrator.CollocationCache.Bytes") <= budget );
+      if( budget == (1ul << 30) )
+        CHECK( counters.at("XCIntegrator.CollocationCache.HitRate") == Approx(1.0) );
+    }
+
+    IntegratorSettingsKS ks_settings;
+    ks_settings.collocation_cache_bytes = 1ul << 30;
+    ks_settings.collocation_cache_single_precision = true;
+    for( int iter = 0; iter < 2; ++iter ) {
+      auto [ EXC2, VXC2 ] = integrator.eval_exc_vxc( P, ks_settings );
+      CHECK( EXC2 == Approx( EXC_ref ).epsilon(1e-6) );
+      CHECK( ( VXC2 - VXC_ref ).norm() / basis.nbf() < 1e-6 );
+    }
+
+    // EXX assembles the collocation of its merged tasks from the cached
+    // collocations of the load balancer tasks
+    if( has_k and check_k ) {
+      ks_settings.collocation_cache_single_precision = false;
+      integrator.eval_exc_vxc( P, ks_settings );
+      auto K = integrator.eval_exx( P );
+      CHECK( integrator.get_timings().get_counter(
+        "XCIntegrator.CollocationCache.HitRate") == Approx(1.0) );
+      CHECK( (K - K_ref).norm() / basis.nbf() < 1e-7 );
+    }
+
+    // Modifying the tasks invalidates every entry
+    {
+      auto integrator_c = integrator_factory.get_instance( func, lb );
+      IntegratorSettingsKS cache_settings;
+      cache_settings.collocation_cache_bytes = 1ul << 30;
+      auto [ EXC_pre, VXC_pre ] = integrator_c.eval_exc_vxc( P, cache_settings );
+      const auto N_EL_pre = integrator_c.integrate_den( P );
+      CHECK( integrator_c.load_balancer().compact_tasks( 1e-12 ) > 0 );
+
+      auto [ EXC_c, VXC_c ] = integrator_c.eval_exc_vxc( P, cache_settings );
+      CHECK( integrator_c.get_timings().get_counter(
+        "XCIntegrator.CollocationCache.Hits") == 0. );
+
+      // Batched density integration reuses the (rebuilt) cache
+      if( check_integrate_den ) {
+        auto N_EL_batch = integrator_c.integrate_den_batched( { P } );
+        CHECK( integrator_c.get_timings().get_counter(
+          "XCIntegrator.CollocationCache.HitRate") == Approx(1.0) );
+        CHECK( N_EL_batch[0] == Approx( N_EL_pre ).epsilon(1e-10) );
+      }
+
+      auto [ EXC_nc, VXC_nc ] = integrator_c.eval_exc_vxc( P );
+      CHECK( EXC_c == Approx( EXC_nc ) );
+      CHECK( ( VXC_c - VXC_nc ).norm() / basis.nbf() < 1e-10 );
+
+      // Compaction only drops negligible points
+      CHECK( EXC_nc == Approx( EXC_pre ).epsilon(1e-10) );
+      CHECK( ( VXC_nc - VXC_pre ).norm() / basis.nbf() < 1e-10 );
+      CHECK( integrator_c.integrate_den( P ) == 
+             Approx( N_EL_pre ).epsilon(1e-10) );
+    }
+  }
+
+  // Check the mixed precision LWD and switching back to double precision
+  if( ex == ExecutionSpace::Host ) {
+    LocalWorkSettings lwd_settings;
+    lwd_settings.mixed_precision = true;
+    XCIntegratorFactory<matrix_type> mp_factory( ex, "Replicated",
+      integrator_kernel, lwd_kernel, reduction_kernel, lwd_settings );
+    auto integrator_mp = mp_factory.get_instance( func, lb );
+
+    IntegratorSettingsKS ks_settings;
+    ks_settings.mixed_precision_sample_stride = 1;
+    auto [ EXC_mp, VXC_mp ] = integrator_mp.eval_exc_vxc( P, ks_settings );
+    CHECK( EXC_mp == Approx( EXC_ref ).epsilon(1e-5) );
+    CHECK( ( VXC_mp - VXC_ref ).norm() / basis.nbf() < 1e-5 );
+
+    const auto& counters = integrator_mp.get_timings().all_counters();
+    CHECK( counters.at("XCIntegrator.MixedPrecision") == 1. );
+    CHECK( counters.at("XCIntegrator.MixedPrecision.EXCDeviation") <
+           1e-5 * std::abs(EXC_ref) );
+    CHECK( counters.count("XCIntegrator.MixedPrecision.N_ELDeviation") );
+
+    ks_settings.disable_mixed_precision = true;
+    auto [ EXC_dp, VXC_dp ] = integrator_mp.eval_exc_vxc( P, ks_settings );
+    CHECK( EXC_dp == Approx( EXC_ref ) );
+    CHECK( ( VXC_dp - VXC_ref ).norm() / basis.nbf() < 1e-10 );
+    CHECK( integrator_mp.get_timings().get_counter("XCIntegrator.MixedPrecision") == 0. );
+
+    // The LWD precision is restored after the double precision evaluation,
+    // screened tasks reuse the (re-registered) single precision basis
+    ks_settings.disable_mixed_precision = false;
+    ks_settings.screen_points = true;
+    ks_settings.den_screening_tol = 1e-10;
+    auto [ EXC_mps, VXC_mps ] = integrator_mp.eval_exc_vxc( P, ks_settings );
+    CHECK( integrator_mp.get_timings().get_counter("XCIntegrator.MixedPrecision") == 1. );
+    CHECK( EXC_mps == Approx( EXC_ref ).epsilon(1e-5) );
+    CHECK( ( VXC_mps - VXC_ref ).norm() / basis.nbf() < 1e-5 );
+
+    // Batched EXC/VXC honors the mixed precision settings as well
+    ks_settings.screen_points = false;
+    auto EXC_VXC_mpb = integrator_mp.eval_exc_vxc_batched( { P }, ks_settings );
+    CHECK( integrator_mp.get_timings().get_counter("XCIntegrator.MixedPrecision") == 1. );
+    CHECK( std::get<0>(EXC_VXC_mpb[0]) == Approx( EXC_ref ).epsilon(1e-5) );
+    ks_settings.disable_mixed_precision = true;
+    EXC_VXC_mpb = integrator_mp.eval_exc_vxc_batched( { P }, ks_settings );
+    CHECK( integrator_mp.get_timings().get_counter("XCIntegrator.MixedPrecision") == 0. );
+    CHECK( std::get<0>(EXC_VXC_mpb[0]) == Approx( EXC_ref ) );
+
+    // Density integration always runs in double precision
+    if( check_integrate_den )
+      CHECK( integrator_mp.integrate_den( P ) ==
+             Approx( integrator.integrate_den( P ) ).epsilon(1e-12) );
+  }
+
+  // Check batched EXC/VXC against unbatched evaluation. Each density is
+  // distinct so every block of the stacked X matrices is exercised
+  if( ex == ExecutionSpace::Host ) {
+    matrix_type P_half = 0.5 * P;
+    matrix_type P_diag = P;
+    P_diag.diagonal() *= 1.1;
+    auto [ EXC_half, VXC_half ] = integrator.eval_exc_vxc( P_half );
+    auto [ EXC_diag, VXC_diag ] = integrator.eval_exc_vxc( P_diag );
+
+    auto EXC_VXC_batch = integrator.eval_exc_vxc_batched( { P, P_half, P_diag } );
+    REQUIRE( EXC_VXC_batch.size() == 3 );
+    CHECK( std::get<0>(EXC_VXC_batch[0]) == Approx( EXC_ref ) );
+    CHECK( ( std::get<1>(EXC_VXC_batch[0]) - VXC_ref ).norm() / basis.nbf() < 1e-10 );
+    CHECK( std::get<0>(EXC_VXC_batch[1]) == Approx( EXC_half ) );
+    CHECK( ( std::get<1>(EXC_VXC_batch[1]) - VXC_half ).norm() / basis.nbf() < 1e-10 );
+    CHECK( std::get<0>(EXC_VXC_batch[2]) == Approx( EXC_diag ) );
+    CHECK( ( std::get<1>(EXC_VXC_batch[2]) - VXC_diag ).norm() / basis.nbf() < 1e-10 );
+
+    if( check_integrate_den ) {
+      auto N_EL_batch = integrator.integrate_den_batched( { P, P_half, P_diag } );
+      REQUIRE( N_EL_batch.size() == 3 );
+      CHECK( N_EL_batch[0] == Approx( integrator.integrate_den( P      ) ) );
+      CHECK( N_EL_batch[1] == Approx( integrator.integrate_den( P_half ) ) );
+      CHECK( N_EL_batch[2] == Approx( integrator.integrate_den( P_diag ) ) );
+    }
+  }
+
+  // Check the FXC contraction against central differences of VXC
+  if( ex == ExecutionSpace::Host ) {
+    matrix_type dP1 = 0.1 * P;
+    matrix_type dP2 = P.diagonal().asDiagonal();
+
+    auto FXC = integrator.eval_fxc_contraction( P, { dP1, dP2 } );
+    REQUIRE( FXC.size() == 2 );
+
+    // Every trial density in a batch must match its own single contraction
+    for( auto k : {0, 1} ) {
+      auto FXC_k = integrator.eval_fxc_contraction( P, { k ? dP2 : dP1 } );
+      REQUIRE( FXC_k.size() == 1 );
+      CHECK( ( FXC[k] - FXC_k[0] ).norm() / FXC_k[0].norm() < 1e-12 );
+    }
+
+    const double h = 1e-4;
+    for( auto k : {0, 1} ) {
+      const auto& dP = k ? dP2 : dP1;
+      matrix_type P_p = P + h * dP;
+      matrix_type P_m = P - h * dP;
+      auto [ EXC_p, VXC_p ] = integrator.eval_exc_vxc( P_p );
+      auto [ EXC_m, VXC_m ] = integrator.eval_exc_vxc( P_m );
+      matrix_type FXC_fd = ( VXC_p - VXC_m ) / (2*h);
+      CHECK( ( FXC[k] - FXC[k].transpose() ).norm() < 1e-14 );
+      CHECK( ( FXC[k] - FXC_fd ).norm() / FXC_fd.norm() < 1e-5 );
+    }
+  }
+
+  // Check UKS EXC/VXC for the closed shell case (Pa = Pb = P)
+  if( ex == ExecutionSpace::Host ) {
+    functional_type func_pol( ExchCXX::Backend::builtin, func_key,
+      ExchCXX::Spin::Polarized );
+    auto integrator_uks = integrator_factory.get_instance( func_pol, lb );
+    auto [ EXC_uks, VXCa, VXCb ] = integrator_uks.eval_exc_vxc( P, P );
+    CHECK( EXC_uks == Approx( EXC_ref ) );
+    CHECK( ( VXCa - VXC_ref ).norm() / basis.nbf() < 1e-10 );
+    CHECK( ( VXCb - VXC_ref ).norm() / basis.nbf() < 1e-10 );
+
+    // Screened UKS against the unscreened UKS result
+    IntegratorSettingsKS ks_settings;
+    ks_settings.screen_points     = true;
+    ks_settings.den_screening_tol = 1e-10;
+    auto [ EXC_scr, VXCa_scr, VXCb_scr ] =
+      integrator_uks.eval_exc_vxc( P, P, ks_settings );
+    CHECK( integrator_uks.get_timings().get_counter("XCIntegrator.ScreenedPoints") > 0. );
+    CHECK( EXC_scr == Approx( EXC_uks ).epsilon(1e-6) );
+    CHECK( ( VXCa_scr - VXCa ).norm() / basis.nbf() < 1e-6 );
+    CHECK( ( VXCb_scr - VXCb ).norm() / basis.nbf() < 1e-6 );
+  }
+
+  // Check UKS EXC/VXC for an open shell case (Pa != Pb). VXCs is the
+  // derivative of EXC wrt Ps, check against central differences
+  if( ex == ExecutionSpace::Host ) {
+    functional_type func_pol( ExchCXX::Backend::builtin, func_key,
+      ExchCXX::Spin::Polarized );
+    auto integrator_uks = integrator_factory.get_instance( func_pol, lb );
+
+    matrix_type Pa = 0.6 * P;
+    matrix_type Pb = 0.4 * P;
+    Pb.diagonal() *= 0.9;
+    auto [ EXC_uks, VXCa, VXCb ] = integrator_uks.eval_exc_vxc( Pa, Pb );
+    CHECK( ( VXCa - VXCb ).norm() > 1e-6 );
+
+    // Swapping the spin densities swaps the potentials
+    auto [ EXC_swp, VXCa_swp, VXCb_swp ] = integrator_uks.eval_exc_vxc( Pb, Pa );
+    CHECK( EXC_swp == Approx( EXC_uks ) );
+    CHECK( ( VXCa_swp - VXCb ).norm() / basis.nbf() < 1e-10 );
+    CHECK( ( VXCb_swp - VXCa ).norm() / basis.nbf() < 1e-10 );
+
+    const double h = 1e-4;
+    matrix_type dP = P;
+    dP.diagonal() *= 0.5;
+    for( auto spin : {0, 1} ) {
+      matrix_type dPa = spin ? matrix_type::Zero(P.rows(), P.cols()) : dP;
+      matrix_type dPb = spin ? dP : matrix_type::Zero(P.rows(), P.cols());
+      matrix_type Pa_p = Pa + h * dPa, Pa_m = Pa - h * dPa;
+      matrix_type Pb_p = Pb + h * dPb, Pb_m = Pb - h * dPb;
+      auto EXC_p = std::get<0>( integrator_uks.eval_exc_vxc( Pa_p, Pb_p ) );
+      auto EXC_m = std::get<0>( integrator_uks.eval_exc_vxc( Pa_m, Pb_m ) );
+      const auto& VXCs = spin ? VXCb : VXCa;
+      CHECK( VXCs.cwiseProduct(dP).sum() == Approx( (EXC_p - EXC_m) / (2*h) ).epsilon(1e-6) );
+    }
   }
 
 
@@ -130,11 +409,68 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     map_type EXC_GRAD_map( EXC_GRAD.data(), mol.size(), 3 );
     auto EXC_GRAD_diff_nrm = (EXC_GRAD_ref_map - EXC_GRAD_map).norm();
     CHECK( EXC_GRAD_diff_nrm / std::sqrt(3.0*mol.size()) < 1e-10 );
+
+    // With partition weight derivatives the grid moves with the atoms, the
+    // gradient is the derivative of the quadrature itself. Check against
+    // central differences of EXC on grids and bases built at displaced 
+    // geometries (fixed P)
+    if( ex == ExecutionSpace::Host ) {
+      auto grid_size = AtomicGridSizeDefault::FineGrid;
+      BasisSetMap basis_map( basis, mol );
+      auto exc_at = [&]( const Molecule& mol_h, bool grad ) {
+        BasisSet<double> basis_h = basis;
+        for( size_t iSh = 0; iSh < basis_h.size(); ++iSh ) {
+          const auto iA = basis_map.shell_to_center()[iSh];
+          if( iA < 0 ) continue;
+          auto& O = basis_h[iSh].O();
+          O[0] += mol_h[iA].x - mol[iA].x;
+          O[1] += mol_h[iA].y - mol[iA].y;
+          O[2] += mol_h[iA].z - mol[iA].z;
+        }
+        auto mg_h = MolGridFactory::create_default_molgrid(mol_h, 
+          pruning_scheme, BatchSize(512), RadialQuad::MuraKnowles, grid_size);
+        auto lb_h = lb_factory.get_instance(rt, mol_h, mg_h, basis_h, 
+          quad_pad_value);
+        mw.modify_weights(lb_h);
+        auto integrator_h = integrator_factory.get_instance( func, lb_h );
+
+        IntegratorSettingsEXCGrad grad_settings;
+        grad_settings.weight_derivatives = true;
+        if( grad ) return std::make_pair( 0., 
+          integrator_h.eval_exc_grad( P, grad_settings ) );
+        return std::make_pair( std::get<0>(integrator_h.eval_exc_vxc( P )),
+          std::vector<double>{} );
+      };
+
+      auto EXC_GRAD_W = exc_at( mol, true ).second;
+
+      const double h = 1e-4;
+      const size_t iA = mol.size() - 1;
+      for( int d = 0; d < 3; ++d ) {
+        Molecule mol_p = mol, mol_m = mol;
+        (d == 0 ? mol_p[iA].x : (d == 1 ? mol_p[iA].y : mol_p[iA].z)) += h;
+        (d == 0 ? mol_m[iA].x : (d == 1 ? mol_m[iA].y : mol_m[iA].z)) -= h;
+        const double fd = 
+          ( exc_at( mol_p, false ).first - exc_at( mol_m, false ).first ) / (2*h);
+        CHECK( EXC_GRAD_W[3*iA + d] == Approx( fd ).margin(1e-6) );
+      }
+    }
   }
 
   // Check K
   if( has_k and check_k ) {
+    // EXX merges tasks across parents, the load balancer tasks must be kept
+    auto task_signature = [&]() {
+      std::vector< std::pair<int32_t,size_t> > sig;
+      for( const auto& task : integrator.load_balancer().get_tasks() ) 
+        sig.emplace_back( task.iParent, task.points.size() );
+      std::sort( sig.begin(), sig.end() );
+      return sig;
+    };
+    const auto tasks_before = task_signature();
+
     auto K = integrator.eval_exx( P );
+    CHECK( task_signature() == tasks_before );
     CHECK((K - K.transpose()).norm() < std::numeric_limits<double>::epsilon()); // Symmetric
     CHECK( (K - K_ref).norm() / basis.nbf() < 1e-7 );
   }
@@ -154,6 +490,14 @@ void test_integrator(std::string reference_file, ExchCXX::Functional func, Pruni
     test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
       pruning_scheme, 1, true, true, true );
   }
+  SECTION( "Host - Fused LWD" ) {
+    test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
+      pruning_scheme, 1, false, true, false, "Default", "Default", "Fused" );
+  }
+  SECTION( "Host - Native LWD" ) {
+    test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
+      pruning_scheme, 1, true, true, false, "Default", "Default", "Native" );
+  }
 #endif
 
 #ifdef GAUXC_ENABLE_DEVICE